@@ -42,7 +42,7 @@ RSC=rc.exe
 # PROP Intermediate_Dir "Release"
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /c
-# ADD CPP /nologo /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /c
+# ADD CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /c
 # ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
 # ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
 # ADD BASE RSC /l 0x411 /d "NDEBUG"
@@ -68,7 +68,7 @@ LINK32=link.exe
 # PROP Ignore_Export_Lib 0
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /GZ /c
-# ADD CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /GZ /c
+# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /YX /FD /GZ /c
 # ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
 # ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
 # ADD BASE RSC /l 0x411 /d "_DEBUG"
@@ -91,12 +91,160 @@ LINK32=link.exe
 # PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
 # Begin Source File
 
+SOURCE=.\allocwatch.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\arena.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\chunkstream.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ddcache.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\endless.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\ghost.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\hud.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\input.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\main.cpp
 # End Source File
+# Begin Source File
+
+SOURCE=.\profiler.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\render.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\replay.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\rewind.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\rng.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\sim.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\snapshot.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\stagepack.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\text.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\timestep.cpp
+# End Source File
 # End Group
 # Begin Group "Header Files"
 
 # PROP Default_Filter "h;hpp;hxx;hm;inl"
+# Begin Source File
+
+SOURCE=.\allocwatch.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\arena.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\chunkstream.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\ddcache.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\endless.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\ghost.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\hud.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\input.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\profiler.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\render.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\replay.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\rewind.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\rng.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\scalar.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\sim.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\snapshot.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\stagepack.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\text.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\timestep.h
+# End Source File
 # End Group
 # Begin Group "Resource Files"
 
@@ -0,0 +1,90 @@
+//=============================================================================
+//
+//  wWXgWv DX5x q[v̊mۂ̌ (fobOp)
+//
+//=============================================================================
+#include <stdlib.h>
+#include "allocwatch.h"
+
+//-----------------------------------------------------------------------------
+//   (XbhƂɕʁXɎ܂)
+//-----------------------------------------------------------------------------
+#if defined(_WIN32) && defined(_DEBUG)
+
+#include <crtdbg.h>
+#define ALLOCWATCH_ENABLED
+static __declspec(thread) unsigned long s_Count;
+static __declspec(thread) unsigned long s_FrameStart;
+
+// C^Cq[vgтɌĂ΂܂ (ł͐邾ŁAC^C̊֐͌Ăт܂)
+static int __cdecl AllocWatch_Hook(int allocType, void* userData, size_t size, int blockType, long requestNumber, const unsigned char* fileName, int lineNumber)
+{
+    if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC){
+        s_Count++;
+    }
+    return 1;   // mۂ͂̂܂ܑĂ炢܂
+}
+
+#elif defined(JJ_ALLOC_WRAP)
+
+#define ALLOCWATCH_ENABLED
+static __thread unsigned long s_Count;
+static __thread unsigned long s_FrameStart;
+
+// -Wl,--wrap=malloc ŃNƁAmalloc ̌Ăяoׂ͂ __wrap_malloc ɗ܂B
+// { malloc  __real_malloc ƂOŌĂׂ܂
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* p, size_t size);
+
+void* __wrap_malloc(size_t size)                { s_Count++; return __real_malloc(size); }
+void* __wrap_calloc(size_t count, size_t size)  { s_Count++; return __real_calloc(count, size); }
+void* __wrap_realloc(void* p, size_t size)      { s_Count++; return __real_realloc(p, size); }
+}
+
+#else
+
+static unsigned long s_Count;
+static unsigned long s_FrameStart;
+
+#endif
+
+//=============================================================================
+//  AllocWatch_Install֐ - n߂܂ (̃rhŌȂ false Ԃ܂)
+//=============================================================================
+bool AllocWatch_Install()
+{
+#if defined(_WIN32) && defined(_DEBUG)
+    _CrtSetAllocHook(AllocWatch_Hook);
+#endif
+#ifdef ALLOCWATCH_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+//=============================================================================
+//  AllocWatch_BeginFrame֐ - ũt[vƂĐ܂
+//=============================================================================
+void AllocWatch_BeginFrame()
+{
+    s_FrameStart = s_Count;
+}
+
+//=============================================================================
+//  AllocWatch_FrameCount֐ - AllocWatch_BeginFrame ̌Ɋmۂ񐔂Ԃ܂
+//=============================================================================
+unsigned long AllocWatch_FrameCount()
+{
+    return s_Count - s_FrameStart;
+}
+
+//=============================================================================
+//  AllocWatch_TotalCount֐ - NĂÃXbhŊmۂ񐔂Ԃ܂
+//=============================================================================
+unsigned long AllocWatch_TotalCount()
+{
+    return s_Count;
+}
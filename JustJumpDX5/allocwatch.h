@@ -0,0 +1,38 @@
+//=============================================================================
+//
+//  wWXgWv DX5x q[v̊mۂ̌ (fobOp)
+//
+//  malloc / realloc / calloc Ă΂ꂽ񐔂𐔂܂BQ[
+//  (EH[Abv̌) ̃t[ł́A1q[vgȂ͂Ȃ̂ŁA
+//  񐔂 0 łȂ΁AǂŖt[mۂĂ镨ƂƂłB
+//  1t[̊ԂǵAq[vł͂Ȃt[A[i (arena.h) ɒuĂB
+//
+//  肪ł̂́ÃrĥƂł (ȊOł AllocWatch_Install  false Ԃ܂)B
+//    Windows ... fobOrh (_DEBUG)BC^C _CrtSetAllocHook Ő܂
+//    Linux   ... jjheadlessBNƂ -Wl,--wrap=malloc ȂǂŁAĂяo肵܂
+//                  (Makefile QƁBJJ_ALLOC_WRAP `ărhƂ̊֐܂)
+//
+//  ̂́ÃXbhŊmۂ񐔂ł (R[XW̃Xbh͓̕܂)B
+//
+//  g:
+//    AllocWatch_Install();                 // N1
+//    AllocWatch_BeginFrame();              // t[̍ŏ
+//    ...
+//    if (AllocWatch_FrameCount() > 0) { ...̃t[Ńq[vg... }
+//
+//=============================================================================
+#ifndef ALLOCWATCH_H
+#define ALLOCWATCH_H
+
+// Q[܂ (̃LbV⃊vC̒uꂪpӂ܂) ̃t[̖ڈ
+#define ALLOC_WARMUP_FRAMES     120
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+bool          AllocWatch_Install();
+void          AllocWatch_BeginFrame();
+unsigned long AllocWatch_FrameCount();
+unsigned long AllocWatch_TotalCount();
+
+#endif // ALLOCWATCH_H
@@ -0,0 +1,91 @@
+//=============================================================================
+//
+//  wWXgWv DX5x 1t[p̃u (t[A[i)
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+// ARENA_ALIGN 2ׂ̂łȂ΂Ȃ܂ (؂グrbgZōs)
+typedef char Arena_Align_Check[((ARENA_ALIGN & (ARENA_ALIGN - 1)) == 0) ? 1 : -1];
+
+//=============================================================================
+//  Arena_Init֐ - ũmۂ܂ (s falseB̂Ƃ Arena_Alloc  NULL Ԃł)
+//=============================================================================
+bool Arena_Init(FrameArena& arena, unsigned long size)
+{
+    memset(&arena, 0, sizeof(arena));
+    arena.base = (unsigned char*)malloc(size);
+    if (arena.base == NULL){
+        return false;
+    }
+    arena.size = size;
+    return true;
+}
+
+//=============================================================================
+//  Arena_Free֐ - ũԂ܂
+//=============================================================================
+void Arena_Free(FrameArena& arena)
+{
+    free(arena.base);
+    memset(&arena, 0, sizeof(arena));
+}
+
+//=============================================================================
+//  Arena_Reset֐ - ؂oS܂Ƃ߂ĕԂ܂ (t[̍ŏɌĂт܂)
+//=============================================================================
+void Arena_Reset(FrameArena& arena)
+{
+    if (arena.used > arena.peak){
+        arena.peak = arena.used;
+    }
+    arena.used = 0;
+}
+
+//=============================================================================
+//  Arena_Alloc֐ - size oCg؂o܂
+//   (Ȃ NULL Ԃ܂Bq[v瑫Ƃ͂܂)
+//=============================================================================
+void* Arena_Alloc(FrameArena& arena, unsigned long size)
+{
+    unsigned long start = (arena.used + (ARENA_ALIGN - 1)) & ~(unsigned long)(ARENA_ALIGN - 1);
+
+    if (start > arena.size || size > arena.size - start){
+        arena.overflows++;
+        return NULL;
+    }
+    arena.used = start + size;
+    return arena.base + start;
+}
+
+//=============================================================================
+//  Arena_Format֐ - 3܂Ŗߍ񂾕Auɍ܂
+//   (Ȃ΋̕Ԃ̂ŁÂ܂ Render_Text ɓn܂)
+//=============================================================================
+const char* Arena_Format(FrameArena& arena, const char* format, long a, long b, long c)
+{
+    char buffer[ARENA_FORMAT_MAX];
+    char* text;
+    int length;
+
+    // VC6 ɂ snprintf Ȃ̂ŁA\ȑ傫̔zɍĂʂ܂
+#ifdef _MSC_VER
+    length = _snprintf(buffer, sizeof(buffer) - 1, format, a, b, c);
+#else
+    length = snprintf(buffer, sizeof(buffer) - 1, format, a, b, c);
+#endif
+    if (length < 0 || length > (int)sizeof(buffer) - 1){
+        length = (int)sizeof(buffer) - 1;
+    }
+    buffer[length] = '\0';
+
+    text = (char*)Arena_Alloc(arena, (unsigned long)length + 1);
+    if (text == NULL){
+        return "";
+    }
+    memcpy(text, buffer, (size_t)length + 1);
+    return text;
+}
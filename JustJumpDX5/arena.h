@@ -0,0 +1,47 @@
+//=============================================================================
+//
+//  wWXgWv DX5x 1t[p̃u (t[A[i)
+//
+//  NɈx傫ȃmۂĂA1t[̊Ԃg
+//  (`̉EʂɏoȂ) ́AO珇ɐ؂oĎg܂B
+//  Ԃ͂ȂAt[̍ŏ Arena_Reset ŁuS󂢂vƂɂ邾łB
+//  ̂߁At[ malloc / free ԂƂ܂B
+//
+//  ؂óA Arena_Reset ܂łg܂Bt[܂
+//  ƂĂ (HUD ̃̕LbVȂ) ́Aɂ͒uȂłB
+//
+//  g:
+//    FrameArena arena;
+//    Arena_Init(arena, FRAME_ARENA_SIZE);      // N1
+//    Arena_Reset(arena);                       // t[̍ŏ
+//    ProfFrame* frames = (ProfFrame*)Arena_Alloc(arena, sizeof(ProfFrame) * n);
+//    const char* text = Arena_Format(arena, "%ld us", a, 0, 0);
+//    Arena_Free(arena);                        // I1
+//
+//=============================================================================
+#ifndef ARENA_H
+#define ARENA_H
+
+#define FRAME_ARENA_SIZE    (64 * 1024)     // 1t[̒ȗ傫 (oCg)
+#define ARENA_ALIGN         8               // ؂oʒu̔{ɂ낦܂ (double  64rbĝ)
+#define ARENA_FORMAT_MAX    128             // Arena_Format ō镶̍ő̒
+
+struct FrameArena
+{
+    unsigned char* base;        // mۂ̐擪
+    unsigned long  size;        // ̑傫 (oCg)
+    unsigned long  used;        // ̃t[Ő؂o傫
+    unsigned long  peak;        // ܂ł1t[ used ̍ő (FRAME_ARENA_SIZE ߂ڈł)
+    unsigned long  overflows;   // Ȃ NULL Ԃ (0 łȂ FRAME_ARENA_SIZE 𑝂₵Ă)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+bool        Arena_Init(FrameArena& arena, unsigned long size);
+void        Arena_Free(FrameArena& arena);
+void        Arena_Reset(FrameArena& arena);
+void*       Arena_Alloc(FrameArena& arena, unsigned long size);
+const char* Arena_Format(FrameArena& arena, const char* format, long a, long b, long c);
+
+#endif // ARENA_H
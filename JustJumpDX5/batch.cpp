@@ -0,0 +1,441 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Փxp̂܂Ƃ߂Ďsc[ (Linuxp)
+//
+//  vC̃Q[{ACPU ׂ̂ẴRAœɗV΂āA
+//  Xe[WƂ́uǂꂭ炢c邩vuŎʂvWv܂B
+//  stages.txt ̑NAXRAςAŗVԑɂŊm߂܂B
+//
+//  g:
+//    ./jjbatch [-runs ] [-threads ] [-seed ] [-policy auto|random|idle]
+//              [-lookahead sNZ] [-jump-one-in ] [-max-seconds b] [-stages Xe[W.jjs]
+//
+//    -runs         V΂Q[̖{ (1{ = ^CgQ[I[o[Q[NA܂)
+//    -threads      gXbh̐ (ȗƃRA̐)
+//    -seed         1{ڂ̗̎ (n {ڂ seed + n g܂)
+//    -lookahead    auto: ǂ̋܂ŋ߂ÂWv
+//    -jump-one-in  random: 1/N ̊mŃWv
+//    -max-seconds  1{̏ (Q[̕bBIȂݒ̂Ƃ̑ł؂p)
+//
+//  d̕ ([NXeB[O):
+//    Q[̔ԍ͈̔͂AŏɃXbh̐œĔz܂B
+//    ͈̔͂VяIXbh́Aق̃Xbh͈̔͂̌딼
+//     () ܂BQ[̒͂܂܂łAŌ܂
+//    S̃RA܂BWv̓XbhƂɕʁXɍsAŌɑ܂B
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "sim.h"
+#include "stagepack.h"
+#include "policy.h"
+
+//-----------------------------------------------------------------------------
+//  ݒl (}N)
+//-----------------------------------------------------------------------------
+#define BATCH_MAX_THREADS       256
+#define SURVIVAL_BUCKET_MS      1000    // Ȑ̍ (1b)
+#define SURVIVAL_BUCKETS        120     // Ȑb܂Ő邩
+
+// Ȑ̂A\ɏo (b)
+static const int s_SurvivalReport[] = { 5, 10, 20, 30, 60 };
+#define NUM_SURVIVAL_REPORT     ((int)(sizeof(s_SurvivalReport) / sizeof(s_SurvivalReport[0])))
+
+//-----------------------------------------------------------------------------
+//  ݌v} (\)
+//-----------------------------------------------------------------------------
+// Xe[W1̏Wv
+//   u1̖v= Xe[WJnA~XXe[WNA܂ŁB
+//   ~XŏI deaths ɁANAŏI cleared ɁAIԂŐ܂B
+struct StageStats
+{
+    unsigned long reached;                          // ̃Xe[W܂ŗQ[̐
+    unsigned long clears;                           // ̃Xe[WNAQ[̐
+    unsigned long missObstacle;                     // ǂɂԂ
+    unsigned long missPit;                          // Ƃɗ
+    double        scoreSum;                         // ̃Xe[WoƂ (NAQ[I[o[) ̃XRA̍v
+    unsigned long deaths[SURVIVAL_BUCKETS + 1];     // ~XŏI̐ (ĂԂ)
+    unsigned long cleared[SURVIVAL_BUCKETS + 1];    // NAŏI̐ (ĂԂ)
+};
+
+struct BatchStats
+{
+    unsigned long runs;
+    unsigned long gameClears;
+    unsigned long timeouts;                         // -max-seconds őł؂Q[̐
+    double        scoreSum;                         // ŏIXRA̍v
+    double        simSeconds;                       // V΂Q[̎Ԃ̍v
+    StageStats*   stages;                           // Xe[W̐
+};
+
+// 1{̃Xbh̎
+struct Worker
+{
+    pthread_t       thread;
+    pthread_mutex_t lock;           // next  end ܂ (ق̃Xbhɓ܂邽)
+    unsigned long   next;           // ɗVԃQ[̔ԍ
+    unsigned long   end;            // ͈̔͂̏I (̔ԍ͊܂݂܂)
+    int             index;
+    unsigned long   steals;         // ق̃Xbhd
+    BatchStats      stats;
+};
+
+// SXbhʂ̐ݒ
+struct BatchConfig
+{
+    const StageData* stages;
+    int              stageCount;
+    Policy           policy;
+    float            lookAhead;
+    int              jumpOneIn;
+    unsigned long    seed;
+    unsigned long    maxFrames;
+    int              threadCount;
+    Worker*          workers;
+};
+
+static BatchConfig g_Config;
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void  Batch_RunGame(BatchStats& stats, unsigned long seed);
+static bool  Batch_TakeJob(Worker& self, unsigned long& job);
+static bool  Batch_StealJob(Worker& self, unsigned long& job);
+static void* Batch_WorkerMain(void* arg);
+static void  Batch_EndLife(StageStats& stage, unsigned long lifeMs, bool died);
+static void  Batch_Merge(BatchStats& total, const BatchStats& part, int stageCount);
+static void  Batch_Report(const BatchStats& total, double seconds);
+
+//=============================================================================
+//  Batch_RunGame֐ - Q[1{A^CgŌ܂ŗV΂ďWv܂
+//=============================================================================
+static void Batch_RunGame(BatchStats& stats, unsigned long seed)
+{
+    static __thread World world;    // 傫̂ŁAXbhƂ1pӂĎg񂵂܂
+    PolicyState policy;
+    unsigned long frame;
+    unsigned long lifeStart = 0;
+    bool started = false;
+
+    Sim_Init(world, seed, g_Config.stages, g_Config.stageCount);
+    Policy_Init(policy, g_Config.policy, seed ^ 0x5A5A5A5AUL);
+    policy.lookAhead = Scalar_FromFloat(g_Config.lookAhead);
+    policy.jumpOneIn = g_Config.jumpOneIn;
+
+    for (frame = 0; frame < g_Config.maxFrames; frame++){
+        GameState   beforeState  = world.gameState;
+        PlayerState beforePlayer = world.player.state;
+        int         stage        = world.currentStage;
+
+        Sim_Step(world, Policy_Choose(policy, world, frame));
+
+        // Xe[W̊Jn (^CgA܂̓Xe[WNAʂ)
+        if (world.gameState == STATE_PLAYING && beforeState != STATE_PLAYING){
+            started = true;
+            stats.stages[world.currentStage].reached++;
+            lifeStart = world.time;
+            continue;
+        }
+        // Ō̃Xe[W̃NAʂ𔲂ƁAQ[NAł
+        if (world.gameState == STATE_GAME_CLEAR){
+            stats.gameClears++;
+            break;
+        }
+        if (!started || beforeState != STATE_PLAYING){
+            continue;
+        }
+
+        StageStats& st = stats.stages[stage];
+
+        // ~X
+        if (world.player.state == PSTATE_MISS && beforePlayer != PSTATE_MISS){
+            if (world.player.missCause == MISS_PIT) st.missPit++;
+            else                                    st.missObstacle++;
+            Batch_EndLife(st, world.time - lifeStart, true);
+        }
+        //  (V)
+        if (world.player.state == PSTATE_RESPAWNING && beforePlayer == PSTATE_MISS){
+            lifeStart = world.time;
+        }
+        // Xe[WNA
+        if (world.gameState == STATE_STAGE_CLEAR){
+            st.clears++;
+            st.scoreSum += (double)world.score;
+            Batch_EndLife(st, world.time - lifeStart, false);
+        }
+        // Q[I[o[
+        if (world.gameState == STATE_GAMEOVER){
+            st.scoreSum += (double)world.score;
+            break;
+        }
+    }
+
+    if (frame >= g_Config.maxFrames){
+        stats.timeouts++;
+    }
+    stats.runs++;
+    stats.scoreSum += (double)world.score;
+    stats.simSeconds += (double)world.time / 1000.0;
+}
+
+// 1̖̏IAĂԂƂɐ܂
+static void Batch_EndLife(StageStats& stage, unsigned long lifeMs, bool died)
+{
+    unsigned long bucket = lifeMs / SURVIVAL_BUCKET_MS;
+    if (bucket > SURVIVAL_BUCKETS) bucket = SURVIVAL_BUCKETS;
+    if (died) stage.deaths[bucket]++;
+    else      stage.cleared[bucket]++;
+}
+
+//=============================================================================
+//  d̎󂯓n ([NXeB[O)
+//=============================================================================
+// ͈̔͂̐擪1{܂
+static bool Batch_TakeJob(Worker& self, unsigned long& job)
+{
+    bool ok = false;
+    pthread_mutex_lock(&self.lock);
+    if (self.next < self.end){
+        job = self.next++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&self.lock);
+    return ok;
+}
+
+// ق̃Xbh͈̔͂̌딼炢A̐擪1{Ԃ܂
+static bool Batch_StealJob(Worker& self, unsigned long& job)
+{
+    int i;
+    for (i = 1; i < g_Config.threadCount; i++){
+        Worker& victim = g_Config.workers[(self.index + i) % g_Config.threadCount];
+        unsigned long begin = 0, end = 0;
+
+        pthread_mutex_lock(&victim.lock);
+        unsigned long remaining = victim.end - victim.next;
+        if (remaining > 0){
+            begin = victim.end - (remaining + 1) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+        pthread_mutex_unlock(&victim.lock);
+
+        if (begin < end){
+            pthread_mutex_lock(&self.lock);
+            self.next = begin + 1;
+            self.end = end;
+            self.steals++;
+            pthread_mutex_unlock(&self.lock);
+            job = begin;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* Batch_WorkerMain(void* arg)
+{
+    Worker& self = *(Worker*)arg;
+    unsigned long job;
+
+    while (Batch_TakeJob(self, job) || Batch_StealJob(self, job)){
+        Batch_RunGame(self.stats, g_Config.seed + job);
+    }
+    return NULL;
+}
+
+//=============================================================================
+//  Wvʂ̍vƕ\
+//=============================================================================
+static void Batch_Merge(BatchStats& total, const BatchStats& part, int stageCount)
+{
+    int s, b;
+    total.runs       += part.runs;
+    total.gameClears += part.gameClears;
+    total.timeouts   += part.timeouts;
+    total.scoreSum   += part.scoreSum;
+    total.simSeconds += part.simSeconds;
+
+    for (s = 0; s < stageCount; s++){
+        StageStats& t = total.stages[s];
+        const StageStats& p = part.stages[s];
+        t.reached      += p.reached;
+        t.clears       += p.clears;
+        t.missObstacle += p.missObstacle;
+        t.missPit      += p.missPit;
+        t.scoreSum     += p.scoreSum;
+        for (b = 0; b <= SURVIVAL_BUCKETS; b++){
+            t.deaths[b]  += p.deaths[b];
+            t.cleared[b] += p.cleared[b];
+        }
+    }
+}
+
+static void Batch_Report(const BatchStats& total, double seconds)
+{
+    int s, b, r;
+
+    printf("runs         : %lu (policy %s, %d threads)\n", total.runs, Policy_Name(g_Config.policy), g_Config.threadCount);
+    printf("game clears  : %lu (%.2f%%)\n", total.gameClears, total.runs ? 100.0 * total.gameClears / total.runs : 0.0);
+    printf("timeouts     : %lu\n", total.timeouts);
+    printf("avg score    : %.1f\n", total.runs ? total.scoreSum / total.runs : 0.0);
+    printf("sim time     : %.0f s in %.3f s (%.2fM sim seconds per minute)\n", total.simSeconds, seconds,
+           seconds > 0 ? total.simSeconds / seconds * 60.0 / 1e6 : 0.0);
+    printf("\n");
+
+    // Ȑ̓JvE}C[@ŋ߂܂
+    // (NAŏÍu̎Ԃ܂ł͐ĂvƂ܂)
+    printf("stage  reached  clear%%  avg score  wall  pit ");
+    for (r = 0; r < NUM_SURVIVAL_REPORT; r++) printf("  S(%2ds)", s_SurvivalReport[r]);
+    printf("\n");
+
+    for (s = 0; s < g_Config.stageCount; s++){
+        const StageStats& st = total.stages[s];
+        if (st.reached == 0){
+            continue;
+        }
+
+        unsigned long atRisk = 0;
+        for (b = 0; b <= SURVIVAL_BUCKETS; b++) atRisk += st.deaths[b] + st.cleared[b];
+
+        double survival = 1.0;
+        double curve[SURVIVAL_BUCKETS + 1];
+        for (b = 0; b <= SURVIVAL_BUCKETS; b++){
+            if (atRisk > 0) survival *= 1.0 - (double)st.deaths[b] / (double)atRisk;
+            curve[b] = survival;
+            atRisk -= st.deaths[b] + st.cleared[b];
+        }
+
+        printf("%5d  %7lu  %5.1f%%  %9.1f  %4.0f%%  %3.0f%%", s + 1, st.reached, 100.0 * st.clears / st.reached,
+               st.scoreSum / st.reached,
+               (st.missObstacle + st.missPit) ? 100.0 * st.missObstacle / (st.missObstacle + st.missPit) : 0.0,
+               (st.missObstacle + st.missPit) ? 100.0 * st.missPit / (st.missObstacle + st.missPit) : 0.0);
+        for (r = 0; r < NUM_SURVIVAL_REPORT; r++){
+            int t = s_SurvivalReport[r] * 1000 / SURVIVAL_BUCKET_MS;
+            printf("  %6.3f", curve[t - 1 < SURVIVAL_BUCKETS ? t - 1 : SURVIVAL_BUCKETS]);
+        }
+        printf("\n");
+    }
+}
+
+//=============================================================================
+//  main֐ - ܂Ƃ߂Ďsc[͂n܂܂
+//=============================================================================
+int main(int argc, char* argv[])
+{
+    int i;
+    unsigned long runs = 10000;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char* stagesPath = NULL;
+    double maxSeconds = 600.0;
+
+    g_Config.policy = POLICY_AUTO;
+    g_Config.lookAhead = 40.0f;
+    g_Config.jumpOneIn = 8;
+    g_Config.seed = 1;
+
+    // 1. R}hC̓ǂݎ
+    for (i = 1; i < argc; i++){
+        if (strcmp(argv[i], "-runs") == 0 && i + 1 < argc){
+            runs = strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc){
+            threads = atoi(argv[++i]);
+        }else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc){
+            g_Config.seed = strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-policy") == 0 && i + 1 < argc){
+            i++;
+            if (!Policy_FromName(argv[i], g_Config.policy)){ fprintf(stderr, "unknown policy: %s\n", argv[i]); return 1; }
+        }else if (strcmp(argv[i], "-lookahead") == 0 && i + 1 < argc){
+            g_Config.lookAhead = (float)atof(argv[++i]);
+        }else if (strcmp(argv[i], "-jump-one-in") == 0 && i + 1 < argc){
+            g_Config.jumpOneIn = atoi(argv[++i]);
+        }else if (strcmp(argv[i], "-max-seconds") == 0 && i + 1 < argc){
+            maxSeconds = atof(argv[++i]);
+        }else if (strcmp(argv[i], "-stages") == 0 && i + 1 < argc){
+            stagesPath = argv[++i];
+        }else{
+            fprintf(stderr, "usage: %s [-runs N] [-threads N] [-seed N] [-policy auto|random|idle] [-lookahead px] [-jump-one-in N] [-max-seconds s] [-stages file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > BATCH_MAX_THREADS) threads = BATCH_MAX_THREADS;
+    if ((unsigned long)threads > runs && runs > 0) threads = (int)runs;
+    if (g_Config.jumpOneIn < 1) g_Config.jumpOneIn = 1;
+
+    // 2. Xe[W\ (w肪ȂΑgݍ݂5Xe[W)
+    static StagePack pack;
+    StagePack_Init(pack);
+    if (stagesPath != NULL && !StagePack_Open(pack, stagesPath)){
+        fprintf(stderr, "cannot open stage pack %s\n", stagesPath);
+        return 1;
+    }
+    static World probe;
+    Sim_Init(probe, 0, pack.stages, pack.stageCount);
+    g_Config.stages = probe.stages;
+    g_Config.stageCount = probe.stageCount;
+    g_Config.maxFrames = (unsigned long)(maxSeconds * 1000.0 / SIM_TICK_MS);
+    g_Config.threadCount = threads;
+
+    // 3. XbhƂ̎pӂāAQ[̔ԍ𓙕Ĕz܂
+    Worker* workers = (Worker*)calloc(threads, sizeof(Worker));
+    BatchStats total;
+    memset(&total, 0, sizeof(total));
+    total.stages = (StageStats*)calloc(g_Config.stageCount, sizeof(StageStats));
+    if (workers == NULL || total.stages == NULL){
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    g_Config.workers = workers;
+
+    for (i = 0; i < threads; i++){
+        Worker& w = workers[i];
+        w.index = i;
+        w.next = runs * i / threads;
+        w.end = runs * (i + 1) / threads;
+        w.stats.stages = (StageStats*)calloc(g_Config.stageCount, sizeof(StageStats));
+        if (w.stats.stages == NULL){
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+        pthread_mutex_init(&w.lock, NULL);
+    }
+
+    // 4. SXbhŗV΂āAÎ҂܂
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < threads; i++){
+        if (pthread_create(&workers[i].thread, NULL, Batch_WorkerMain, &workers[i]) != 0){
+            fprintf(stderr, "cannot create thread\n");
+            return 1;
+        }
+    }
+    unsigned long steals = 0;
+    for (i = 0; i < threads; i++){
+        pthread_join(workers[i].thread, NULL);
+        Batch_Merge(total, workers[i].stats, g_Config.stageCount);
+        steals += workers[i].steals;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    double seconds = (double)(finish.tv_sec - start.tv_sec) + (double)(finish.tv_nsec - start.tv_nsec) / 1e9;
+
+    // 5. ʂ̕\
+    Batch_Report(total, seconds);
+    printf("\nsteals       : %lu\n", steals);
+
+    for (i = 0; i < threads; i++){
+        pthread_mutex_destroy(&workers[i].lock);
+        free(workers[i].stats.stages);
+    }
+    free(workers);
+    free(total.stages);
+    StagePack_Close(pack);
+    return 0;
+}
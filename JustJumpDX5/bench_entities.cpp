@@ -0,0 +1,234 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ǂ̎̑ (Linuxp)
+//
+//  ǂuɓEvC[Ƃ̓蔻Eʂ߂瓾_v鏈A
+//  3ʂ̃f[^̎ŁAǂ̐ςȂ瑪܂B
+//
+//    aos   ...  main.cpp ̌`B{ active, x, height, scored } ̍\̂̔zŁA
+//              t[S x 𓮂Aactive ĕ򂵂܂
+//    soa   ... x / height / scored ʁX̔zɌԂȂl߂` (SoA)B
+//              E蔻͕Ȃŏ̂ŁARpC SIMD ߂ɂł܂
+//    ring  ...  sim.cpp ̌`BSoA ɃR[X̍Wō珇ɕׂOobt@ɂāA
+//              x ͏ scroll 𓮂AvC[̋߂̕ǂ𒲂ׂ܂
+//
+//  g:
+//    ./jjbench [-frames ]
+//
+//  checksum ͓񐔂Ɠ_̍vłBaos  soa ͓lɂȂ܂
+//  (ring ͍W̌vZ̏ԂႤ̂ŁAfloat ̌덷̕邱Ƃ܂)B
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+
+//-----------------------------------------------------------------------------
+//  ݒl
+//-----------------------------------------------------------------------------
+static const int s_Counts[] = { 10, 1000, 100000 };
+#define NUM_COUNTS      ((int)(sizeof(s_Counts) / sizeof(s_Counts[0])))
+
+#define BENCH_SPEED     -5.0f       // 1t[œ
+#define BENCH_SPACING   40.0f       // ǂƕǂ̊Ԋu
+#define BENCH_PLAYER_X  100         // vC[̈ʒu (sim.cpp Ɠ)
+#define BENCH_PLAYER_Y  (GROUND_Y - PLAYER_SIZE - 25)
+
+//-----------------------------------------------------------------------------
+//  ꂼ̎
+//-----------------------------------------------------------------------------
+struct AosObstacle { bool active; float x; int height; bool scored; };
+
+struct BenchData
+{
+    int          count;
+    float        span;          // ǂ̗̑Ŝ̒ ([ɏǂ́A̕Eɖ߂܂)
+
+    AosObstacle* aos;
+
+    float*       soaX;
+    int*         soaHeight;
+    int*         soaScored;     // 򂹂ɌvZɎg悤Abool ł͂Ȃ 0 / 1  int ɂ܂
+
+    float*       ringX;         // R[X̍W (珇)
+    int*         ringHeight;
+    int*         ringScored;
+    int          ringHead;
+    float        scroll;
+};
+
+struct BenchResult
+{
+    unsigned long hits;
+    unsigned long score;
+};
+
+//=============================================================================
+//  Bench_Setup֐ - 3ʂ̎ɁAǂ̕т܂
+//=============================================================================
+static void Bench_Setup(BenchData& d, int count)
+{
+    int i;
+    d.count = count;
+    d.span = count * BENCH_SPACING;
+    d.aos        = (AosObstacle*)malloc(count * sizeof(AosObstacle));
+    d.soaX       = (float*)malloc(count * sizeof(float));
+    d.soaHeight  = (int*)malloc(count * sizeof(int));
+    d.soaScored  = (int*)malloc(count * sizeof(int));
+    d.ringX      = (float*)malloc(count * sizeof(float));
+    d.ringHeight = (int*)malloc(count * sizeof(int));
+    d.ringScored = (int*)malloc(count * sizeof(int));
+    d.ringHead = 0;
+    d.scroll = 0;
+
+    unsigned long rng = 12345;
+    for (i = 0; i < count; i++){
+        rng = (rng * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+        int height = 30 + (int)((rng >> 16) % 50);
+        float x = BENCH_PLAYER_X + 200.0f + i * BENCH_SPACING;
+
+        d.aos[i].active = true; d.aos[i].x = x; d.aos[i].height = height; d.aos[i].scored = false;
+        d.soaX[i] = x;  d.soaHeight[i] = height;  d.soaScored[i] = 0;
+        d.ringX[i] = x; d.ringHeight[i] = height; d.ringScored[i] = 0;
+    }
+}
+
+static void Bench_Free(BenchData& d)
+{
+    free(d.aos);
+    free(d.soaX); free(d.soaHeight); free(d.soaScored);
+    free(d.ringX); free(d.ringHeight); free(d.ringScored);
+}
+
+//=============================================================================
+//  1t[̏ (3ʂ)
+//=============================================================================
+// ̌`: S̕ǂ𓮂Aactive ̕ǂׂ܂
+static void Bench_StepAos(BenchData& d, BenchResult& r)
+{
+    int i;
+    const int pl = BENCH_PLAYER_X, pr = pl + PLAYER_SIZE, pt = BENCH_PLAYER_Y, pb = pt + PLAYER_SIZE;
+
+    for (i = 0; i < d.count; i++){
+        AosObstacle& ob = d.aos[i];
+        if (ob.active){
+            ob.x += BENCH_SPEED;
+            if (ob.x < -OBSTACLE_WIDTH){ ob.x += d.span; ob.scored = false; }
+
+            int x = (int)ob.x;
+            if (pl < x + OBSTACLE_WIDTH && x < pr && pt < GROUND_Y && GROUND_Y - ob.height < pb){ r.hits++; }
+            if (!ob.scored && ob.x + OBSTACLE_WIDTH < pl){ ob.scored = true; r.score += 10; }
+        }
+    }
+}
+
+// SoA: vZAڂƂ̔zɑ΂ĕȂōs܂
+static void Bench_StepSoa(BenchData& d, BenchResult& r)
+{
+    int i;
+    const int n = d.count;
+    const int pl = BENCH_PLAYER_X, pr = pl + PLAYER_SIZE, pt = BENCH_PLAYER_Y, pb = pt + PLAYER_SIZE;
+    const float span = d.span;     // x[] Ɠ float Ȃ̂ŁA[JɎʂĂȂƖǂݒ܂
+    float* x = d.soaX;
+    int* height = d.soaHeight;
+    int* scored = d.soaScored;
+    int hits = 0, passed = 0;
+
+    for (i = 0; i < n; i++){
+        float nx = x[i] + BENCH_SPEED;
+        int wrap = nx < -OBSTACLE_WIDTH;
+        x[i] = nx + span * (float)wrap;
+        scored[i] &= !wrap;
+    }
+    for (i = 0; i < n; i++){
+        int ix = (int)x[i];
+        hits += (pl < ix + OBSTACLE_WIDTH) & (ix < pr) & (pt < GROUND_Y) & (GROUND_Y - height[i] < pb);
+    }
+    for (i = 0; i < n; i++){
+        int pass = (x[i] + OBSTACLE_WIDTH < pl) & !scored[i];
+        passed += pass;
+        scored[i] |= pass;
+    }
+    r.hits += (unsigned long)hits;
+    r.score += (unsigned long)passed * 10;
+}
+
+// Oobt@: scroll 𓮂A[ɏǂE[ɉ񂵂āAvC[̋߂ׂ܂
+static void Bench_StepRing(BenchData& d, BenchResult& r)
+{
+    int i;
+    const int n = d.count;
+    const int pl = BENCH_PLAYER_X, pr = pl + PLAYER_SIZE, pt = BENCH_PLAYER_Y, pb = pt + PLAYER_SIZE;
+
+    d.scroll -= BENCH_SPEED;
+    while (d.ringX[d.ringHead] - d.scroll < -OBSTACLE_WIDTH){
+        d.ringX[d.ringHead] += d.span;
+        d.ringScored[d.ringHead] = 0;
+        d.ringHead = (d.ringHead + 1) % n;
+    }
+
+    for (i = 0; i < n; i++){
+        int slot = (d.ringHead + i) % n;
+        float sx = d.ringX[slot] - d.scroll;
+        int ix = (int)sx;
+        if (ix >= pr) break;
+        if (pl < ix + OBSTACLE_WIDTH && pt < GROUND_Y && GROUND_Y - d.ringHeight[slot] < pb){ r.hits++; }
+        if (!d.ringScored[slot] && sx + OBSTACLE_WIDTH < pl){ d.ringScored[slot] = 1; r.score += 10; }
+    }
+}
+
+//=============================================================================
+//  Bench_Run֐ - 1̎A܂t[񂵂ĎԂ𑪂܂
+//=============================================================================
+typedef void (*BenchStep)(BenchData& d, BenchResult& r);
+
+static void Bench_Run(const char* name, BenchStep step, int count, unsigned long frames)
+{
+    unsigned long f;
+    BenchData d;
+    BenchResult r;
+    Bench_Setup(d, count);
+    r.hits = 0; r.score = 0;
+
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (f = 0; f < frames; f++){
+        step(d, r);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+
+    double ns = (double)(finish.tv_sec - start.tv_sec) * 1e9 + (double)(finish.tv_nsec - start.tv_nsec);
+    printf("%-5s %7d  %10.1f ns/frame  %7.3f ns/entity  checksum %lu/%lu\n", name, count,
+           ns / frames, ns / frames / count, r.hits, r.score);
+    Bench_Free(d);
+}
+
+//=============================================================================
+//  main֐
+//=============================================================================
+int main(int argc, char* argv[])
+{
+    int i;
+    unsigned long frames = 0;
+
+    for (i = 1; i < argc; i++){
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc){
+            frames = strtoul(argv[++i], NULL, 10);
+        }else{
+            fprintf(stderr, "usage: %s [-frames N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("layout  count\n");
+    for (i = 0; i < NUM_COUNTS; i++){
+        // w肪Ȃ΁Aǂ̐ł1炢̏ɂȂ悤ɂ܂
+        unsigned long n = frames ? frames : 100000000UL / s_Counts[i];
+        Bench_Run("aos",  Bench_StepAos,  s_Counts[i], n);
+        Bench_Run("soa",  Bench_StepSoa,  s_Counts[i], n);
+        Bench_Run("ring", Bench_StepRing, s_Counts[i], n);
+    }
+    return 0;
+}
@@ -0,0 +1,243 @@
+//=============================================================================
+//
+//  wWXgWv DX5x GhX[h̋ԂAʂ̃XbhŐɍ
+//
+//=============================================================================
+#include <string.h>
+#include "chunkstream.h"
+#include "endless.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <process.h>    // Xbh@\ (_beginthreadex)
+#endif
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+#ifdef _WIN32
+static unsigned __stdcall ChunkStream_ThreadMain(void* param);
+#else
+static void* ChunkStream_ThreadMain(void* param);
+#endif
+static void ChunkStream_Request(ChunkStream& stream, unsigned long seed, unsigned long index);
+static void ChunkStream_Wake(ChunkStream& stream);
+static void ChunkStream_Wait(ChunkStream& stream);
+static long ChunkStream_Load(volatile long* p);
+static void ChunkStream_Store(volatile long* p, long n);
+
+//=============================================================================
+//  ChunkStream_Start֐ - ҂sɂāAԂW̃Xbh𓮂܂
+//   (XbhȂ falseB̂Ƃ ChunkStream_Provide g킸A
+//    Sim ɂ̏ōĂĂ)
+//=============================================================================
+bool ChunkStream_Start(ChunkStream& stream)
+{
+    memset(&stream, 0, sizeof(stream));
+
+#ifdef _WIN32
+    stream.wake = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (stream.wake == NULL){
+        return false;
+    }
+    // (W C ̕WCuĝŁACreateThread ł͂Ȃ _beginthreadex ō܂B
+    //  vWFNg̓}`Xbhp̃^C (/MT) ƃNĂ܂)
+    stream.thread = (void*)_beginthreadex(NULL, 0, ChunkStream_ThreadMain, &stream, 0, NULL);
+    if (stream.thread == NULL){
+        CloseHandle(stream.wake);
+        return false;
+    }
+    // ẂAQ[̃Xbh̎זȂ悤ɁAႢDxœ܂
+    SetThreadPriority(stream.thread, THREAD_PRIORITY_BELOW_NORMAL);
+#else
+    pthread_mutex_init(&stream.lock, NULL);
+    pthread_cond_init(&stream.wake, NULL);
+    if (pthread_create(&stream.thread, NULL, ChunkStream_ThreadMain, &stream) != 0){
+        pthread_cond_destroy(&stream.wake);
+        pthread_mutex_destroy(&stream.lock);
+        return false;
+    }
+#endif
+    stream.running = true;
+    return true;
+}
+
+//=============================================================================
+//  ChunkStream_Stop֐ - W̃Xbh~߂āAÎ҂܂
+//=============================================================================
+void ChunkStream_Stop(ChunkStream& stream)
+{
+    if (!stream.running){
+        return;
+    }
+    ChunkStream_Store(&stream.quit, 1);
+    ChunkStream_Wake(stream);
+
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)stream.thread, INFINITE);
+    CloseHandle((HANDLE)stream.thread);
+    CloseHandle((HANDLE)stream.wake);
+#else
+    pthread_join(stream.thread, NULL);
+    pthread_cond_destroy(&stream.wake);
+    pthread_mutex_destroy(&stream.lock);
+#endif
+    stream.running = false;
+}
+
+//=============================================================================
+//  ChunkStream_Take֐ - seed  index Ԗڂ̋Ԃ chunk Ɏʂ܂ (Q[̃XbhĂт܂)
+//   ĂԂg trueBȂ΂̏ō false ԂA
+//   Wɂ́A̎̋Ԃ蒼Ă炢܂
+//=============================================================================
+bool ChunkStream_Take(ChunkStream& stream, unsigned long seed, unsigned long index, Chunk& chunk)
+{
+    long head = stream.head;
+    long tail = ChunkStream_Load(&stream.tail);
+
+    // ~ԂO̕ (Â̕A߂̐̕) ͎̂Ă܂
+    while (head != tail){
+        const Chunk& ready = stream.queue[head & (CHUNK_QUEUE_SIZE - 1)];
+        bool match = ready.seed == seed && ready.index == index;
+        if (match){
+            chunk = ready;
+        }else{
+            stream.discarded++;
+        }
+        head++;
+        ChunkStream_Store(&stream.head, head);     // ʂIĂAꏊ󂯂܂
+        if (match){
+            stream.taken++;
+            ChunkStream_Wake(stream);              // 󂢂ɁA̋ԂĂ炢܂
+            return true;
+        }
+    }
+
+    Endless_GenerateChunk(seed, index, chunk);
+    stream.stalls++;
+    ChunkStream_Request(stream, seed, index + 1);
+    return false;
+}
+
+//=============================================================================
+//  ChunkStream_Prefetch֐ - seed ̃R[XAŏ̋Ԃn߂Ă炢܂
+//   (̃Q[n܂OɁA^CgʂȂǂŖt[Ăł܂܂B
+//    肢Ă΁A܂)
+//=============================================================================
+void ChunkStream_Prefetch(ChunkStream& stream, unsigned long seed)
+{
+    if (!stream.requested || stream.lastSeed != seed){
+        ChunkStream_Request(stream, seed, 0);
+    }
+}
+
+//=============================================================================
+//  ChunkStream_Provide֐ - Sim_SetChunkProvider ɓn` ChunkStream_Take ł
+//   (context ɂ ChunkStream nĂ)
+//=============================================================================
+void ChunkStream_Provide(void* context, unsigned long seed, unsigned long index, Chunk& chunk)
+{
+    ChunkStream_Take(*(ChunkStream*)context, seed, index, chunk);
+}
+
+//=============================================================================
+//  ԂW̃Xbh
+//   肢ꂽƔԍ珇ɁA҂s񂪂ςɂȂ܂ō܂B
+//   ςɂȂAQ[̃XbhoċNĂ܂Ŗ܂
+//=============================================================================
+#ifdef _WIN32
+static unsigned __stdcall ChunkStream_ThreadMain(void* param)
+#else
+static void* ChunkStream_ThreadMain(void* param)
+#endif
+{
+    ChunkStream& stream = *(ChunkStream*)param;
+    long seen = 0;
+    unsigned long seed = 0, next = 0;
+    bool active = false;
+
+    while (!ChunkStream_Load(&stream.quit)){
+        // V肢ĂA蒼܂
+        // (ǂłԂɎ̂肢āAƔԍ͂ɂȂĂA
+        //  Ԃɂ͎ۂɎgƔԍ̂ŁAQ[̃XbĥĂĂ܂)
+        long count = ChunkStream_Load(&stream.requestCount);
+        if (count != seen){
+            seen = count;
+            seed = stream.requestSeed;
+            next = stream.requestIndex;
+            active = true;
+        }
+
+        long tail = stream.tail;
+        if (active && tail - ChunkStream_Load(&stream.head) < CHUNK_QUEUE_SIZE){
+            Endless_GenerateChunk(seed, next, stream.queue[tail & (CHUNK_QUEUE_SIZE - 1)]);
+            next++;
+            ChunkStream_Store(&stream.tail, tail + 1);   // IĂAǂ߂悤ɂ܂
+        }else{
+            ChunkStream_Wait(stream);
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// WɁuseed  index ԖڂāvƂ肢܂
+static void ChunkStream_Request(ChunkStream& stream, unsigned long seed, unsigned long index)
+{
+    stream.requestSeed = seed;
+    stream.requestIndex = index;
+    ChunkStream_Store(&stream.requestCount, stream.requestCount + 1);   // ƔԍĂ瑝₵܂
+    stream.lastSeed = seed;
+    stream.requested = true;
+    ChunkStream_Wake(stream);
+}
+
+// ĂWN܂ / N܂Ŗ܂
+static void ChunkStream_Wake(ChunkStream& stream)
+{
+#ifdef _WIN32
+    SetEvent((HANDLE)stream.wake);
+#else
+    pthread_mutex_lock(&stream.lock);
+    stream.signaled = 1;
+    pthread_cond_signal(&stream.wake);
+    pthread_mutex_unlock(&stream.lock);
+#endif
+}
+
+static void ChunkStream_Wait(ChunkStream& stream)
+{
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)stream.wake, INFINITE);
+#else
+    pthread_mutex_lock(&stream.lock);
+    while (!stream.signaled){
+        pthread_cond_wait(&stream.wake, &stream.lock);
+    }
+    stream.signaled = 0;
+    pthread_mutex_unlock(&stream.lock);
+#endif
+}
+
+// ̃Xbhǂݏ܂BƂ́AOɏԂ₨肢̒gA
+// ̃XbhɌ悤ɂ܂
+static long ChunkStream_Load(volatile long* p)
+{
+#ifdef _WIN32
+    return InterlockedExchangeAdd((LONG volatile*)p, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void ChunkStream_Store(volatile long* p, long n)
+{
+#ifdef _WIN32
+    InterlockedExchange((LONG volatile*)p, n);
+#else
+    __atomic_store_n(p, n, __ATOMIC_RELEASE);
+#endif
+}
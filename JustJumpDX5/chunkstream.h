@@ -0,0 +1,79 @@
+//=============================================================================
+//
+//  wWXgWv DX5x GhX[h̋ԂAʂ̃XbhŐɍ
+//
+//  W̃XbhA (Chunk)  CHUNK_QUEUE_SIZE ܂ō
+//  ҂s (Oobt@) ɓĂAQ[̃Xbh͋ԂKvɂȂ
+//  oɂ܂BԂ鎞Ԃ́At[̎Ԃɓ܂B
+//
+//  ҂śu1Eǂޑ1v̌܂ŎĝŁAbN͂܂B
+//    tail ... W܂ (ԂIĂ1i߂܂)
+//    head ... Q[̃Xbh܂ (ԂʂIĂ1i߂܂)
+//  Ԃ̐͌܂Ă̂ŁAǂꂾVł͑܂B
+//
+//  ~Ԃ܂łĂȂ (߂ƂÃQ[n܂ƂȂ)A
+//  ̋Ԃ̓Q[̃Xbhł̏ōAWɂ͂̎蒼Ă炢܂B
+//  Ԃ̒g͎ƔԍŌ܂̂ŁAǂōĂQ[WJɂȂ܂B
+//
+//  g:
+//    ChunkStream_Start(stream);
+//    Sim_SetChunkProvider(world, ChunkStream_Provide, &stream);
+//    ChunkStream_Prefetch(stream, Sim_EndlessSeed(world, world.gameCount + 1));  // ^Cgʂ
+//    ...
+//    ChunkStream_Stop(stream);
+//
+//=============================================================================
+#ifndef CHUNKSTREAM_H
+#define CHUNKSTREAM_H
+
+#include "sim.h"
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+#define CHUNK_QUEUE_SIZE    4       // ɍĂԂ̐ (2ׂ̂B1Ԃŉ4`5)
+
+struct ChunkStream
+{
+    Chunk           queue[CHUNK_QUEUE_SIZE];
+    volatile long   head;               // Ɏoʒu (Q[̃Xbh܂)
+    volatile long   tail;               // ɏވʒu (W܂)
+
+    // u̎́A̔ԍāvƂ肢 (requestCount Ōɑ₵܂)
+    volatile unsigned long requestSeed;
+    volatile unsigned long requestIndex;
+    volatile long   requestCount;
+    volatile long   quit;
+    bool            running;
+
+#ifdef _WIN32
+    void*           thread;             // HANDLE
+    void*           wake;               // WNCxg (HANDLE)
+#else
+    pthread_t       thread;
+    pthread_mutex_t lock;               // wake  signaled ܂ (҂s񂻂̂̂ɂ͎g܂)
+    pthread_cond_t  wake;
+    int             signaled;
+#endif
+
+    // Ōɂ肢 (Q[̃Xbhg܂)
+    unsigned long   lastSeed;
+    bool            requested;
+
+    // v (Q[̃Xbh܂)
+    unsigned long   taken;              // ĂԂg
+    unsigned long   stalls;             // Ԃɍ킸ɁȀō
+    unsigned long   discarded;          // g킸Ɏ̂ĂԂ̐ (߂A킪ςƂ)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+bool ChunkStream_Start(ChunkStream& stream);
+void ChunkStream_Stop(ChunkStream& stream);
+bool ChunkStream_Take(ChunkStream& stream, unsigned long seed, unsigned long index, Chunk& chunk);
+void ChunkStream_Prefetch(ChunkStream& stream, unsigned long seed);
+void ChunkStream_Provide(void* context, unsigned long seed, unsigned long index, Chunk& chunk);
+
+#endif // CHUNKSTREAM_H
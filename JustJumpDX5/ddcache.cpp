@@ -0,0 +1,92 @@
+//=============================================================================
+//
+//  wWXgWv DX5x DirectDraw ̓hԂ̐F̒u (Windowsł)
+//
+//=============================================================================
+#define WIN32_LEAN_AND_MEAN
+#include "ddcache.h"
+
+//=============================================================================
+//  DDCache_Init֐ - ̒upӂ܂ (format ͗̐F̌`)
+//=============================================================================
+void DDCache_Init(DDCache& cache, const DDPIXELFORMAT& format)
+{
+    ZeroMemory(&cache, sizeof(cache));
+    cache.format = format;
+    cache.overflow.dwSize = sizeof(DDBLTFX);
+}
+
+//=============================================================================
+//  DDCache_Shutdown֐ - ƂĂFŜĂ܂
+//=============================================================================
+void DDCache_Shutdown(DDCache& cache)
+{
+    ZeroMemory(&cache, sizeof(cache));
+}
+
+//=============================================================================
+//  DDCache_AddColor֐ - FϊĂƂĂ܂ (ԍԂ܂BςȂ -1)
+//=============================================================================
+int DDCache_AddColor(DDCache& cache, unsigned int rgb)
+{
+    int i;
+    for (i = 0; i < cache.colorCount; i++){
+        if (cache.rgb[i] == rgb){
+            return i;
+        }
+    }
+    if (cache.colorCount >= DDCACHE_MAX_COLORS){
+        return -1;
+    }
+
+    i = cache.colorCount++;
+    cache.rgb[i] = rgb;
+    ZeroMemory(&cache.fill[i], sizeof(DDBLTFX));
+    cache.fill[i].dwSize = sizeof(DDBLTFX);
+    cache.fill[i].dwFillColor = DDCache_SurfaceColor(cache.format, rgb);
+    return i;
+}
+
+//=============================================================================
+//  DDCache_Fill֐ - ̐Fœh邽߂ DDBLTFX Ԃ܂
+//   (ƂĂĂȂF́Aő܂BԂ͎ɌĂԂ܂Ŏg܂)
+//=============================================================================
+const DDBLTFX* DDCache_Fill(DDCache& cache, unsigned int rgb)
+{
+    int i;
+
+    if (cache.lastHit < cache.colorCount && cache.rgb[cache.lastHit] == rgb){
+        return &cache.fill[cache.lastHit];
+    }
+
+    i = DDCache_AddColor(cache, rgb);
+    if (i >= 0){
+        cache.lastHit = i;
+        return &cache.fill[i];
+    }
+
+    cache.overflow.dwFillColor = DDCache_SurfaceColor(cache.format, rgb);
+    cache.overflows++;
+    return &cache.overflow;
+}
+
+//=============================================================================
+//  DDCache_SurfaceColor֐ - 0x00RRGGBB ̐FA̐F̌`ɕϊ܂
+//=============================================================================
+DWORD DDCache_SurfaceColor(const DDPIXELFORMAT& format, unsigned int rgb)
+{
+    DWORD masks[3] = { format.dwRBitMask, format.dwGBitMask, format.dwBBitMask };
+    DWORD values[3] = { (rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF };
+    DWORD color = 0;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        DWORD mask = masks[i];
+        int shift = 0, bits = 0;
+        if (mask == 0) continue;
+        while ((mask & 1) == 0) { mask >>= 1; shift++; }
+        while ((mask & 1) != 0) { mask >>= 1; bits++; }
+        color |= ((values[i] >> (8 - bits)) << shift);
+    }
+    return color;
+}
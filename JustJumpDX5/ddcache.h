@@ -0,0 +1,48 @@
+//=============================================================================
+//
+//  wWXgWv DX5x DirectDraw ̓hԂ̐F̒u (Windowsł)
+//
+//   32rbgłȂƂ́Alp` DirectDraw ̓hԂ (DDBLT_COLORFILL) 
+//  1h܂B̂Ƃn DDBLTFX ̐F́A̐F̌` (16rbgȂ 565 Ȃ) 
+//  ϊĂKv܂Brbg}XN𒲂ׂĕϊɁA
+//  Q[ŎgF Game_Init ňxϊāAɂƂĂ܂B
+//  (ƂĂĂȂFAŏɎgƂɕϊđ܂)
+//
+//  ʂ̐FςăT[tFX蒼Ƃ́ADDCache_Init ł蒼܂B
+//
+//  g:
+//    DDCache_Init(cache, pixelFormat);
+//    DDCache_AddColor(cache, RENDER_RGB(0, 0, 100));     // 悭gF
+//    surface->Blt(&rc, NULL, NULL, DDBLT_COLORFILL | DDBLT_WAIT, (LPDDBLTFX)DDCache_Fill(cache, color));
+//    DDCache_Shutdown(cache);
+//
+//=============================================================================
+#ifndef DDCACHE_H
+#define DDCACHE_H
+
+#include <windows.h>
+#include <ddraw.h>
+
+#define DDCACHE_MAX_COLORS  64      // ƂĂF̐ (ӂꂽF́Aϊ܂)
+
+struct DDCache
+{
+    DDPIXELFORMAT format;                       // ̐F̌`
+    int           colorCount;
+    unsigned int  rgb[DDCACHE_MAX_COLORS];      // 0x00RRGGBB ̐F (RENDER_RGB ō)
+    DDBLTFX       fill[DDCACHE_MAX_COLORS];     // ̐Fœh邽߂ DDBLTFX (dwFillColor ͕ϊς)
+    int           lastHit;                      // O񌩂ԍ (FƂ̂ŁAɒׂ܂)
+    DDBLTFX       overflow;                     // ӂꂽFϊēĂ
+    unsigned long overflows;                    // ӂꂽFϊ
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void           DDCache_Init(DDCache& cache, const DDPIXELFORMAT& format);
+void           DDCache_Shutdown(DDCache& cache);
+int            DDCache_AddColor(DDCache& cache, unsigned int rgb);
+const DDBLTFX* DDCache_Fill(DDCache& cache, unsigned int rgb);
+DWORD          DDCache_SurfaceColor(const DDPIXELFORMAT& format, unsigned int rgb);
+
+#endif // DDCACHE_H
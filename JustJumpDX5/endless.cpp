@@ -0,0 +1,74 @@
+//=============================================================================
+//
+//  wWXgWv DX5x GhX[h̃R[X
+//
+//=============================================================================
+#include "endless.h"
+
+//=============================================================================
+//  Endless_Stage֐ - index Ԗڂ̋Ԃ̓AXe[WݒƓ`ŕԂ܂
+//   (ȆEǂ̑́A r (0.0`1.0 ɋ߂Â) ɍ킹ĂȂ߂炩ɕς܂B
+//    Ԃ̒gǂ̃rhłɂȂ悤ɁAr ̌vZQ[Ɠ Scalar ōs܂)
+//=============================================================================
+void Endless_Stage(unsigned long index, StageData& stage)
+{
+    Scalar r = Scalar_Ratio(index, index + ENDLESS_RAMP_CHUNKS);
+
+    stage.scrollSpeed         = Scalar_ToFloat(SCALAR_CONST(-4.0f) - SCALAR_CONST(5.0f) * r);  // -4.0  -9.0
+    stage.clearScore          = 0x7FFFFFFF;                     // NA͂܂
+    stage.pitChance           = (index == 0) ? 0 : 8 - Scalar_ToInt(SCALAR_CONST(5.0f) * r);  // 1/8  1/4
+    stage.pitWidthMin         = 50 + Scalar_ToInt(SCALAR_CONST(30.0f) * r);     //  50`89  79`118
+    stage.pitWidthRange       = 40;
+    stage.groundWidthMin      = 100;
+    stage.groundWidthRange    = 200 - Scalar_ToInt(SCALAR_CONST(80.0f) * r);    // nʂ͏Z
+    stage.obstacleChance      = 4 - Scalar_ToInt(SCALAR_CONST(2.5f) * r);       // 1/4  1/2
+    stage.obstacleHeightMin   = 30 + Scalar_ToInt(SCALAR_CONST(20.0f) * r);
+    stage.obstacleHeightRange = 50;
+    stage.obstacleLimit       = 3 + Scalar_ToInt(SCALAR_CONST(3.0f) * r);       // 3  5
+
+    // n܂Ƃ̕ו͋Ԃ̂Ŏg܂񂪁AXe[WƓlĂ܂
+    stage.startGroundMin      = 200;
+    stage.startGroundRange    = 100;
+    stage.firstObstacleX      = 100;
+    stage.obstacleGapMin      = 250;
+    stage.obstacleGapRange    = 150;
+}
+
+//=============================================================================
+//  Endless_GenerateChunk֐ - R[X̎ƋԂ̔ԍAԂ̒g܂
+//   (Xe[W̒nʂƓ܂ŁAnʂ̕EƂEǂɌ߂܂B
+//    ǂۂɒuǂ́AׂƂ obstacleLimit Č߂܂)
+//=============================================================================
+void Endless_GenerateChunk(unsigned long seed, unsigned long index, Chunk& chunk)
+{
+    int i;
+    Rng rng;
+    Rng_Seed(rng, seed, index);
+
+    chunk.seed = seed;
+    chunk.index = index;
+    Endless_Stage(index, chunk.stage);
+    const StageData& stage = chunk.stage;
+
+    for (i = 0; i < CHUNK_SEGMENTS; i++){
+        ChunkSegment& seg = chunk.segments[i];
+        seg.obstacleHeight = 0;
+        seg.obstacleOffset = 0;
+
+        if (index == 0 && i < ENDLESS_SAFE_SEGMENTS){
+            // X^[gn_́AXe[W̎n߂ƓȒnʂɂ܂
+            seg.isPit = 0;
+            seg.width = 200 + Rng_Range(rng, 100);
+        }else if (stage.pitChance > 0 && Rng_Range(rng, stage.pitChance) == 0){
+            seg.isPit = 1;
+            seg.width = stage.pitWidthMin + Rng_Range(rng, stage.pitWidthRange);
+        }else{
+            seg.isPit = 0;
+            seg.width = stage.groundWidthMin + Rng_Range(rng, stage.groundWidthRange);
+            if (stage.obstacleChance > 0 && Rng_Range(rng, stage.obstacleChance) == 0){
+                seg.obstacleHeight = stage.obstacleHeightMin + Rng_Range(rng, stage.obstacleHeightRange);
+                seg.obstacleOffset = Rng_Range(rng, seg.width - OBSTACLE_WIDTH);
+            }
+        }
+    }
+}
@@ -0,0 +1,28 @@
+//=============================================================================
+//
+//  wWXgWv DX5x GhX[h̃R[X
+//
+//  GhX[h̃R[X́An CHUNK_SEGMENTS ̋ (`N) 
+//  č܂BԂ̒ǵuR[X̎vƁuԂ̔ԍvŌ܂A
+//  Q[̏Ԃɂ͍E܂B̂߁Aʂ̃XbhŐɍĂĂ
+//  (chunkstream.h)ȀōĂA܂R[XɂȂ܂B
+//
+//  ͋Ԃ̔ԍƂƂɏオAENDLESS_RAMP_CHUNKS Ԗڂ
+//  ő̔܂ŁA̐͂ƍőɋ߂ÂĂ܂B
+//
+//=============================================================================
+#ifndef ENDLESS_H
+#define ENDLESS_H
+
+#include "sim.h"
+
+#define ENDLESS_RAMP_CHUNKS     20      // 傤ǔɂȂԂ̔ԍ
+#define ENDLESS_SAFE_SEGMENTS   3       // ŏ̋Ԃ́AǂȂnʂ̐ (X^[gn_)
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Endless_Stage(unsigned long index, StageData& stage);
+void Endless_GenerateChunk(unsigned long seed, unsigned long index, Chunk& chunk);
+
+#endif // ENDLESS_H
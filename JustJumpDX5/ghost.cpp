@@ -0,0 +1,635 @@
+//=============================================================================
+//
+//  wWXgWv DX5x S[Xg (ԗǂÃvC[ƂĈꏏɑ点܂)
+//
+//=============================================================================
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "ghost.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void          GhostRace_Start(GhostRace& race, const World& world);
+static void          GhostRace_Finish(GhostRace& race, bool cleared);
+static bool          GhostRace_IsBetter(const GhostRace& race, bool cleared);
+static bool          GhostReader_Map(GhostReader& reader, GhostView& view, unsigned long offset);
+static void          GhostReader_Unmap(GhostView& view);
+static bool          GhostReader_Byte(GhostReader& reader, GhostView& view, unsigned long offset, unsigned char& b);
+static unsigned long GhostReader_U32(GhostReader& reader, GhostView& view, unsigned long offset, bool& ok);
+static bool          GhostReader_Seek(GhostReader& reader, unsigned long block);
+static void          Ghost_PutVarint(GhostWriter& writer, unsigned long v);
+static void          Ghost_WriteU32(unsigned char* p, unsigned long v);
+static unsigned long Ghost_Mix(unsigned long n, int y, bool jumped);
+
+//=============================================================================
+//  ̋L^ƃS[Xg̓ǂݏo
+//=============================================================================
+//=============================================================================
+//  GhostRace_Init֐ - t@CutH_߂܂ (NULL Ȃ獡̃tH_)
+//   (record  false ȂAS[XgǂނŁA͋L^܂)
+//=============================================================================
+void GhostRace_Init(GhostRace& race, const char* dir, bool record)
+{
+    memset(&race, 0, sizeof(race));
+    race.record = record;
+    if (dir != NULL){
+        strncpy(race.dir, dir, sizeof(race.dir) - 1);
+    }
+}
+
+//=============================================================================
+//  GhostRace_Step֐ - 1t[i߂ɌĂт܂
+//   (̎n܂ƏIAL^āA̋ł̃S[Xg̎p race.pose ɓ܂)
+//=============================================================================
+void GhostRace_Step(GhostRace& race, const World& world)
+{
+    bool playing = world.gameState == STATE_PLAYING;
+
+    // ̏I (Xe[WNAEQ[I[o[E^Cgɖ߂) Ǝn܂
+    if (race.running && (!playing || world.currentStage != race.stage)){
+        GhostRace_Finish(race, world.gameState == STATE_STAGE_CLEAR || world.gameState == STATE_GAME_CLEAR);
+    }
+    if (!race.running && playing){
+        GhostRace_Start(race, world);
+    }
+    if (!race.running){
+        race.pose.visible = false;
+        return;
+    }
+
+    // i񂾋 (R[X̍W܂Ƃ߂Ă炵Ƃ́Ascroll  TRACK_REBASE_X ߂܂)
+    float delta = Scalar_ToFloat(world.scroll) - race.lastScroll;
+    if (delta < 0) delta += TRACK_REBASE_X;
+    race.distance += delta;
+    race.lastScroll = Scalar_ToFloat(world.scroll);
+
+    // 񂾂 (̑}ɑ̂́A񂾂Ƃł) ƁA~X̉
+    const Player& player = world.player;
+    float vy = Scalar_ToFloat(player.vy);
+    if (vy < 0 && vy < race.lastVy) race.jumpPending = true;
+    race.lastVy = vy;
+    if (player.state == PSTATE_MISS && race.lastPlayerState != PSTATE_MISS) race.misses++;
+    race.lastPlayerState = player.state;
+
+    // GHOST_STEP sNZiނƂɁAL^܂
+    unsigned long n = (unsigned long)(race.distance / GHOST_STEP);
+    if (race.writing){
+        int y = (int)(Scalar_ToFloat(player.y) + 0.5f);
+        while (race.samples <= n){
+            GhostWriter_Add(race.writer, y, race.jumpPending);
+            race.jumpPending = false;
+            race.samples++;
+        }
+    }
+
+    // ̏́AS[Xg̎p
+    int ghostY;
+    bool ghostJumped;
+    race.pose.visible = race.hasGhost && GhostReader_Sample(race.reader, n, ghostY, ghostJumped);
+    if (race.pose.visible){
+        race.pose.y = (float)ghostY;
+        race.pose.jumped = ghostJumped;
+    }
+}
+
+//=============================================================================
+//  GhostRace_Shutdown֐ - ȓ͎̂ĂāAt@C܂
+//=============================================================================
+void GhostRace_Shutdown(GhostRace& race)
+{
+    char path[GHOST_PATH_SIZE];
+
+    if (race.writing){
+        fclose(race.writer.fp);
+        race.writer.fp = NULL;
+        race.writing = false;
+        GhostRace_FileName(race, race.stage, race.endless, "tmp", path);
+        remove(path);
+    }
+    GhostReader_Close(race.reader);
+    race.running = false;
+    race.hasGhost = false;
+    race.pose.visible = false;
+}
+
+//=============================================================================
+//  GhostRace_FileName֐ - Xe[W̃S[Xg̃t@C path ɍ܂
+//   (path ɂ GHOST_PATH_SIZE oCgKvłBext ͊gq)
+//=============================================================================
+void GhostRace_FileName(const GhostRace& race, int stage, bool endless, const char* ext, char* path)
+{
+    char name[32];
+    if (endless){
+        sprintf(name, "ghost_endless.%.8s", ext);
+    }else{
+        sprintf(name, "ghost%02d.%.8s", stage + 1, ext);
+    }
+
+    if (race.dir[0] != '\0'){
+        sprintf(path, "%.200s/%s", race.dir, name);
+    }else{
+        strcpy(path, name);
+    }
+}
+
+//=============================================================================
+//  S[Xg̃t@Cǂ
+//=============================================================================
+//=============================================================================
+//  GhostReader_Open֐ - S[Xg̃t@CJāAwb_[m߂܂
+//   (ł̓wb_[̕ӂ肾蓖Ă܂Bg͓ǂނƂɁA̕ӂ肾蓖Ă܂B
+//    stageHash ƈႤXe[W\ŋL^S[XǵAR[XႤ̂ŊJ܂)
+//=============================================================================
+bool GhostReader_Open(GhostReader& reader, const char* path, unsigned long stageHash)
+{
+    unsigned long size = 0;
+
+    memset(&reader, 0, sizeof(reader));
+    reader.sample = -1;
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE){
+        return false;
+    }
+    size = GetFileSize(hFile, NULL);
+    if (size != 0xFFFFFFFF && size >= GHOST_HEADER_SIZE){
+        reader.mapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(hFile);             // 蓖 (mapping) ܂ł́At@C͊J܂܂ł
+    if (reader.mapping == NULL){
+        return false;
+    }
+#else
+    struct stat st;
+    reader.fd = open(path, O_RDONLY);
+    if (reader.fd < 0){
+        return false;
+    }
+    if (fstat(reader.fd, &st) != 0 || st.st_size < GHOST_HEADER_SIZE){
+        close(reader.fd);
+        return false;
+    }
+    size = (unsigned long)st.st_size;
+#endif
+    reader.open = true;
+    reader.fileSize = size;
+
+    // wb_[m߂܂
+    bool ok = true;
+    unsigned char magic[4];
+    int i;
+    for (i = 0; i < 4 && ok; i++){
+        ok = GhostReader_Byte(reader, reader.data, i, magic[i]);
+    }
+    ok = ok && memcmp(magic, "JJGH", 4) == 0
+            && GhostReader_U32(reader, reader.data, 4, ok) == GHOST_VERSION
+            && GhostReader_U32(reader, reader.data, 8, ok) == SIM_VERSION
+            && GhostReader_U32(reader, reader.data, 28, ok) == GHOST_STEP;
+    if (ok){
+        reader.stage       = GhostReader_U32(reader, reader.data, 12, ok);
+        reader.flags       = GhostReader_U32(reader, reader.data, 16, ok);
+        reader.misses      = GhostReader_U32(reader, reader.data, 20, ok);
+        reader.sampleCount = GhostReader_U32(reader, reader.data, 24, ok);
+        reader.indexOffset = GhostReader_U32(reader, reader.data, 32, ok);
+        reader.blockCount  = GhostReader_U32(reader, reader.data, 36, ok);
+        reader.checksum    = GhostReader_U32(reader, reader.data, 40, ok);
+        reader.stageHash   = GhostReader_U32(reader, reader.data, 44, ok);
+    }
+    ok = ok && reader.stageHash == (stageHash & 0xFFFFFFFFUL)
+            && reader.blockCount <= GHOST_MAX_BLOCKS
+            && reader.blockCount == (reader.sampleCount + GHOST_BLOCK_SAMPLES - 1) / GHOST_BLOCK_SAMPLES
+            && reader.indexOffset >= GHOST_HEADER_SIZE
+            && reader.indexOffset + reader.blockCount * 8 == reader.fileSize;
+    if (!ok){
+        GhostReader_Close(reader);
+        return false;
+    }
+    return true;
+}
+
+//=============================================================================
+//  GhostReader_Sample֐ - n Ԗڂ̃Tv (ƁAŒ񂾂) ǂ݂܂
+//   (Oɓǂ񂾃Tv̏ȂAǂ݂܂B߂Ƃ≓֔ԂƂ́Aǂݎn߂܂)
+//=============================================================================
+bool GhostReader_Sample(GhostReader& reader, unsigned long n, int& y, bool& jumped)
+{
+    if (!reader.open || n >= reader.sampleCount){
+        return false;
+    }
+
+    if (reader.sample < 0 || (long)n < reader.sample || n / GHOST_BLOCK_SAMPLES != (unsigned long)(reader.sample + 1) / GHOST_BLOCK_SAMPLES){
+        if (!GhostReader_Seek(reader, n / GHOST_BLOCK_SAMPLES)){
+            return false;
+        }
+    }
+
+    while (reader.sample < (long)n){
+        unsigned long token = 0;
+        int shift = 0;
+        unsigned char b;
+        do {
+            if (!GhostReader_Byte(reader, reader.data, reader.pos++, b) || shift > 28){
+                return false;
+            }
+            token |= (unsigned long)(b & 0x7F) << shift;
+            shift += 7;
+        } while (b & 0x80);
+
+        // WOUO (0, -1, 1, -2, 2, ...  0, 1, 2, 3, 4, ... ŕ\) ɖ߂܂
+        unsigned long zz = token >> 1;
+        int dy = (zz & 1) ? -(int)((zz + 1) >> 1) : (int)(zz >> 1);
+        reader.y += dy;
+        reader.jumped = (token & 1) != 0;
+        reader.sample++;
+    }
+
+    y = reader.y;
+    jumped = reader.jumped;
+    return true;
+}
+
+//=============================================================================
+//  GhostReader_Close֐ - 蓖ĂāAt@C܂
+//=============================================================================
+void GhostReader_Close(GhostReader& reader)
+{
+    if (reader.open){
+        GhostReader_Unmap(reader.data);
+        GhostReader_Unmap(reader.index);
+#ifdef _WIN32
+        CloseHandle((HANDLE)reader.mapping);
+#else
+        close(reader.fd);
+#endif
+    }
+    memset(&reader, 0, sizeof(reader));
+    reader.sample = -1;
+}
+
+//=============================================================================
+//  Ghost_Verify֐ - S[Xg̃t@CSǂŁAĂȂm߂܂ (wbhXł̊mFp)
+//   (擪珇ɓǂ񂾏ꍇƁAgČ̋؂肩ǂ񂾏ꍇ̗ŁA
+//    mߗp̒lwb_[ƈv邩𒲂ׂ܂)
+//=============================================================================
+bool Ghost_Verify(const char* path, unsigned long stageHash, unsigned long* samples, unsigned long* remaps)
+{
+    GhostReader reader;
+    unsigned long n, b, sum = 0;
+    int y;
+    bool jumped;
+
+    if (!GhostReader_Open(reader, path, stageHash)){
+        return false;
+    }
+
+    bool ok = true;
+    for (n = 0; ok && n < reader.sampleCount; n++){
+        ok = GhostReader_Sample(reader, n, y, jumped);
+        sum = (sum + Ghost_Mix(n, y, jumped)) & 0xFFFFFFFF;
+    }
+    ok = ok && sum == reader.checksum;
+
+    sum = 0;
+    for (b = reader.blockCount; ok && b-- > 0; ){
+        for (n = b * GHOST_BLOCK_SAMPLES; ok && n < reader.sampleCount && n < (b + 1) * GHOST_BLOCK_SAMPLES; n++){
+            ok = GhostReader_Sample(reader, n, y, jumped);
+            sum = (sum + Ghost_Mix(n, y, jumped)) & 0xFFFFFFFF;
+        }
+    }
+    ok = ok && sum == reader.checksum;
+
+    if (samples != NULL) *samples = reader.sampleCount;
+    if (remaps != NULL)  *remaps = reader.remaps;
+    GhostReader_Close(reader);
+    return ok;
+}
+
+//=============================================================================
+//  S[Xg̃t@C
+//=============================================================================
+//=============================================================================
+//  GhostWriter_Begin֐ - n߂܂ (y ͑n߂̍)
+//=============================================================================
+bool GhostWriter_Begin(GhostWriter& writer, const char* path, int y)
+{
+    unsigned char header[GHOST_HEADER_SIZE];
+
+    writer.fp = fopen(path, "wb");
+    if (writer.fp == NULL){
+        return false;
+    }
+
+    // wb_[͍Ōɏ̂ŁAł͏ꏊƂĂ܂
+    memset(header, 0, sizeof(header));
+    fwrite(header, 1, sizeof(header), writer.fp);
+    writer.size = GHOST_HEADER_SIZE;
+    writer.sampleCount = 0;
+    writer.y = y;
+    writer.checksum = 0;
+    writer.blockCount = 0;
+    return true;
+}
+
+//=============================================================================
+//  GhostWriter_Add֐ - Tv1܂
+//   (ςɂȂA̐͏܂)
+//=============================================================================
+void GhostWriter_Add(GhostWriter& writer, int y, bool jumped)
+{
+    if (writer.sampleCount % GHOST_BLOCK_SAMPLES == 0){
+        if (writer.blockCount >= GHOST_MAX_BLOCKS){
+            return;
+        }
+        writer.blockOffset[writer.blockCount] = writer.size;
+        writer.blockY[writer.blockCount] = writer.y;
+        writer.blockCount++;
+    }
+
+    int dy = y - writer.y;
+    unsigned long zz = dy < 0 ? ((unsigned long)(-dy) << 1) - 1 : (unsigned long)dy << 1;
+    Ghost_PutVarint(writer, (zz << 1) | (jumped ? 1 : 0));
+    writer.checksum = (writer.checksum + Ghost_Mix(writer.sampleCount, y, jumped)) & 0xFFFFFFFF;
+    writer.y = y;
+    writer.sampleCount++;
+}
+
+//=============================================================================
+//  GhostWriter_End֐ - ƃwb_[āAt@C܂ (Ȃ false)
+//=============================================================================
+bool GhostWriter_End(GhostWriter& writer, int stage, unsigned long flags, unsigned long misses, unsigned long stageHash)
+{
+    unsigned char header[GHOST_HEADER_SIZE];
+    unsigned char entry[8];
+    unsigned long b;
+
+    if (writer.fp == NULL){
+        return false;
+    }
+
+    unsigned long indexOffset = writer.size;
+    for (b = 0; b < writer.blockCount; b++){
+        Ghost_WriteU32(entry, writer.blockOffset[b]);
+        Ghost_WriteU32(entry + 4, (unsigned long)writer.blockY[b]);
+        fwrite(entry, 1, sizeof(entry), writer.fp);
+    }
+
+    memcpy(header, "JJGH", 4);
+    Ghost_WriteU32(header + 4,  GHOST_VERSION);
+    Ghost_WriteU32(header + 8,  SIM_VERSION);
+    Ghost_WriteU32(header + 12, (unsigned long)stage);
+    Ghost_WriteU32(header + 16, flags);
+    Ghost_WriteU32(header + 20, misses);
+    Ghost_WriteU32(header + 24, writer.sampleCount);
+    Ghost_WriteU32(header + 28, GHOST_STEP);
+    Ghost_WriteU32(header + 32, indexOffset);
+    Ghost_WriteU32(header + 36, writer.blockCount);
+    Ghost_WriteU32(header + 40, writer.checksum);
+    Ghost_WriteU32(header + 44, stageHash);
+
+    bool ok = fseek(writer.fp, 0, SEEK_SET) == 0 && fwrite(header, 1, sizeof(header), writer.fp) == sizeof(header);
+    ok = !ferror(writer.fp) && ok;
+    ok = (fclose(writer.fp) == 0) && ok;
+    writer.fp = NULL;
+    return ok;
+}
+
+//=============================================================================
+//  `
+//=============================================================================
+//=============================================================================
+//  Ghost_Interpolate֐ - Õt[ƍ̃t[̊Ԃ̃S[Xg̎p܂
+//=============================================================================
+GhostPose Ghost_Interpolate(const GhostPose& prev, const GhostPose& cur, float alpha)
+{
+    GhostPose pose = cur;
+    if (prev.visible && cur.visible){
+        pose.y = prev.y + (cur.y - prev.y) * alpha;
+    }
+    return pose;
+}
+
+//=============================================================================
+//  Ghost_Draw֐ - S[XgAvC[Ɠʒuɔŕ`܂
+//   (񂾏ł́AɈt܂)
+//=============================================================================
+void Ghost_Draw(RenderList& list, const World& world, const GhostPose& pose)
+{
+    if (world.gameState != STATE_PLAYING || !pose.visible){
+        return;
+    }
+
+    int x = Scalar_ToInt(world.player.x);
+    int y = (int)pose.y;
+    Render_BlendRect(list, x, y, PLAYER_SIZE, PLAYER_SIZE, 255, 255, 255);
+    if (pose.jumped){
+        Render_BlendRect(list, x - 4, y + PLAYER_SIZE, PLAYER_SIZE + 8, 3, 255, 255, 255);
+    }
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// n߂܂BXe[W̃S[XgΊJAL^Ȃꎞt@Cɏn߂܂
+static void GhostRace_Start(GhostRace& race, const World& world)
+{
+    char path[GHOST_PATH_SIZE];
+
+    race.running = true;
+    race.stage = world.currentStage;
+    race.endless = world.endless;
+    race.stageHash = Sim_StageHash(world.stages, world.stageCount);
+    race.distance = 0;
+    race.lastScroll = Scalar_ToFloat(world.scroll);
+    race.lastVy = Scalar_ToFloat(world.player.vy);
+    race.jumpPending = false;
+    race.samples = 0;
+    race.misses = 0;
+    race.lastPlayerState = world.player.state;
+
+    GhostRace_FileName(race, race.stage, race.endless, "jjg", path);
+    race.hasGhost = GhostReader_Open(race.reader, path, race.stageHash);
+
+    if (race.record){
+        GhostRace_FileName(race, race.stage, race.endless, "tmp", path);
+        race.writing = GhostWriter_Begin(race.writer, path, (int)(Scalar_ToFloat(world.player.y) + 0.5f));
+    }
+}
+
+// I܂B܂ł̃S[Xgǂ΁Aꎞt@CŃS[Xg̃t@Cu܂
+static void GhostRace_Finish(GhostRace& race, bool cleared)
+{
+    char path[GHOST_PATH_SIZE], tmpPath[GHOST_PATH_SIZE];
+
+    GhostRace_FileName(race, race.stage, race.endless, "jjg", path);
+    GhostRace_FileName(race, race.stage, race.endless, "tmp", tmpPath);
+
+    if (race.writing){
+        unsigned long flags = (cleared ? GHOST_FLAG_CLEARED : 0) | (race.endless ? GHOST_FLAG_ENDLESS : 0);
+        bool better = GhostRace_IsBetter(race, cleared);
+        bool ok = GhostWriter_End(race.writer, race.endless ? 0 : race.stage, flags, race.misses, race.stageHash);
+        race.writing = false;
+        race.runs++;
+
+        // 蓖Ă܂܂̃t@C͒uȂ̂ŁAɕ܂
+        GhostReader_Close(race.reader);
+        if (ok && better){
+            remove(path);
+            ok = rename(tmpPath, path) == 0;
+            if (ok) race.bests++;
+        }
+        if (!ok || !better){
+            remove(tmpPath);
+        }
+    }
+
+    GhostReader_Close(race.reader);
+    race.hasGhost = false;
+    race.running = false;
+    race.pose.visible = false;
+}
+
+// ̑肪A܂ł̃S[Xgǂ
+// (NA肪DBǂNA~X̏ȂAǂNAĂȂΉ܂Ői񂾕)
+static bool GhostRace_IsBetter(const GhostRace& race, bool cleared)
+{
+    if (!race.hasGhost){
+        return race.writer.sampleCount > 0;
+    }
+
+    bool bestCleared = (race.reader.flags & GHOST_FLAG_CLEARED) != 0;
+    if (cleared != bestCleared){
+        return cleared;
+    }
+    if (cleared){
+        return race.misses < race.reader.misses;
+    }
+    return race.writer.sampleCount > race.reader.sampleCount;
+}
+
+// offset ܂ޕӂ蓖Ă܂ (OɊ蓖ĂĂ͉܂)
+static bool GhostReader_Map(GhostReader& reader, GhostView& view, unsigned long offset)
+{
+    unsigned long base = offset - offset % GHOST_VIEW_ALIGN;
+    unsigned long size = reader.fileSize - base;
+    if (size > GHOST_VIEW_SIZE) size = GHOST_VIEW_SIZE;
+
+    GhostReader_Unmap(view);
+#ifdef _WIN32
+    view.base = (const unsigned char*)MapViewOfFile((HANDLE)reader.mapping, FILE_MAP_READ, 0, base, size);
+#else
+    void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, reader.fd, (off_t)base);
+    view.base = (p != MAP_FAILED) ? (const unsigned char*)p : NULL;
+#endif
+    if (view.base == NULL){
+        return false;
+    }
+    view.offset = base;
+    view.size = size;
+    reader.remaps++;
+    return true;
+}
+
+static void GhostReader_Unmap(GhostView& view)
+{
+    if (view.base != NULL){
+#ifdef _WIN32
+        UnmapViewOfFile(view.base);
+#else
+        munmap((void*)view.base, view.size);
+#endif
+    }
+    view.base = NULL;
+    view.offset = 0;
+    view.size = 0;
+}
+
+// t@C offset ̈ʒu1oCgǂ݂܂ (蓖Ă̊OȂA蓖Ē܂)
+static bool GhostReader_Byte(GhostReader& reader, GhostView& view, unsigned long offset, unsigned char& b)
+{
+    if (offset >= reader.fileSize){
+        return false;
+    }
+    if (view.base == NULL || offset < view.offset || offset >= view.offset + view.size){
+        if (!GhostReader_Map(reader, view, offset)){
+            return false;
+        }
+    }
+    b = view.base[offset - view.offset];
+    return true;
+}
+
+static unsigned long GhostReader_U32(GhostReader& reader, GhostView& view, unsigned long offset, bool& ok)
+{
+    unsigned long v = 0;
+    unsigned char b;
+    int i;
+    for (i = 0; i < 4; i++){
+        if (!GhostReader_Byte(reader, view, offset + i, b)){
+            ok = false;
+            return 0;
+        }
+        v |= (unsigned long)b << (8 * i);
+    }
+    return v;
+}
+
+// block Ԗڂ̋؂̒Oǂ߂悤ɂ܂ (Af[^̈ʒuƂ̎_̍ǂ݂܂)
+static bool GhostReader_Seek(GhostReader& reader, unsigned long block)
+{
+    bool ok = true;
+    unsigned long entry = reader.indexOffset + block * 8;
+    unsigned long pos = GhostReader_U32(reader, reader.index, entry, ok);
+    unsigned long y = GhostReader_U32(reader, reader.index, entry + 4, ok);
+    if (!ok || pos < GHOST_HEADER_SIZE || pos >= reader.indexOffset){
+        return false;
+    }
+
+    reader.pos = pos;
+    reader.y = (y & 0x80000000) ? -(int)(((~y) & 0x7FFFFFFF) + 1) : (int)y;     // ̍ (ʂ) ܂
+    reader.sample = (long)(block * GHOST_BLOCK_SAMPLES) - 1;
+    reader.jumped = false;
+    return true;
+}
+
+// 7rbgǍ珑܂ (Έԏ̃rbg𗧂Ă܂)
+static void Ghost_PutVarint(GhostWriter& writer, unsigned long v)
+{
+    while (v >= 0x80){
+        fputc((int)((v & 0x7F) | 0x80), writer.fp);
+        writer.size++;
+        v >>= 7;
+    }
+    fputc((int)v, writer.fp);
+    writer.size++;
+}
+
+static void Ghost_WriteU32(unsigned char* p, unsigned long v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)((v >> 8) & 0xFF);
+    p[2] = (unsigned char)((v >> 16) & 0xFF);
+    p[3] = (unsigned char)((v >> 24) & 0xFF);
+}
+
+// mߗp̒l1Tv (Tv̔ԍ̂ŁAԂςĂlɂȂ܂)
+static unsigned long Ghost_Mix(unsigned long n, int y, bool jumped)
+{
+    unsigned long h = ((n * 2654435761UL) ^ (((unsigned long)y & 0xFFFF) << 1) ^ (jumped ? 1 : 0)) & 0xFFFFFFFF;
+    h ^= h >> 15;
+    h = (h * 2246822519UL) & 0xFFFFFFFF;
+    h ^= h >> 13;
+    return h;
+}
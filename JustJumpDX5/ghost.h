@@ -0,0 +1,164 @@
+//=============================================================================
+//
+//  wWXgWv DX5x S[Xg (ԗǂÃvC[ƂĈꏏɑ点܂)
+//
+//  Xe[W (GhX[h1) ɁAԗǂ̋OՂt@CɎc܂B
+//  OՂ́AR[X GHOST_STEP sNZiނƂ̃vC[̍ (1sNZP) ƁA
+//  Œ񂾂ǂłBO̍Ƃ̍ϒŕׂ̂ŁAقƂ1Tv1oCgłB
+//
+//  t@C͓ǂݍ܂ɃɊ蓖Ă (}bv) g܂A蓖Ă̂
+//  Ăӂ GHOST_VIEW_SIZE oCgłB֐i񂾂犄蓖Ē̂ŁA
+//  GhX[hŉԂt@CłASɒuƂ͂܂B
+//  ǂłǂݎn߂悤ɁAGHOST_BLOCK_SAMPLES TvƂɁA
+//  t@C̈ʒuƂ̎_̍\ () ɂāAt@C̍ŌɕtĂ܂B
+//
+//  t@C` (lׂ͂ăgGfBA):
+//    "JJGH"            4oCg  ڈ
+//    o[W        4oCg  GHOST_VERSION
+//    Q[̃o[W 4oCg  SIM_VERSION
+//    Xe[W̔ԍ    4oCg  (0 BGhX[h 0)
+//                  4oCg  GHOST_FLAG_`
+//    ~X̉        4oCg
+//    Tv        4oCg
+//    Tv̊Ԋu    4oCg  GHOST_STEP (sNZ)
+//    ̈ʒu        4oCg  t@C̐擪
+//    ̐          4oCg
+//    mߗp̒l      4oCg  STvl (Ghost_Verify Ŏg܂)
+//    Xe[W\        4oCg  Sim_StageHash (ႤXe[W\ŋL^S[Xg͓ǂ݂܂)
+//    f[^            ϒ   (̍̃WOUO << 1 | 񂾂) ϒŕׂ
+//                  8oCg ~ ̐  (f[^̈ʒu, ̋؂̒O̍)
+//
+//  g (Q[i߂Xbh):
+//    GhostRace_Init(race, NULL, true);
+//    Sim_Step(world, input);
+//    GhostRace_Step(race, world);                  // ̎n܂ƏIāAL^Ɠǂݏo܂
+//    Ghost_Draw(list, world, race.pose);           // `Ƃ (Render_World ̌)
+//    GhostRace_Shutdown(race);
+//
+//=============================================================================
+#ifndef GHOST_H
+#define GHOST_H
+
+#include <stdio.h>
+#include "sim.h"
+#include "render.h"
+
+#define GHOST_VERSION           2
+#define GHOST_STEP              4           // sNZiނƂɍL^邩
+#define GHOST_BLOCK_SAMPLES     256         // tԊu (Tv)
+#define GHOST_MAX_BLOCKS        8192        // L^ł̐ (840sNZBGhX[h6Ԉȏ)
+#define GHOST_VIEW_ALIGN        65536       // 蓖Ăʒu̒P (Windows ̊蓖Ă̒Pʂɍ킹܂)
+#define GHOST_VIEW_SIZE         (2 * GHOST_VIEW_ALIGN)  // xɊ蓖Ă傫
+#define GHOST_HEADER_SIZE       48
+#define GHOST_PATH_SIZE         260         // t@C鏊̑傫
+
+// 
+#define GHOST_FLAG_CLEARED      0x01        // Xe[WNA
+#define GHOST_FLAG_ENDLESS      0x02        // GhX[h̑
+
+// S[Xg̍̎p (`̂Ɏg܂)
+struct GhostPose
+{
+    bool  visible;          // false Ȃ`܂ (S[XgȂES[Xg̑͂I)
+    float y;                // vC[̏[̍
+    bool  jumped;           // Œ
+};
+
+// t@C̈ꕔ蓖Ă
+struct GhostView
+{
+    const unsigned char* base;
+    unsigned long        offset;    // base t@Ĉǂ
+    unsigned long        size;
+};
+
+// S[Xg̃t@CǂތW
+struct GhostReader
+{
+#ifdef _WIN32
+    void*         mapping;          // t@C̊蓖 (HANDLE)
+#else
+    int           fd;
+#endif
+    bool          open;
+    unsigned long fileSize;
+
+    unsigned long stage, flags, misses;
+    unsigned long sampleCount;
+    unsigned long indexOffset, blockCount;
+    unsigned long checksum;
+    unsigned long stageHash;
+
+    GhostView     data;             // f[^́Aǂłӂ
+    GhostView     index;            // ́Aǂłӂ
+    unsigned long remaps;           // 蓖Ē
+
+    // Ōɓǂ񂾃Tv
+    long          sample;           // -1 Ȃ܂ǂł܂
+    unsigned long pos;              // ̃Tṽt@C̈ʒu
+    int           y;
+    bool          jumped;
+};
+
+// S[Xg̃t@CW (Ȃt@CɏoĂ̂ŁAĂ͑܂)
+struct GhostWriter
+{
+    FILE*         fp;
+    unsigned long size;             // ܂łɏ傫
+    unsigned long sampleCount;
+    int           y;                // ŌɏTv̍
+    unsigned long checksum;
+    unsigned long blockCount;
+    unsigned long blockOffset[GHOST_MAX_BLOCKS];
+    int           blockY[GHOST_MAX_BLOCKS];
+};
+
+// ̑L^ȂAԗǂ̃S[XgǂތW
+struct GhostRace
+{
+    bool          record;           // false ȂǂނŁAL^܂ (vC̍ĐȂ)
+    char          dir[200];         // t@CutH_ (Ȃ獡̃tH_)
+
+    bool          running;          // ̓r
+    int           stage;
+    bool          endless;
+    unsigned long stageHash;        // ̑̃Xe[W\̃nbVl (Sim_StageHash)
+    float         distance;         // ̑Ői񂾋 (sNZ)
+    float         lastScroll;
+    float         lastVy;
+    bool          jumpPending;      // 񂾂ƂÃTvɏ܂
+    unsigned long samples;          // ̑ŋL^Tv
+    unsigned long misses;
+    PlayerState   lastPlayerState;
+
+    bool          hasGhost;         // S[Xg̃t@CJ
+    GhostReader   reader;
+    GhostWriter   writer;
+    bool          writing;
+    GhostPose     pose;             // ̋ł̃S[Xg̎p
+
+    unsigned long runs;             // L^̐
+    unsigned long bests;            // ԗǂ
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void      GhostRace_Init(GhostRace& race, const char* dir, bool record);
+void      GhostRace_Step(GhostRace& race, const World& world);
+void      GhostRace_Shutdown(GhostRace& race);
+void      GhostRace_FileName(const GhostRace& race, int stage, bool endless, const char* ext, char* path);
+
+bool      GhostReader_Open(GhostReader& reader, const char* path, unsigned long stageHash);
+bool      GhostReader_Sample(GhostReader& reader, unsigned long n, int& y, bool& jumped);
+void      GhostReader_Close(GhostReader& reader);
+bool      Ghost_Verify(const char* path, unsigned long stageHash, unsigned long* samples, unsigned long* remaps);
+
+bool      GhostWriter_Begin(GhostWriter& writer, const char* path, int y);
+void      GhostWriter_Add(GhostWriter& writer, int y, bool jumped);
+bool      GhostWriter_End(GhostWriter& writer, int stage, unsigned long flags, unsigned long misses, unsigned long stageHash);
+
+GhostPose Ghost_Interpolate(const GhostPose& prev, const GhostPose& cur, float alpha);
+void      Ghost_Draw(RenderList& list, const World& world, const GhostPose& pose);
+
+#endif // GHOST_H
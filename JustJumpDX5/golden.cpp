@@ -0,0 +1,521 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ʂׂ̌Ƒ (Linuxp)
+//
+//  ܂ƌ܂͂ŃQ[i߁A^CgEvCEXe[WNAE
+//  Q[I[o[EQ[NAȂǂ̏ʂẢ (t[obt@) ɕ`܂B
+//  `ʂƃQ[̏Ԃ̃nbVA (golden.txt) ƌׂāA
+//  1sNZłႦΒm点܂B`Q[WbN𑬂CƂA
+//  ڂ⓮ςĂȂƂm߂̂Ɏg܂B
+//
+//  -bench tƁA1t[́uQ[i߂鎞ԁvƁuʂƂ̕`ԁv
+//  ܂BǂAw肵 (-min-time) 𒴂܂ŉ񐔂{ɂȂ炭ԂA
+//  1񂠂̎Ԃ\܂B
+//
+//  g:
+//    ./jjgolden [-golden golden.txt] [-update] [-dump fBNg]
+//               [-bench] [-filter ] [-min-time b]
+//
+//    -golden    ̃t@C (w肵Ȃ golden.txtBmake FIXED=1 ŃrhƂ golden_fixed.txt)
+//    -update    ׂɁǍʂŐ̃t@C蒼܂
+//               (ڂςCƂgĂ)
+//    -dump      ʂƂ̉ʂ fBNg/O.ppm ɕۑ܂
+//    -bench     ׂ̑ɑ𑪂܂
+//    -filter    Oɂ̕܂ޏ (܂͑) s܂
+//    -min-time  1ɎgŒZ̎ (bBw肵Ȃ 0.5)
+//
+//  ͑gݍ݂̉ptHgŕ`̂ŁAglyphs.jja ȂĂʂɂȂ܂B
+//  ႢIR[h 1 ŏI܂B
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+#include "render.h"
+#include "policy.h"
+#include "text.h"
+#include "hud.h"
+
+//-----------------------------------------------------------------------------
+//  ݒl
+//-----------------------------------------------------------------------------
+// Œ菬_ (scalar.h) ͓Ⴄ̂ŁAʂ̃t@Cł
+#ifdef JJ_FIXED_POINT
+#define GOLDEN_FILE_NAME    "golden_fixed.txt"
+#else
+#define GOLDEN_FILE_NAME    "golden.txt"
+#endif
+#define MAX_GOLDEN_FRAMES   500000      // ʂTƂɐi߂ő̃t[
+#define BENCH_SIM_FRAMES    65536       // Q[i߂鑬ׂŁAɍĂ͂̃t[
+
+// ʂǂŎ~߂邩
+enum GoldenStop{
+    STOP_FRAME,             // frames t[i߂Ƃ
+    STOP_AIRBORNE,          // vC[ŏɃWvāAԍɗƂ
+    STOP_MISS,              // ŏɃ~XƂ
+    STOP_STAGE_CLEAR,       // ŏɃXe[WNAƂ
+    STOP_GAME_CLEAR,        // SXe[WNAƂ
+    STOP_GAMEOVER           // Q[I[o[ɂȂƂ
+};
+
+// 1̍
+struct GoldenCase
+{
+    const char*   name;
+    unsigned long seed;
+    Policy        policy;
+    bool          endless;      // GhX[hŗVԂ
+    bool          easy;         // s_EasyStages ŗVԂ (Q[NẢʂo)
+    GoldenStop    stop;
+    unsigned long frames;       // STOP_FRAME ̂Ƃ̃t[
+    float         alpha;        // 0 傫΁A1Õt[Ƃ̊ԂԂԂ`܂
+};
+
+// Q[NA܂ŎvCœ͂悤ɁAǂႭėƂ̂ȂZXe[Wׂ܂
+static const StageData s_EasyStages[] = {
+    // speed  clear  pit  pitW pitR  grdW grdR  wall wallH wallR walls  stW  stR  1st  gap gapR
+    { -4.0f,   30,    0,  65,  35,  100, 200,   3,   20,   10,   3,   200, 100, 100, 250, 150 },
+    { -5.0f,   30,    0,  65,  35,  100, 200,   3,   20,   10,   3,   200, 100, 100, 250, 150 },
+    { -6.0f,   30,    0,  65,  35,  100, 200,   3,   20,   10,   3,   200, 100, 100, 250, 150 },
+};
+#define EASY_STAGE_COUNT    ((int)(sizeof(s_EasyStages) / sizeof(s_EasyStages[0])))
+
+static const GoldenCase s_Cases[] = {
+    { "title",          1, POLICY_IDLE,   false, false, STOP_FRAME,       0,    0.0f },
+    { "playing-start",  1, POLICY_AUTO,   false, false, STOP_FRAME,       10,   0.0f },
+    { "playing",        1, POLICY_AUTO,   false, false, STOP_FRAME,       900,  0.0f },
+    { "playing-lerp",   1, POLICY_AUTO,   false, false, STOP_FRAME,       900,  0.5f },
+    { "jump",           2, POLICY_AUTO,   false, false, STOP_AIRBORNE,    0,    0.0f },
+    { "miss",           3, POLICY_RANDOM, false, false, STOP_MISS,        0,    0.0f },
+    { "stage-clear",    1, POLICY_AUTO,   false, false, STOP_STAGE_CLEAR, 0,    0.0f },
+    { "game-over",      4, POLICY_IDLE,   false, false, STOP_GAMEOVER,    0,    0.0f },
+    { "game-clear",     5, POLICY_AUTO,   false, true,  STOP_GAME_CLEAR,  0,    0.0f },
+    { "endless",        6, POLICY_AUTO,   true,  false, STOP_FRAME,       3000, 0.0f },
+    { "endless-over",   7, POLICY_IDLE,   true,  false, STOP_GAMEOVER,    0,    0.0f },
+};
+#define GOLDEN_CASE_COUNT   ((int)(sizeof(s_Cases) / sizeof(s_Cases[0])))
+
+// ̃t@C1s
+struct GoldenEntry
+{
+    char          name[32];
+    unsigned long frame;        // t[ڂ̉ʂ
+    unsigned long simHash;      // Q[̏Ԃ̃nbV (Sim_Hash)
+    unsigned long pixelHash;    // ʂ̃nbV
+};
+
+//-----------------------------------------------------------------------------
+//  `Ɏg (ǂ̏ʂłg񂵂܂)
+//-----------------------------------------------------------------------------
+static RenderList   s_List;
+static GlyphAtlas   s_Font;
+static Hud          s_Hud;
+static unsigned int s_Pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+static Framebuffer  s_Fb;
+
+//=============================================================================
+//  Golden_Seconds֐ - vp̎v (b)
+//=============================================================================
+static double Golden_Seconds()
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+//=============================================================================
+//  Golden_Matches֐ - O -filter ̕܂ނ (filter  NULL ȂS)
+//=============================================================================
+static bool Golden_Matches(const char* name, const char* filter)
+{
+    return filter == NULL || strstr(name, filter) != NULL;
+}
+
+//=============================================================================
+//  Golden_Reached֐ - ʂ̎~߂鏊ɗ
+//=============================================================================
+static bool Golden_Reached(const GoldenCase& c, const World& prev, const World& world, unsigned long frame)
+{
+    switch (c.stop){
+        case STOP_FRAME:        return frame >= c.frames;
+        case STOP_AIRBORNE:     return world.gameState == STATE_PLAYING && !world.player.onGround && prev.player.vy < Scalar_FromInt(0) && world.player.vy >= Scalar_FromInt(0);
+        case STOP_MISS:         return world.gameState == STATE_PLAYING && world.player.state == PSTATE_MISS;
+        case STOP_STAGE_CLEAR:  return world.gameState == STATE_STAGE_CLEAR;
+        case STOP_GAME_CLEAR:   return world.gameState == STATE_GAME_CLEAR;
+        case STOP_GAMEOVER:     return world.gameState == STATE_GAMEOVER;
+    }
+    return true;
+}
+
+//=============================================================================
+//  Golden_Run֐ - ʂ̏܂ŃQ[i߂āA`Ԃ out ɍ܂
+//   (Ȃ falseBframe ɂ͐i߂t[܂)
+//=============================================================================
+static bool Golden_Run(const GoldenCase& c, World& out, unsigned long& frame)
+{
+    static World world, prev;
+    PolicyState policy;
+
+    Policy_Init(policy, c.policy, c.seed);
+    if (c.easy){
+        Sim_Init(world, c.seed, s_EasyStages, EASY_STAGE_COUNT);
+    }else{
+        Sim_Init(world, c.seed, NULL, 0);
+    }
+    Sim_SetEndless(world, c.endless);
+    prev = world;
+
+    for (frame = 0; !Golden_Reached(c, prev, world, frame); frame++){
+        if (frame >= MAX_GOLDEN_FRAMES){
+            return false;
+        }
+        prev = world;
+        Sim_Step(world, Policy_Choose(policy, world, frame));
+    }
+
+    if (c.alpha > 0.0f){
+        Sim_Interpolate(prev, world, c.alpha, out);
+    }else{
+        out = world;
+    }
+    return true;
+}
+
+//=============================================================================
+//  Golden_Draw֐ - Ԃ1t[AʑŜɕ`܂
+//=============================================================================
+static void Golden_Draw(const World& world)
+{
+    Render_Begin(s_List);
+    Render_World(s_List, world);
+    Hud_Build(s_Hud, s_List, world);
+    Render_Flush(s_List, s_Fb, &s_Font);
+}
+
+//=============================================================================
+//  Golden_PixelHash֐ - ʂ̃nbV (FNV-1aBF 0x00RRGGBB ̃oCg珇ɍ܂)
+//=============================================================================
+static unsigned long Golden_PixelHash(const Framebuffer& fb)
+{
+    unsigned long h = 2166136261UL;
+    int x, y, k;
+
+    for (y = 0; y < fb.height; y++){
+        const unsigned int* row = fb.pixels + y * fb.pitch;
+        for (x = 0; x < fb.width; x++){
+            unsigned int c = row[x] & 0x00FFFFFF;
+            for (k = 0; k < 3; k++){
+                h = ((h ^ (c & 0xFF)) * 16777619UL) & 0xFFFFFFFFUL;
+                c >>= 8;
+            }
+        }
+    }
+    return h;
+}
+
+//=============================================================================
+//  Golden_Load֐ - ̃t@Cǂݍ݂܂ (ǂ߂sԂ܂BJȂ -1)
+//   (# Ŏn܂s͐Ȃ̂œǂݔ΂܂)
+//=============================================================================
+static int Golden_Load(const char* path, GoldenEntry* entries, int maxEntries)
+{
+    char line[256];
+    int count = 0;
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL){
+        return -1;
+    }
+
+    while (count < maxEntries && fgets(line, sizeof(line), fp) != NULL){
+        GoldenEntry& e = entries[count];
+        if (line[0] == '#'){
+            continue;
+        }
+        if (sscanf(line, "%31s %lu %lx %lx", e.name, &e.frame, &e.simHash, &e.pixelHash) == 4){
+            count++;
+        }
+    }
+    fclose(fp);
+    return count;
+}
+
+//=============================================================================
+//  Golden_Save֐ - ̃t@Co܂
+//=============================================================================
+static bool Golden_Save(const char* path, const GoldenEntry* entries, int count)
+{
+    int i;
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL){
+        return false;
+    }
+
+    fprintf(fp, "#\n");
+    fprintf(fp, "# wWXgWv DX5x ʂ̐ (jjgolden ׂ܂)\n");
+    fprintf(fp, "#\n");
+    fprintf(fp, "#   O  t[  Q[̏Ԃ̃nbV  ʂ̃nbV\n");
+    fprintf(fp, "#\n");
+    fprintf(fp, "#   ڂ⓮ςCƂ́Aʂm߂Ă\n");
+    fprintf(fp, "#   ./jjgolden -update ō蒼ĂB\n");
+    fprintf(fp, "#\n");
+    for (i = 0; i < count; i++){
+        fprintf(fp, "%-16s %8lu %08lx %08lx\n", entries[i].name, entries[i].frame, entries[i].simHash, entries[i].pixelHash);
+    }
+    return fclose(fp) == 0;
+}
+
+//=============================================================================
+//  Golden_Check֐ - ׂĂ̏ʂ`āAƌׂ܂ (Ⴂ 1 Ԃ܂)
+//=============================================================================
+static int Golden_Check(const char* goldenPath, bool update, const char* dumpDir, const char* filter)
+{
+    static GoldenEntry golden[GOLDEN_CASE_COUNT], results[GOLDEN_CASE_COUNT];
+    static World world;
+    int goldenCount = 0, resultCount = 0, failures = 0;
+    int i, j;
+
+    if (!update){
+        goldenCount = Golden_Load(goldenPath, golden, GOLDEN_CASE_COUNT);
+        if (goldenCount < 0){
+            fprintf(stderr, "cannot read %s (run with -update to create it)\n", goldenPath);
+            return 1;
+        }
+    }
+
+    for (i = 0; i < GOLDEN_CASE_COUNT; i++){
+        const GoldenCase& c = s_Cases[i];
+        unsigned long frame;
+        if (!Golden_Matches(c.name, filter)){
+            continue;
+        }
+        if (!Golden_Run(c, world, frame)){
+            printf("%-16s FAIL  (not reached within %d frames)\n", c.name, MAX_GOLDEN_FRAMES);
+            failures++;
+            continue;
+        }
+        Golden_Draw(world);
+
+        GoldenEntry& r = results[resultCount++];
+        sprintf(r.name, "%.31s", c.name);
+        r.frame = frame;
+        r.simHash = Sim_Hash(world);
+        r.pixelHash = Golden_PixelHash(s_Fb);
+
+        if (dumpDir != NULL){
+            char path[512];
+            sprintf(path, "%.480s/%s.ppm", dumpDir, c.name);
+            if (!Render_SavePPM(path, s_Fb)){
+                fprintf(stderr, "cannot write %s\n", path);
+            }
+        }
+
+        if (update){
+            printf("%-16s frame %-7lu sim %08lx  pixels %08lx\n", r.name, r.frame, r.simHash, r.pixelHash);
+            continue;
+        }
+
+        // ƌׂ܂ (Q[̏ԂႦΓAʂႦΕ`ςĂ܂)
+        const GoldenEntry* g = NULL;
+        for (j = 0; j < goldenCount; j++){
+            if (strcmp(golden[j].name, r.name) == 0){ g = &golden[j]; break; }
+        }
+        if (g == NULL){
+            printf("%-16s FAIL  (no golden entry)\n", r.name);
+            failures++;
+        }else if (g->frame != r.frame || g->simHash != r.simHash){
+            printf("%-16s FAIL  sim differs: frame %lu sim %08lx, expected frame %lu sim %08lx\n", r.name, r.frame, r.simHash, g->frame, g->simHash);
+            failures++;
+        }else if (g->pixelHash != r.pixelHash){
+            printf("%-16s FAIL  pixels differ: %08lx, expected %08lx\n", r.name, r.pixelHash, g->pixelHash);
+            failures++;
+        }else{
+            printf("%-16s ok    frame %lu\n", r.name, r.frame);
+        }
+    }
+
+    if (update){
+        if (filter != NULL){
+            fprintf(stderr, "-update cannot be combined with -filter (the golden file would lose the other scenes)\n");
+            return 1;
+        }
+        if (!Golden_Save(goldenPath, results, resultCount)){
+            fprintf(stderr, "cannot write %s\n", goldenPath);
+            return 1;
+        }
+        printf("wrote %s (%d scenes)\n", goldenPath, resultCount);
+        return 0;
+    }
+
+    printf("%d of %d scenes match\n", resultCount - failures, resultCount);
+    return failures > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+//  
+//   1񕪂̏ iterations 񂭂Ԃ֐nƁAmin-time b𒴂܂
+//   񐔂{ɂȂ瑪A1񂠂̃imb\܂
+//-----------------------------------------------------------------------------
+typedef void (*BenchFunc)(void* context, unsigned long iterations);
+
+static void Bench_Run(const char* name, BenchFunc func, void* context, double minTime)
+{
+    unsigned long iterations = 1;
+    double seconds;
+
+    for (;;){
+        double start = Golden_Seconds();
+        func(context, iterations);
+        seconds = Golden_Seconds() - start;
+        if (seconds >= minTime || iterations >= 0x40000000UL){
+            break;
+        }
+        // ZAmin-time ɓ͂ȉ񐔂܂ňCɑ₵܂ (ő10{)
+        unsigned long next = iterations * 10;
+        if (seconds > 0.0){
+            double guess = iterations * minTime * 1.4 / seconds;
+            if (guess < (double)next) next = (unsigned long)guess + 1;
+        }
+        iterations = next > iterations ? next : iterations + 1;
+    }
+    printf("%-28s %12.1f ns %14lu\n", name, seconds * 1e9 / iterations, iterations);
+}
+
+// Q[i߂鑬: ɎvCōĂ͂Aŏ̏Ԃ珇ɗ^܂
+struct SimBench
+{
+    World         start;
+    World         world;
+    InputFrame*   inputs;
+    unsigned long count;
+};
+
+static void Bench_SimStep(void* context, unsigned long iterations)
+{
+    SimBench& b = *(SimBench*)context;
+    unsigned long n, i = b.count;
+
+    for (n = 0; n < iterations; n++){
+        if (i == b.count){
+            b.world = b.start;
+            i = 0;
+        }
+        Sim_Step(b.world, b.inputs[i++]);
+    }
+}
+
+static bool Bench_PrepareSim(SimBench& b, unsigned long seed, bool endless)
+{
+    PolicyState policy;
+    unsigned long i;
+
+    b.inputs = (InputFrame*)malloc(sizeof(InputFrame) * BENCH_SIM_FRAMES);
+    if (b.inputs == NULL){
+        return false;
+    }
+    b.count = BENCH_SIM_FRAMES;
+
+    Sim_Init(b.start, seed, NULL, 0);
+    Sim_SetEndless(b.start, endless);
+    Policy_Init(policy, POLICY_AUTO, seed);
+    b.world = b.start;
+    for (i = 0; i < b.count; i++){
+        b.inputs[i] = Policy_Choose(policy, b.world, i);
+        Sim_Step(b.world, b.inputs[i]);
+    }
+    return true;
+}
+
+// `: ԂA`惊Xg鏊ʂɕ`I܂łԂ܂
+static void Bench_Draw(void* context, unsigned long iterations)
+{
+    const World& world = *(const World*)context;
+    unsigned long n;
+
+    for (n = 0; n < iterations; n++){
+        Golden_Draw(world);
+    }
+}
+
+//=============================================================================
+//  Golden_Bench֐ - Q[i߂鑬ƁAʂƂ̕`𑪂܂
+//=============================================================================
+static int Golden_Bench(const char* filter, double minTime)
+{
+    static SimBench sims[2];
+    static World worlds[GOLDEN_CASE_COUNT];
+    char name[64];
+    int i;
+
+    printf("%-28s %15s %14s\n", "benchmark", "time/frame", "iterations");
+    printf("------------------------------------------------------------\n");
+
+    for (i = 0; i < 2; i++){
+        bool endless = (i == 1);
+        sprintf(name, "update/%s", endless ? "endless" : "stages");
+        if (!Golden_Matches(name, filter)){
+            continue;
+        }
+        if (!Bench_PrepareSim(sims[i], 1, endless)){
+            fprintf(stderr, "cannot allocate the input frames\n");
+            return 1;
+        }
+        Bench_Run(name, Bench_SimStep, &sims[i], minTime);
+        free(sims[i].inputs);
+    }
+
+    for (i = 0; i < GOLDEN_CASE_COUNT; i++){
+        unsigned long frame;
+        sprintf(name, "draw/%s", s_Cases[i].name);
+        if (!Golden_Matches(name, filter)){
+            continue;
+        }
+        if (!Golden_Run(s_Cases[i], worlds[i], frame)){
+            printf("%-28s (scene not reached)\n", name);
+            continue;
+        }
+        Bench_Run(name, Bench_Draw, &worlds[i], minTime);
+    }
+    return 0;
+}
+
+//=============================================================================
+//  main֐ - n܂܂
+//=============================================================================
+int main(int argc, char* argv[])
+{
+    int i;
+    const char* goldenPath = GOLDEN_FILE_NAME;
+    const char* dumpDir = NULL;
+    const char* filter = NULL;
+    bool update = false;
+    bool bench = false;
+    double minTime = 0.5;
+
+    for (i = 1; i < argc; i++){
+        if (strcmp(argv[i], "-golden") == 0 && i + 1 < argc){
+            goldenPath = argv[++i];
+        }else if (strcmp(argv[i], "-update") == 0){
+            update = true;
+        }else if (strcmp(argv[i], "-dump") == 0 && i + 1 < argc){
+            dumpDir = argv[++i];
+        }else if (strcmp(argv[i], "-bench") == 0){
+            bench = true;
+        }else if (strcmp(argv[i], "-filter") == 0 && i + 1 < argc){
+            filter = argv[++i];
+        }else if (strcmp(argv[i], "-min-time") == 0 && i + 1 < argc){
+            minTime = atof(argv[++i]);
+        }else{
+            fprintf(stderr, "usage: %s [-golden golden.txt] [-update] [-dump dir] [-bench] [-filter text] [-min-time s]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Text_InitBuiltin(s_Font);
+    Hud_Init(s_Hud);
+    s_Fb.pixels = s_Pixels; s_Fb.width = SCREEN_WIDTH; s_Fb.height = SCREEN_HEIGHT; s_Fb.pitch = SCREEN_WIDTH;
+
+    if (bench){
+        return Golden_Bench(filter, minTime);
+    }
+    return Golden_Check(goldenPath, update, dumpDir, filter);
+}
@@ -0,0 +1,393 @@
+//=============================================================================
+//
+//  wWXgWv DX5x wKp̊ (gym) (Linuxp)
+//
+//  Xbh Gym_Create ňxAGym_Step ̂тɋNĎg܂
+//  (1t[ƂɃXbh蒼ƁAꂾŎԂĂ܂߂ł)B
+//  Xbh k ́A̔ԍ k Ԗڂ͈̔͂󂯎܂B
+//  ǂ͉LȂ̂ŁAXbh̐ςĂʂ͓łB
+//
+//=============================================================================
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "gym.h"
+#include "sim.h"
+
+//-----------------------------------------------------------------------------
+//  ݒl (}N)
+//-----------------------------------------------------------------------------
+#define GYM_SCORE_REWARD    0.1f    // XRA 1 _̕V (ǂ1z +10 _ = V +1)
+#define GYM_MISS_REWARD     -1.0f   // ~XƂ̕V
+
+// ϑ̍ڂ̐́AC ̑̊O킩悤Ɍߑłł
+typedef char Gym_Obs_Count_Check[(GYM_OBS_COUNT == 14) ? 1 : -1];
+typedef char Gym_Obs_Far_Check[(GYM_OBS_FAR == (float)SCREEN_WIDTH) ? 1 : -1];
+
+// Xbhɗގd
+enum GymJob{
+    GYM_JOB_RESET,
+    GYM_JOB_STEP,
+    GYM_JOB_QUIT
+};
+
+//-----------------------------------------------------------------------------
+//  ݌v} (\)
+//-----------------------------------------------------------------------------
+struct GymWorker
+{
+    pthread_t       thread;
+    GymEnv*         env;
+    int             index;          // Ԗڂ͈̔͂󂯎
+};
+
+struct GymEnv
+{
+    int             envCount;
+    int             threadCount;
+    int             endless;        // 0 ȊOȂGhX[hŗVт܂
+    unsigned long   maxSteps;       // 1Gs\[h̃t[̏ (0 ȂȂ)
+    unsigned long   seed;           // Gym_Reset Ŏ󂯎
+
+    // Ƃ̏ (̐̔zł)
+    World*          worlds;
+    unsigned long*  steps;          // ̃Gs\[hŐi߂t[
+    unsigned long*  episodes;       // ܂łɏIGs\[h̐ (̃Gs\[h̎ɍ܂)
+
+    // łd (lock Ŏ܂BXbh generation ςdn߂܂)
+    pthread_mutex_t lock;
+    pthread_cond_t  start;          // d𗊂񂾍}
+    pthread_cond_t  finished;       // S̃XbhI}
+    unsigned long   generation;
+    int             pending;        // ܂IĂȂXbh̐
+    GymJob          job;
+    const unsigned char* actions;
+    float*          obs;
+    float*          rewards;
+    unsigned char*  dones;
+
+    GymWorker       workers[GYM_MAX_THREADS];
+};
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void  Gym_StartEpisode(GymEnv* env, int e);
+static void  Gym_StepOne(GymEnv* env, int e);
+static void  Gym_Observe(const World& world, float* obs, int e, int count);
+static void  Gym_RunRange(GymEnv* env, int index);
+static void  Gym_Dispatch(GymEnv* env, GymJob job);
+static void* Gym_WorkerMain(void* arg);
+
+//=============================================================================
+//  Gym_Create֐ -  envCount {pӂāAXbh𗧂グ܂
+//   (threadCount  0 ȂRA̐Bs NULL Ԃ܂)
+//=============================================================================
+GymEnv* Gym_Create(int envCount, int threadCount, int endless, unsigned long maxSteps)
+{
+    int i;
+    GymEnv* env;
+
+    if (envCount <= 0){
+        return NULL;
+    }
+    if (threadCount <= 0){
+        threadCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threadCount > envCount)        threadCount = envCount;
+    if (threadCount > GYM_MAX_THREADS) threadCount = GYM_MAX_THREADS;
+    if (threadCount < 1)               threadCount = 1;
+
+    env = (GymEnv*)calloc(1, sizeof(GymEnv));
+    if (env == NULL){
+        return NULL;
+    }
+    env->envCount    = envCount;
+    env->threadCount = threadCount;
+    env->endless     = endless;
+    env->maxSteps    = maxSteps;
+    env->worlds      = (World*)calloc((size_t)envCount, sizeof(World));
+    env->steps       = (unsigned long*)calloc((size_t)envCount, sizeof(unsigned long));
+    env->episodes    = (unsigned long*)calloc((size_t)envCount, sizeof(unsigned long));
+    if (env->worlds == NULL || env->steps == NULL || env->episodes == NULL){
+        free(env->worlds); free(env->steps); free(env->episodes); free(env);
+        return NULL;
+    }
+
+    pthread_mutex_init(&env->lock, NULL);
+    pthread_cond_init(&env->start, NULL);
+    pthread_cond_init(&env->finished, NULL);
+
+    // 0 Ԗڂ͈̔͂́AĂяoXbhŎ󂯎܂
+    for (i = 0; i < threadCount; i++){
+        env->workers[i].env = env;
+        env->workers[i].index = i;
+    }
+    for (i = 1; i < threadCount; i++){
+        if (pthread_create(&env->workers[i].thread, NULL, Gym_WorkerMain, &env->workers[i]) != 0){
+            env->threadCount = i;   // ꂽő܂
+            break;
+        }
+    }
+
+    Gym_Reset(env, 1, NULL);
+    return env;
+}
+
+//=============================================================================
+//  Gym_Destroy֐ - Xbh~߂āAЕt܂
+//=============================================================================
+void Gym_Destroy(GymEnv* env)
+{
+    int i;
+
+    if (env == NULL){
+        return;
+    }
+    Gym_Dispatch(env, GYM_JOB_QUIT);
+    for (i = 1; i < env->threadCount; i++){
+        pthread_join(env->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&env->finished);
+    pthread_cond_destroy(&env->start);
+    pthread_mutex_destroy(&env->lock);
+    free(env->episodes);
+    free(env->steps);
+    free(env->worlds);
+    free(env);
+}
+
+//=============================================================================
+//  Gym_EnvCount֐EGym_ObsCount֐ - z̑傫߂邽߂̖₢킹
+//   (obs  Gym_ObsCount() * Gym_EnvCount(env)  float pӂĂ)
+//=============================================================================
+int Gym_EnvCount(const GymEnv* env)
+{
+    return env->envCount;
+}
+
+int Gym_ObsCount(void)
+{
+    return GYM_OBS_COUNT;
+}
+
+//=============================================================================
+//  Gym_Reset֐ - S̊A seed ŏ̃Gs\[hnߒ܂
+//   (obs  NULL łȂ΁Aŏ̗lq݂܂)
+//=============================================================================
+void Gym_Reset(GymEnv* env, unsigned long seed, float* obs)
+{
+    env->seed = seed;
+    env->obs = obs;
+    Gym_Dispatch(env, GYM_JOB_RESET);
+}
+
+//=============================================================================
+//  Gym_Step֐ - S̊Aactions (0 ȊOŃWv) ̓͂1t[i߂܂
+//   (I́ȀŎ̃Gs\[hn߂܂)
+//=============================================================================
+void Gym_Step(GymEnv* env, const unsigned char* actions, float* obs, float* rewards, unsigned char* dones)
+{
+    env->actions = actions;
+    env->obs = obs;
+    env->rewards = rewards;
+    env->dones = dones;
+    Gym_Dispatch(env, GYM_JOB_STEP);
+}
+
+//=============================================================================
+//  Gym_Hash֐ - S̊̏ԂAnbVl1܂
+//   (Xbh̐ςĂlɂȂ邱Ƃm߂̂Ɏg܂)
+//=============================================================================
+unsigned long Gym_Hash(const GymEnv* env)
+{
+    int e;
+    unsigned int h = 0;
+    for (e = 0; e < env->envCount; e++){
+        h = Rng_Hash(h ^ (unsigned int)Sim_Hash(env->worlds[e]));
+    }
+    return h;
+}
+
+//=============================================================================
+//  1{̊̏
+//=============================================================================
+// Gs\[hn߂܂B́uGym_Reset ̎E̔ԍEGs\[hڂvŌ܂܂
+static void Gym_StartEpisode(GymEnv* env, int e)
+{
+    World& world = env->worlds[e];
+    unsigned int h = Rng_Hash((unsigned int)env->seed);
+    h = Rng_Hash(h ^ (unsigned int)e);
+    h = Rng_Hash(h ^ (unsigned int)env->episodes[e]);
+
+    // ^Cgʂ͔΂āAXe[W1 (GhX[hȂŏ̋) n߂܂
+    Sim_Init(world, h, NULL, 0);
+    Sim_SetEndless(world, env->endless != 0);
+    Sim_ResetGame(world);
+    env->steps[e] = 0;
+}
+
+static void Gym_StepOne(GymEnv* env, int e)
+{
+    World& world = env->worlds[e];
+    unsigned long scoreBefore = world.score;
+    int livesBefore = world.lives;
+    float reward;
+    unsigned char done = GYM_RUNNING;
+    InputFrame input;
+
+    input.jump = env->actions[e] != 0;
+    input.jumpPressed = input.jump;     // s͂̃t[ł́uėv1ł
+    input.escape = false;
+    Sim_Step(world, input);
+
+    reward = (float)(world.score - scoreBefore) * GYM_SCORE_REWARD;
+    if (world.lives < livesBefore){
+        // ŏ̃~XŃGs\[h͏Ił (҂t[͊wK̖ɗȂ)
+        reward += GYM_MISS_REWARD;
+        done = GYM_TERMINATED;
+    }else if (world.gameState == STATE_STAGE_CLEAR){
+        // NAʂ΂āAɎ̃Xe[W֐i݂܂
+        Sim_StartNextStage(world);
+        if (world.gameState == STATE_GAME_CLEAR){
+            done = GYM_TERMINATED;
+        }
+    }
+
+    env->steps[e]++;
+    if (done == GYM_RUNNING && env->maxSteps > 0 && env->steps[e] >= env->maxSteps){
+        done = GYM_TRUNCATED;
+    }
+    if (done != GYM_RUNNING){
+        env->episodes[e]++;
+        Gym_StartEpisode(env, e);
+    }
+
+    if (env->rewards != NULL) env->rewards[e] = reward;
+    if (env->dones != NULL)   env->dones[e] = done;
+    if (env->obs != NULL)     Gym_Observe(world, env->obs, e, env->envCount);
+}
+
+// ϑ݂܂ ( f  obs[f * count + e] ł)
+static void Gym_Observe(const World& world, float* obs, int e, int count)
+{
+    int i, n;
+    const Player& player = world.player;
+    float front = Scalar_ToFloat(player.x) + PLAYER_SIZE;
+    float* o = obs + e;
+
+    o[GYM_OBS_HEIGHT * count]    = (float)(GROUND_Y - PLAYER_SIZE) - Scalar_ToFloat(player.y);
+    o[GYM_OBS_VY * count]        = Scalar_ToFloat(player.vy);
+    o[GYM_OBS_ON_GROUND * count] = player.onGround ? 1.0f : 0.0f;
+    o[GYM_OBS_SPEED * count]     = -Sim_Stage(world).scrollSpeed;
+
+    //  (E[܂vC[Eɂ镨A珇ɁB͂ԂĂԃ}CiXł)
+    n = 0;
+    for (i = 0; i < world.obstacleCount && n < GYM_OBS_OBSTACLES; i++){
+        int slot = Sim_ObstacleSlot(world, i);
+        float x = Scalar_ToFloat(Sim_ScreenX(world, world.obstacleX[slot]));
+        if (x + OBSTACLE_WIDTH < Scalar_ToFloat(player.x)){
+            continue;
+        }
+        o[(GYM_OBS_OBSTACLE + n * 2) * count]     = x - front;
+        o[(GYM_OBS_OBSTACLE + n * 2 + 1) * count] = (float)world.obstacleHeight[slot];
+        n++;
+    }
+    for (; n < GYM_OBS_OBSTACLES; n++){
+        o[(GYM_OBS_OBSTACLE + n * 2) * count]     = GYM_OBS_FAR;
+        o[(GYM_OBS_OBSTACLE + n * 2 + 1) * count] = 0.0f;
+    }
+
+    // Ƃ (AE[܂vC[Eɂ镨)
+    n = 0;
+    for (i = 0; i < NUM_GROUND_SEGMENTS && n < GYM_OBS_PITS; i++){
+        const GroundSegment& seg = Sim_GroundAt(world, i);
+        float x = Scalar_ToFloat(Sim_ScreenX(world, seg.x));
+        if (!seg.isPit || x + seg.width < Scalar_ToFloat(player.x)){
+            continue;
+        }
+        o[(GYM_OBS_PIT + n * 2) * count]     = x - front;
+        o[(GYM_OBS_PIT + n * 2 + 1) * count] = (float)seg.width;
+        n++;
+    }
+    for (; n < GYM_OBS_PITS; n++){
+        o[(GYM_OBS_PIT + n * 2) * count]     = GYM_OBS_FAR;
+        o[(GYM_OBS_PIT + n * 2 + 1) * count] = 0.0f;
+    }
+}
+
+//=============================================================================
+//  Xbhւ̎d̎󂯓n
+//=============================================================================
+// index Ԗڂ͈̔͂̊A܂ꂽd̕i߂܂
+static void Gym_RunRange(GymEnv* env, int index)
+{
+    int e;
+    int begin = (int)((long long)env->envCount * index / env->threadCount);
+    int end   = (int)((long long)env->envCount * (index + 1) / env->threadCount);
+
+    for (e = begin; e < end; e++){
+        if (env->job == GYM_JOB_RESET){
+            env->episodes[e] = 0;
+            Gym_StartEpisode(env, e);
+            if (env->obs != NULL) Gym_Observe(env->worlds[e], env->obs, e, env->envCount);
+        }else{
+            Gym_StepOne(env, e);
+        }
+    }
+}
+
+// S̃XbhɎd𗊂݁A 0 Ԗڂ͈̔͂󂯎āASI܂ő҂܂
+static void Gym_Dispatch(GymEnv* env, GymJob job)
+{
+    pthread_mutex_lock(&env->lock);
+    env->job = job;
+    env->pending = env->threadCount - 1;
+    env->generation++;
+    pthread_cond_broadcast(&env->start);
+    pthread_mutex_unlock(&env->lock);
+
+    if (job != GYM_JOB_QUIT){
+        Gym_RunRange(env, 0);
+    }
+
+    pthread_mutex_lock(&env->lock);
+    while (env->pending > 0){
+        pthread_cond_wait(&env->finished, &env->lock);
+    }
+    pthread_mutex_unlock(&env->lock);
+}
+
+static void* Gym_WorkerMain(void* arg)
+{
+    GymWorker& self = *(GymWorker*)arg;
+    GymEnv* env = self.env;
+    unsigned long seen = 0;
+    GymJob job;
+
+    for (;;){
+        pthread_mutex_lock(&env->lock);
+        while (env->generation == seen){
+            pthread_cond_wait(&env->start, &env->lock);
+        }
+        seen = env->generation;
+        job = env->job;
+        pthread_mutex_unlock(&env->lock);
+
+        if (job != GYM_JOB_QUIT){
+            Gym_RunRange(env, self.index);
+        }
+
+        pthread_mutex_lock(&env->lock);
+        if (--env->pending == 0){
+            pthread_cond_signal(&env->finished);
+        }
+        pthread_mutex_unlock(&env->lock);
+
+        if (job == GYM_JOB_QUIT){
+            break;
+        }
+    }
+    return NULL;
+}
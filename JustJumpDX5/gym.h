@@ -0,0 +1,86 @@
+//=============================================================================
+//
+//  wWXgWv DX5x wKp̊ (gym) (Linuxp)
+//
+//  Q[WbN (sim.h) AO̊wKvO瓮߂ C ̑łB
+//  {̃Q[uvƂĕׁAS1t[̓͂nāA
+//  ܂Ƃ߂1t[i߂܂ (S̊At[i݂܂)B
+//  ̓Xbh̐œāAׂẴRAœɐi߂܂B
+//
+//  libjjgym.so ɂ܂Ƃ߂Ă̂ŁAC  Python (ctypes) Ȃǂ炻̂܂܌Ăׂ܂B
+//
+//  g:
+//    GymEnv* env = Gym_Create(4096, 0, 0, 10000);     //  4096 {AXbh̓RA̐
+//    Gym_Reset(env, seed, obs);                        // S̊ŏn߂܂
+//    for (;;){
+//        (obs  actions ߂)
+//        Gym_Step(env, actions, obs, rewards, dones);
+//    }
+//    Gym_Destroy(env);
+//
+//  z̕ (SoA):
+//    obs ́uڂƁvɊׂ̐܂B e ̍ f  obs[f * envCount + e] ł
+//    (ڂS̊ɂđēǂ߂̂ŁAwKł܂Ƃ߂ČvZ₷Ȃ܂)B
+//    actionsErewardsEdones ́A̐̔złB
+//    actions  0 ȊOȂÃt[ŃXy[XL[1񉟂ėƂɂȂ܂
+//    (n̏OɉAnƂɒт܂Bsim.h  JUMP_BUFFER_TICKS)B
+//
+//  1{̊ (Gs\[h) ́AXe[W1̊Jnŏ̃~X܂łłB
+//  ~XESXe[WNAEt[̏̂ǂꂩŏIƁAdones ɈtāA
+//  ̊͂Ɏ̃Gs\[hn߂܂ (̂Ƃ obs ́AVGs\[h̍ŏ̗lqł)B
+//
+//=============================================================================
+#ifndef GYM_H
+#define GYM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+//  ݒl (}N)
+//-----------------------------------------------------------------------------
+#define GYM_MAX_THREADS         256
+#define GYM_OBS_OBSTACLES       3       // ϑɓǂ̐ (vC[Oɂ镨A߂)
+#define GYM_OBS_PITS            2       // ϑɓ闎Ƃ̐
+#define GYM_OBS_FAR             640.0f  // Ȃǂ⌊̋ (ʂ̕)
+
+//-----------------------------------------------------------------------------
+//  ϑ̍ (obs[ * envCount + ] ɓ܂Bƍ̒Pʂ̓sNZł)
+//-----------------------------------------------------------------------------
+enum GymObs{
+    GYM_OBS_HEIGHT,             // nʂ̍Aǂꂾɂ邩 (ɗƃ}CiX)
+    GYM_OBS_VY,                 // c̑ (}CiXŏ)
+    GYM_OBS_ON_GROUND,          // nʂɗĂ 1A󒆂Ȃ 0
+    GYM_OBS_SPEED,              // XN[̑ (1t[ɐiދ)
+    GYM_OBS_OBSTACLE,           //  GYM_OBS_OBSTACLES B1ɂu, v2
+    GYM_OBS_PIT = GYM_OBS_OBSTACLE + GYM_OBS_OBSTACLES * 2,    // Ƃ GYM_OBS_PITS B1ɂu, v2
+    GYM_OBS_COUNT = GYM_OBS_PIT + GYM_OBS_PITS * 2
+};
+
+// dones ɓl
+enum GymDone{
+    GYM_RUNNING,                // ܂Ă܂
+    GYM_TERMINATED,             // ~XASXe[WNAďI܂
+    GYM_TRUNCATED               // t[̏őł؂܂
+};
+
+// ̏W܂ (g gym.cpp ̒Ŏg܂)
+typedef struct GymEnv GymEnv;
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+GymEnv* Gym_Create(int envCount, int threadCount, int endless, unsigned long maxSteps);
+void    Gym_Destroy(GymEnv* env);
+int     Gym_EnvCount(const GymEnv* env);
+int     Gym_ObsCount(void);
+void    Gym_Reset(GymEnv* env, unsigned long seed, float* obs);
+void    Gym_Step(GymEnv* env, const unsigned char* actions, float* obs, float* rewards, unsigned char* dones);
+unsigned long Gym_Hash(const GymEnv* env);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GYM_H
@@ -0,0 +1,119 @@
+//=============================================================================
+//
+//  wWXgWv DX5x wKp̊ (gym) ̓mFƑ (Linuxp)
+//
+//  wKvOƓ悤ɁAlibjjgym.so  C ̑ (gym.h) ŌĂяo܂
+//  (̃t@C C++ ł͂Ȃ C ŃrhāA C g邱Ƃm߂܂)B
+//  s͊ϑČ߂ȒPȎvCŁA1bɐi߂̃t[ƁA
+//  Gs\[h̕ς̕V\܂B
+//
+//  g:
+//    ./jjgymbench [-envs ] [-threads ] [-steps ] [-seed ] [-max-steps ] [-endless]
+//
+//    -envs       ׂ̐
+//    -threads    gXbh̐ (ȗƃRA̐)
+//    -steps      Gym_Step Ăԉ
+//    -max-steps  1Gs\[h̃t[̏
+//
+//  Ōɕ\nbVĺA-threads ςĂɂȂ܂B
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "gym.h"
+
+//-----------------------------------------------------------------------------
+//  ݒl (}N)
+//-----------------------------------------------------------------------------
+#define LOOK_AHEAD      40.0f   // ǂ̋܂ŋ߂ÂWv
+#define PIT_LOOK_AHEAD  10.0f   // Ƃ̋܂ŋ߂ÂWv
+
+//=============================================================================
+//  Bench_Choose֐ - ϑāAS̊̍s߂܂
+//=============================================================================
+static void Bench_Choose(const float* obs, unsigned char* actions, int count)
+{
+    const float* obstacle = obs + GYM_OBS_OBSTACLE * count;   // ԋ߂ǂ܂ł̋
+    const float* pit      = obs + GYM_OBS_PIT * count;        // ԋ߂Ƃ܂ł̋
+    int e;
+
+    for (e = 0; e < count; e++){
+        actions[e] = (unsigned char)((obstacle[e] > 0.0f && obstacle[e] < LOOK_AHEAD) ||
+                                     (pit[e] > 0.0f && pit[e] < PIT_LOOK_AHEAD));
+    }
+}
+
+//=============================================================================
+//  main֐
+//=============================================================================
+int main(int argc, char* argv[])
+{
+    int envs = 4096, threads = 0, endless = 0;
+    unsigned long steps = 10000, seed = 1, maxSteps = 20000;
+    unsigned long step, episodes = 0, truncated = 0;
+    double returnSum = 0.0, seconds;
+    float* obs;
+    float* rewards;
+    float* running;
+    unsigned char* actions;
+    unsigned char* dones;
+    GymEnv* env;
+    struct timespec t0, t1;
+    int i, e;
+
+    for (i = 1; i < argc; i++){
+        if      (strcmp(argv[i], "-envs") == 0 && i + 1 < argc)      envs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)   threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-steps") == 0 && i + 1 < argc)     steps = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc)      seed = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-max-steps") == 0 && i + 1 < argc) maxSteps = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-endless") == 0)                   endless = 1;
+        else {
+            fprintf(stderr, "usage: %s [-envs N] [-threads N] [-steps N] [-seed N] [-max-steps N] [-endless]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    env = Gym_Create(envs, threads, endless, maxSteps);
+    if (env == NULL){
+        fprintf(stderr, "Gym_Create failed\n");
+        return 1;
+    }
+    obs     = (float*)malloc(sizeof(float) * (size_t)Gym_ObsCount() * (size_t)envs);
+    rewards = (float*)malloc(sizeof(float) * (size_t)envs);
+    running = (float*)calloc((size_t)envs, sizeof(float));    // ̃Gs\[h̕V̍v
+    actions = (unsigned char*)malloc((size_t)envs);
+    dones   = (unsigned char*)malloc((size_t)envs);
+
+    Gym_Reset(env, seed, obs);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (step = 0; step < steps; step++){
+        Bench_Choose(obs, actions, envs);
+        Gym_Step(env, actions, obs, rewards, dones);
+
+        for (e = 0; e < envs; e++){
+            running[e] += rewards[e];
+            if (dones[e] != GYM_RUNNING){
+                episodes++;
+                if (dones[e] == GYM_TRUNCATED) truncated++;
+                returnSum += running[e];
+                running[e] = 0.0f;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    seconds = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    printf("envs     : %d%s\n", envs, endless ? " (endless)" : "");
+    printf("steps    : %lu (%.0f env-steps/sec, %.2f s)\n", steps, (double)envs * (double)steps / seconds, seconds);
+    printf("episodes : %lu finished, %lu truncated, mean return %.2f\n",
+           episodes, truncated, episodes > 0 ? returnSum / (double)episodes : 0.0);
+    printf("hash     : %08lx\n", Gym_Hash(env));
+
+    Gym_Destroy(env);
+    free(dones); free(actions); free(running); free(rewards); free(obs);
+    return 0;
+}
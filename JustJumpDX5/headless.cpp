@@ -0,0 +1,720 @@
+//=============================================================================
+//
+//  wWXgWv DX5x wbhX (ʂȂELinuxp)
+//
+//  EBhE DirectDraw g킸ɁAsim.cpp ̃Q[WbN
+//  Ђ񂷂߂̃vOłBԂ̑ϋveXg(\[NeXg)A
+//  1t[̏Ԃ̌vɎg܂B
+//
+//  g:
+//    ./jjheadless [-frames ] [-seed ] [-policy auto|random|idle]
+//                 [-render] [-dump 摜.ppm] [-bench-fill ]
+//                 [-record L^.jjr] [-replay L^.jjr] [-stages Xe[W.jjs]
+//                 [-profile O] [-font .jja] [-dirty] [-endless] [-alloc-check] [-pipeline]
+//                 [-seek t[] [-bench-rewind ] [-ghost tH_] [-bench-kernels t[]
+//
+//    -render      t[Ả (t[obt@) ɂ`܂
+//    -dump        Ō̃t[ PPM 摜Ƃĕۑ܂ (-render LɂȂ܂)
+//    -bench-fill  ʑŜ̓hԂw񐔂ԂAh̑𑪂܂
+//    -record      vC̓͂vCt@CɋL^܂
+//    -replay      vCt@C̓͂ŃQ[Đ܂ (ƃt[t@Ĉ̂g܂)
+//    -stages      Xe[WpbN (jjstagec ŕϊ) ̃Xe[WŗVт܂
+//    -profile     Ō 4096 t[̏Ԃ O.csv  O.json ɏo܂
+//                 (-render ƈꏏɎgƁAԂ̃Otʂɕ`܂)
+//    -font        ʂ̕ɁAWindowsłۑAgX (glyphs.jja) g܂
+//                 (w肵ȂΑgݍ݂̉ptHgŕ`ASp͎lpgɂȂ܂)
+//    -dirty       Õt[ς̈悾` (-render LɂȂ܂)A
+//                 t[Ŝ`ʂƈv邩m߂܂B`\܂
+//    -endless     GhX[hŗVт܂BR[X̋Ԃ WindowsłƓʂ̃XbhōA
+//                 Ԃɍ킸ɂ̏ō񐔂\܂ (vCɂ͗VѕL^܂)
+//    -alloc-check EH[Abv (ALLOC_WARMUP_FRAMES t[) ̌ɁAq[vgt[
+//                 ̃t[\āAIR[h 1 ŏI܂ (-render ƈꏏɎgƕ`ׂ܂)
+//    -pipeline    WindowsłƓAQ[ʂ̃XbhŐi߁ÃXbh͏Ԃ̎ʂ (snapshot.h) 
+//                 󂯎ĕ`܂ (-render LɂȂ܂)Bʂ Sim_Hash AŌvZl
+//                 Ⴆ (̎ʂǂł܂)AIR[h 1 ŏI܂
+//    -seek        -replay ƈꏏɎg܂BŌ܂ōĐŁAw肵t[Ɉԋ߂߂̎ʂ
+//                 (rewind.h) ɖ߂ĂÃt[܂Őiߒ܂BŏɍĐƂ̏Ԃ
+//                 Sim_Hash Ⴆ΁AIR[h 1 ŏI܂
+//    -bench-rewind ߂̎ʂƂE߂̂w񐔂ԂA1񂠂̎Ԃ𑪂܂
+//    -ghost       Xe[WƂ̈ԗǂAtH_̒ɃS[Xg (ghost.h) ƂĎcA
+//                 ܂ł̃S[Xgꏏɑ点܂ (-render ƈꏏɎgƁAS[Xg`܂)B
+//                 ŌɃS[Xg̃t@CSǂݒāAĂΏIR[h 1 ŏI܂
+//    -bench-kernels wt[̓͂vCōA̓͂ŃQ[i߂鑬A
+//                 Xe[Wɍ킹֐ (SIM_KERNEL_`) ƁA SIM_KERNEL_GENERIC Ői߂ꍇƂŔׂ܂B
+//                 -stagesE-endlessE-seedE-policy ܂B Sim_Hash Ⴆ΁AIR[h 1 ŏI܂
+//
+//  Ōɕ\ hash ȂAQ[̏Ԃ̓rbgPʂŊSɈvĂ܂B
+//  (numbers ͕Z̐̌^łBmake FIXED=1 ŃrhƌŒ菬_ɂȂA
+//   ǂ̃RpCœK̐ݒŃrhĂA hash ɂȂ܂)
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "sim.h"
+#include "render.h"
+#include "replay.h"
+#include "stagepack.h"
+#include "policy.h"
+#include "profiler.h"
+#include "text.h"
+#include "hud.h"
+#include "chunkstream.h"
+#include "arena.h"
+#include "allocwatch.h"
+#include "snapshot.h"
+#include "rewind.h"
+#include "ghost.h"
+
+//-----------------------------------------------------------------------------
+//  Q[1t[i߂̂Ɏg (-pipeline ̂Ƃ́Aʂ̃Xbhg܂)
+//-----------------------------------------------------------------------------
+struct HeadlessGame
+{
+    World*        world;
+    PolicyState*  policy;
+    Replay*       replay;
+    ChunkStream*  chunks;
+    bool          playback;         // true Ȃ烊vC̓͂Ői߂܂
+    bool          record;           // true Ȃ玩vC̓͂vCɋL^܂
+    bool          endless;
+    unsigned long games, stageClears, gameClears;
+
+    // -pipeline ̂Ƃg܂
+    SnapshotBuffer* snapshots;
+    unsigned long   frames;
+    volatile long   done;           // 1 ȂŌ̎ʂ܂ŒuI
+};
+
+//=============================================================================
+//  Bench_Fill֐ - ʑŜ̓hԂԂāA1b̃sNZ𑪂܂
+//=============================================================================
+static void Bench_Fill(const Framebuffer& fb, unsigned long count)
+{
+    unsigned long n;
+    static RenderList list;
+    clock_t start = clock();
+
+    for (n = 0; n < count; n++){
+        Render_Begin(list);
+        Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, (int)(n & 0xFF), 0, 100);
+        Render_Rect(list, 13, GROUND_Y, 301, SCREEN_HEIGHT - GROUND_Y, 139, 69, 19);
+        Render_Rect(list, 101, 77, PLAYER_SIZE, PLAYER_SIZE, 255, 255, 0);
+        Render_Flush(list, fb, NULL);
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double pixels = (double)count * (SCREEN_WIDTH * SCREEN_HEIGHT + 301 * (SCREEN_HEIGHT - GROUND_Y) + PLAYER_SIZE * PLAYER_SIZE);
+    printf("fill (%s)  : %lu frames, %.3f s, %.1f Mpixel/s\n", Render_SpanFillName(), count, seconds,
+           seconds > 0 ? pixels / seconds / 1e6 : 0.0);
+}
+
+//=============================================================================
+//  Bench_Rewind֐ - ߂̎ʂƂE߂̂ԂāA1񂠂̎Ԃ𑪂܂
+//=============================================================================
+static void Bench_Rewind(const World& world, unsigned long count)
+{
+    unsigned long n;
+    static RewindRing ring;
+    static World restored;
+    Rewind_Init(ring);
+    restored = world;
+
+    clock_t start = clock();
+    for (n = 0; n < count; n++){
+        Rewind_Record(ring, n * REWIND_INTERVAL, world, NULL);
+    }
+    double captureSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    unsigned long saved = ring.count;
+    unsigned long depth = saved < REWIND_SLOTS ? saved : REWIND_SLOTS;
+    start = clock();
+    for (n = 0; n < count; n++){
+        // ւ̒̂낢ȏɖ߂܂ (Rewind_Seek ͌̎ʂŶŁA񌳂ɖ߂܂)
+        const RewindSnapshot* snap = Rewind_Seek(ring, (saved - 1 - n % depth) * REWIND_INTERVAL);
+        Rewind_Restore(*snap, restored);
+        ring.count = saved;
+    }
+    double restoreSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("rewind       : %lu bytes per snapshot, %lu KB ring (%.1f s), capture %.3f us, restore %.3f us\n",
+           (unsigned long)sizeof(RewindSnapshot), (unsigned long)(sizeof(RewindRing) / 1024),
+           REWIND_SLOTS * REWIND_INTERVAL * (SIM_TICK_MS / 1000.0),
+           count ? captureSeconds * 1e6 / count : 0.0, count ? restoreSeconds * 1e6 / count : 0.0);
+}
+
+#define BENCH_KERNEL_ROUNDS     5       // -bench-kernels ŁAꂼ̊֐񑪂邩
+
+//=============================================================================
+//  Bench_KernelPass֐ - start ̏Ԃ inputs ̓͂ŃQ[i߂āAbԂ܂
+//=============================================================================
+static double Bench_KernelPass(const World& start, const InputFrame* inputs, unsigned long count, bool generic, unsigned long& hash)
+{
+    unsigned long n;
+    static World world;
+    world = start;
+    Sim_SetGenericKernel(world, generic);
+
+    clock_t begin = clock();
+    for (n = 0; n < count; n++){
+        Sim_Step(world, inputs[n]);
+    }
+    double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+    hash = Sim_Hash(world);
+    return seconds;
+}
+
+//=============================================================================
+//  Bench_Kernels֐ - Xe[Wɍ킹֐ SIM_KERNEL_GENERIC ƂŁAQ[i߂鑬ׂ܂
+//   (͂͐ɍĂ̂ŁAvC̎Ԃ͓܂BʂႦ false Ԃ܂)
+//=============================================================================
+static bool Bench_Kernels(const World& start, Policy policy, unsigned long seed, unsigned long count)
+{
+    unsigned long n;
+    int k;
+    static World world;
+    unsigned long used[SIM_KERNEL_COUNT] = { 0 };
+    unsigned long menus = 0;
+
+    InputFrame* inputs = (InputFrame*)malloc(count * sizeof(InputFrame));
+    if (inputs == NULL){
+        fprintf(stderr, "cannot allocate %lu input frames\n", count);
+        return false;
+    }
+
+    // 1. vCœ͂Aǂ̊֐ŉt[i߂𐔂܂
+    PolicyState policyState;
+    Policy_Init(policyState, policy, seed);
+    world = start;
+    for (n = 0; n < count; n++){
+        inputs[n] = Policy_Choose(policyState, world, n);
+        if (world.gameState == STATE_PLAYING) used[world.kernel]++; else menus++;
+        Sim_Step(world, inputs[n]);
+    }
+    unsigned long expected = Sim_Hash(world);
+
+    // 2. ͂ŁA݂ BENCH_KERNEL_ROUNDS 񂸂i߂āAԑԂg܂
+    double best[2] = { 0, 0 };
+    bool ok = true;
+    int round;
+    for (round = 0; round < BENCH_KERNEL_ROUNDS; round++){
+        for (k = 0; k < 2; k++){
+            unsigned long hash;
+            double seconds = Bench_KernelPass(start, inputs, count, k == 0, hash);
+            if (round == 0 || seconds < best[k]) best[k] = seconds;
+            if (hash != expected){
+                fprintf(stderr, "%s kernels: hash %08lx differs from %08lx\n", k == 0 ? "generic" : "specialized", hash, expected);
+                ok = false;
+            }
+        }
+    }
+    free(inputs);
+
+    printf("kernels      : generic %.1f ns/frame, specialized %.1f ns/frame (%.2fx), hash %08lx\n",
+           count ? best[0] * 1e9 / count : 0.0, count ? best[1] * 1e9 / count : 0.0,
+           best[1] > 0 ? best[0] / best[1] : 0.0, expected);
+    printf("kernel use   :");
+    for (k = 0; k < SIM_KERNEL_COUNT; k++){
+        if (used[k] > 0) printf(" %s %.1f%%,", Sim_KernelName(k), count ? used[k] * 100.0 / count : 0.0);
+    }
+    printf(" menus %.1f%%\n", count ? menus * 100.0 / count : 0.0);
+    return ok;
+}
+
+//=============================================================================
+//  Headless_Step֐ - vC (܂̓vC) ̓͂ŁAQ[1t[i߂܂
+//=============================================================================
+static void Headless_Step(HeadlessGame& game, unsigned long frame)
+{
+    World& world = *game.world;
+    GameState before = world.gameState;
+    InputFrame input;
+
+    if (game.playback){
+        Replay_NextFrame(*game.replay, input);
+    }else{
+        input = Policy_Choose(*game.policy, world, frame);
+        if (game.record) Replay_RecordFrame(*game.replay, input);
+    }
+    PROFILE_BEGIN(PROF_UPDATE);
+    Sim_Step(world, input);
+    PROFILE_END(PROF_UPDATE);
+    if (game.endless && world.gameState != STATE_PLAYING){
+        ChunkStream_Prefetch(*game.chunks, Sim_EndlessSeed(world, world.gameCount + 1));
+    }
+
+    if (before != world.gameState){
+        if (world.gameState == STATE_PLAYING && before == STATE_TITLE) game.games++;
+        if (world.gameState == STATE_STAGE_CLEAR) game.stageClears++;
+        if (world.gameState == STATE_GAME_CLEAR)  game.gameClears++;
+    }
+}
+
+//=============================================================================
+//  Pipeline_ThreadMain֐ - -pipeline ̂ƂɁAQ[i߂Xbh̖{̂ł
+//   (1t[i߂邽тɁAȌԂƁAmߗp Sim_Hash ʂɓĒu܂)
+//=============================================================================
+static void* Pipeline_ThreadMain(void* param)
+{
+    HeadlessGame& game = *(HeadlessGame*)param;
+    static World sim;
+    unsigned long frame;
+
+    sim = *game.world;
+    game.world = &sim;
+    for (frame = 0; frame < game.frames; frame++){
+        SimSnapshot& snap = Snapshot_BeginWrite(*game.snapshots);
+        snap.prev = sim;
+        Headless_Step(game, frame);
+        snap.cur  = sim;
+        snap.tick = frame + 1;
+        snap.time = 0;
+        snap.updateMicroseconds = 0.0;
+        snap.hash = Sim_Hash(sim);
+        Snapshot_Publish(*game.snapshots);
+    }
+    __atomic_store_n(&game.done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+//=============================================================================
+//  main֐ - wbhXł͂n܂܂
+//=============================================================================
+int main(int argc, char* argv[])
+{
+    int i;
+    unsigned long frames = 1000000;
+    unsigned int seed = 1;
+    Policy policy = POLICY_AUTO;
+    bool render = false;
+    const char* dumpPath = NULL;
+    unsigned long benchFill = 0;
+    const char* recordPath = NULL;
+    const char* replayPath = NULL;
+    const char* stagesPath = NULL;
+    const char* profilePrefix = NULL;
+    const char* fontPath = NULL;
+    bool dirty = false;
+    bool endless = false;
+    bool allocCheck = false;
+    bool pipeline = false;
+    unsigned long seekFrame = 0;
+    bool seek = false;
+    unsigned long benchRewind = 0;
+    const char* ghostDir = NULL;
+    unsigned long benchKernels = 0;
+
+    // 1. R}hC̓ǂݎ
+    for (i = 1; i < argc; i++){
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc){
+            frames = strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc){
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-policy") == 0 && i + 1 < argc){
+            i++;
+            if (!Policy_FromName(argv[i], policy)){ fprintf(stderr, "unknown policy: %s\n", argv[i]); return 1; }
+        }else if (strcmp(argv[i], "-render") == 0){
+            render = true;
+        }else if (strcmp(argv[i], "-dump") == 0 && i + 1 < argc){
+            dumpPath = argv[++i];
+            render = true;
+        }else if (strcmp(argv[i], "-bench-fill") == 0 && i + 1 < argc){
+            benchFill = strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-record") == 0 && i + 1 < argc){
+            recordPath = argv[++i];
+        }else if (strcmp(argv[i], "-replay") == 0 && i + 1 < argc){
+            replayPath = argv[++i];
+        }else if (strcmp(argv[i], "-stages") == 0 && i + 1 < argc){
+            stagesPath = argv[++i];
+        }else if (strcmp(argv[i], "-profile") == 0 && i + 1 < argc){
+            profilePrefix = argv[++i];
+        }else if (strcmp(argv[i], "-font") == 0 && i + 1 < argc){
+            fontPath = argv[++i];
+        }else if (strcmp(argv[i], "-dirty") == 0){
+            dirty = true;
+            render = true;
+        }else if (strcmp(argv[i], "-endless") == 0){
+            endless = true;
+        }else if (strcmp(argv[i], "-alloc-check") == 0){
+            allocCheck = true;
+        }else if (strcmp(argv[i], "-pipeline") == 0){
+            pipeline = true;
+            render = true;
+        }else if (strcmp(argv[i], "-seek") == 0 && i + 1 < argc){
+            seekFrame = strtoul(argv[++i], NULL, 10);
+            seek = true;
+        }else if (strcmp(argv[i], "-bench-rewind") == 0 && i + 1 < argc){
+            benchRewind = strtoul(argv[++i], NULL, 10);
+        }else if (strcmp(argv[i], "-ghost") == 0 && i + 1 < argc){
+            ghostDir = argv[++i];
+        }else if (strcmp(argv[i], "-bench-kernels") == 0 && i + 1 < argc){
+            benchKernels = strtoul(argv[++i], NULL, 10);
+        }else{
+            fprintf(stderr, "usage: %s [-frames N] [-seed N] [-policy auto|random|idle] [-render] [-dump out.ppm] [-bench-fill N] [-record file] [-replay file] [-stages file] [-profile name] [-font glyphs.jja] [-dirty] [-endless] [-alloc-check] [-pipeline] [-seek frame] [-bench-rewind N] [-ghost dir] [-bench-kernels N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (pipeline && (dirty || allocCheck || profilePrefix != NULL)){
+        // `̔rEq[v̌Evt@ĆA1̃XbhŐi߂ĕ`Ƃg܂
+        fprintf(stderr, "-pipeline cannot be used with -dirty, -alloc-check or -profile\n");
+        return 1;
+    }
+    if (seek && (replayPath == NULL || pipeline)){
+        fprintf(stderr, "-seek needs -replay and cannot be used with -pipeline\n");
+        return 1;
+    }
+    if (ghostDir != NULL && (pipeline || allocCheck)){
+        // S[Xg̓t@CJ肷̂ŁAq[vgȂƂ͊m߂܂
+        fprintf(stderr, "-ghost cannot be used with -pipeline or -alloc-check\n");
+        return 1;
+    }
+
+    // 2. Q[EƁA`ݐ̃̏
+    static World world;
+    static RenderList list;
+    static GlyphAtlas font;
+    static Hud hud;
+    static FrameArena arena;
+    static unsigned int pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+    Framebuffer fb;
+    fb.pixels = pixels; fb.width = SCREEN_WIDTH; fb.height = SCREEN_HEIGHT; fb.pitch = SCREEN_WIDTH;
+
+    // -dirty ̂ƂɔׂAt[Ŝ`
+    static RenderHistory history;
+    static unsigned int fullPixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+    Framebuffer fullFb = fb;
+    fullFb.pixels = fullPixels;
+    double dirtyPixels = 0;
+    unsigned long cleanFrames = 0;
+
+    if (fontPath != NULL){
+        if (!Text_LoadAtlas(font, fontPath)){
+            fprintf(stderr, "cannot read glyph atlas %s\n", fontPath);
+            return 1;
+        }
+    }else{
+        Text_InitBuiltin(font);
+    }
+    Hud_Init(hud);
+    if (!Arena_Init(arena, FRAME_ARENA_SIZE)){
+        fprintf(stderr, "cannot allocate the frame arena\n");
+        return 1;
+    }
+    if (allocCheck && !AllocWatch_Install()){
+        fprintf(stderr, "heap allocations cannot be counted in this build (link with -Wl,--wrap=malloc)\n");
+        return 1;
+    }
+
+    if (benchFill > 0){
+        Bench_Fill(fb, benchFill);
+    }
+
+    // vC͋L^Ƃ̃Xe[W\łĐłȂ̂ŁAXe[WpbNɊJ܂
+    static StagePack pack;
+    StagePack_Init(pack);
+    if (stagesPath != NULL && !StagePack_Open(pack, stagesPath)){
+        fprintf(stderr, "cannot open stage pack %s\n", stagesPath);
+        return 1;
+    }
+
+    static Replay replay;
+    Replay_Init(replay);
+
+    if (replayPath != NULL){
+        if (!Replay_Load(replay, replayPath, Sim_StageHash(pack.stages, pack.stageCount))){
+            fprintf(stderr, "cannot read replay %s\n", replayPath);
+            return 1;
+        }
+        Replay_BeginPlayback(replay);
+        seed = (unsigned int)replay.seed;
+        frames = replay.frameCount;
+        endless = (replay.flags & REPLAY_FLAG_ENDLESS) != 0;
+    }else if (recordPath != NULL){
+        Replay_BeginRecord(replay, seed, endless ? REPLAY_FLAG_ENDLESS : 0, Sim_StageHash(pack.stages, pack.stageCount));
+    }
+
+    PolicyState policyState;
+    Policy_Init(policyState, policy, seed);
+    Sim_Init(world, seed, pack.stages, pack.stageCount);
+    PROFILE_INIT();
+
+    if (benchRewind > 0){
+        Bench_Rewind(world, benchRewind);
+    }
+
+    if (benchKernels > 0){
+        // (Ԃ͂̃Xbhł̏ō܂Bǂ̊֐Ői߂ĂԂ܂)
+        static World start;
+        start = world;
+        Sim_SetEndless(start, endless);
+        if (!Bench_Kernels(start, policy, seed, benchKernels)) return 1;
+    }
+
+    static ChunkStream chunks;
+    if (endless){
+        Sim_SetEndless(world, true);
+        if (!ChunkStream_Start(chunks)){
+            fprintf(stderr, "cannot start the chunk thread\n");
+            return 1;
+        }
+        Sim_SetChunkProvider(world, ChunkStream_Provide, &chunks);
+    }
+
+    // 3. w肳ꂽt[Q[i߂܂
+    static HeadlessGame game;
+    game.world = &world;
+    game.policy = &policyState;
+    game.replay = &replay;
+    game.chunks = &chunks;
+    game.playback = replayPath != NULL;
+    game.record = recordPath != NULL;
+    game.endless = endless;
+
+    unsigned long allocFrames = 0, allocCount = 0, firstAllocFrame = 0;
+    unsigned long drawn = 0, torn = 0;
+    static SnapshotBuffer snapshots;
+
+    // -seek ̂Ƃ́AĐȂ犪߂̎ʂƂAot[̏ԂoĂ܂
+    // (ւOꂽÂt[ɖ߂Ƃ́Aŏ̏Ԃiߒ܂)
+    static RewindRing rewind;
+    static RewindSnapshot first;
+    unsigned long seekHash = 0;
+    Rewind_Init(rewind);
+    if (seek){
+        Rewind_Record(rewind, 0, world, &replay);
+        first = rewind.slots[0];
+    }
+    // -ghost ̂Ƃ́A1t[i߂邽тɑL^AS[Xg̎p߂܂
+    static GhostRace ghost;
+    GhostRace_Init(ghost, ghostDir, !game.playback);
+
+    clock_t start = clock();
+
+    unsigned long frame;
+    if (pipeline){
+        // Q[͕ʂ̃XbhŐi߁Ał͒uꂽԐVʂ`܂
+        pthread_t thread;
+        unsigned long lastTick = 0;
+        Snapshot_Init(snapshots);
+        game.snapshots = &snapshots;
+        game.frames = frames;
+        game.done = 0;
+        if (pthread_create(&thread, NULL, Pipeline_ThreadMain, &game) != 0){
+            fprintf(stderr, "cannot start the simulation thread\n");
+            return 1;
+        }
+        while (true){
+            bool finished = __atomic_load_n(&game.done, __ATOMIC_ACQUIRE) != 0;
+            if (!Snapshot_HasFresh(snapshots)){
+                if (finished) break;    // Ō̎ʂ܂ŕ`܂
+                sched_yield();
+                continue;
+            }
+            const SimSnapshot* snap = Snapshot_Latest(snapshots);
+            if (Sim_Hash(snap->cur) != snap->hash || snap->tick <= lastTick){
+                torn++;
+            }
+            lastTick = snap->tick;
+
+            Arena_Reset(arena);
+            Sim_Interpolate(snap->prev, snap->cur, 0.5f, world);
+            Render_Begin(list);
+            Render_World(list, world);
+            Hud_Build(hud, list, world);
+            Render_Flush(list, fb, &font);
+            drawn++;
+        }
+        pthread_join(thread, NULL);
+
+        // ʂ̕\ɂ́AŌ̎ʂ (= Q[i߂Xbh̍Ō̏) g܂
+        if (snapshots.hasRead){
+            world = Snapshot_Latest(snapshots)->cur;
+        }
+    }else{
+        for (frame = 0; frame < frames; frame++){
+            Arena_Reset(arena);
+            AllocWatch_BeginFrame();
+            PROFILE_BEGIN_FRAME();
+            Headless_Step(game, frame);
+            if (ghostDir != NULL){
+                GhostRace_Step(ghost, world);
+            }
+            if (seek){
+                Rewind_Record(rewind, frame + 1, world, &replay);
+                if (frame + 1 == seekFrame) seekHash = Sim_Hash(world);
+            }
+
+            if (render){
+                PROFILE_SCOPE(PROF_RECTS);
+                Render_Begin(list);
+                Render_World(list, world);
+                Ghost_Draw(list, world, ghost.pose);
+                Hud_Build(hud, list, world);
+#ifdef PROFILER_ENABLED
+                if (profilePrefix != NULL) Profiler_DrawOverlay(list, arena);
+#endif
+                if (dirty){
+                    // ς̈悾`AŜ`̂Ɣׂ܂
+                    int d;
+                    Render_FindDirty(history, list, &font, fb.width, fb.height);
+                    Render_FlushDirty(list, fb, &font, history);
+                    Render_Flush(list, fullFb, &font);
+                    if (memcmp(pixels, fullPixels, sizeof(pixels)) != 0){
+                        fprintf(stderr, "dirty rendering differs from a full redraw at frame %lu\n", frame);
+                        return 1;
+                    }
+                    for (d = 0; d < history.dirtyCount; d++){
+                        const DirtyRect& r = history.dirty[d];
+                        dirtyPixels += (double)(r.right - r.left) * (r.bottom - r.top);
+                    }
+                    if (history.dirtyCount == 0) cleanFrames++;
+                }else{
+                    Render_Flush(list, fb, &font);
+                }
+            }
+            PROFILE_END_FRAME(1, world.gameState);
+
+            // EH[Abv̌ɁÃt[Ńq[vgĂȂ
+            if (allocCheck && frame >= ALLOC_WARMUP_FRAMES && AllocWatch_FrameCount() > 0){
+                if (allocFrames == 0) firstAllocFrame = frame;
+                allocFrames++;
+                allocCount += AllocWatch_FrameCount();
+            }
+        }
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    ChunkStream_Stop(chunks);
+
+    // 4. ʂ̕\
+    printf("frames       : %lu (%.1f sim seconds)\n", frames, frames * (SIM_TICK_MS / 1000.0));
+    printf("games        : %lu\n", game.games);
+    printf("stage clears : %lu\n", game.stageClears);
+    printf("game clears  : %lu\n", game.gameClears);
+    printf("high score   : %lu\n", world.highScore);
+    printf("numbers      : %s\n", SCALAR_NAME);
+    printf("hash         : %08lx\n", Sim_Hash(world));
+    printf("elapsed      : %.3f s (%.1f ns/frame, %.0fx realtime)%s\n", seconds,
+           frames ? seconds * 1e9 / frames : 0.0,
+           seconds > 0 ? frames * (SIM_TICK_MS / 1000.0) / seconds : 0.0,
+           render ? " [with render]" : "");
+    if (render){
+        printf("hud formats  : %lu (%.4f per frame)\n", hud.formatCount, frames ? (double)hud.formatCount / frames : 0.0);
+    }
+    if (endless){
+        printf("chunks       : %lu ready, %lu made on the spot, %lu discarded (last area %lu)\n",
+               chunks.taken, chunks.stalls, chunks.discarded, world.chunk.index + 1);
+    }
+    if (pipeline){
+        printf("pipeline     : %lu snapshots published, %lu drawn (%.1f%% skipped), %lu torn\n",
+               snapshots.published, drawn,
+               snapshots.published ? (snapshots.published - drawn) * 100.0 / snapshots.published : 0.0, torn);
+        if (torn > 0){
+            fprintf(stderr, "a snapshot was read while it was being written\n");
+            return 1;
+        }
+    }
+    if (ghostDir != NULL){
+        // ȓ͎̂ĂĂAcS[Xg擪ƍ̗œǂݒ܂
+        int stage;
+        GhostRace_Shutdown(ghost);
+        printf("ghost runs   : %lu recorded, %lu new bests\n", ghost.runs, ghost.bests);
+        for (stage = 0; stage <= world.stageCount; stage++){
+            char path[GHOST_PATH_SIZE];
+            unsigned long samples, remaps;
+            FILE* fp;
+            bool isEndless = stage == world.stageCount;
+            GhostRace_FileName(ghost, isEndless ? 0 : stage, isEndless, "jjg", path);
+            if ((fp = fopen(path, "rb")) == NULL) continue;
+            fclose(fp);
+            if (!Ghost_Verify(path, Sim_StageHash(world.stages, world.stageCount), &samples, &remaps)){
+                fprintf(stderr, "%s is broken\n", path);
+                return 1;
+            }
+            printf("ghost        : %s (%lu samples, %lu views mapped)\n", path, samples, remaps);
+        }
+    }
+    if (dirty){
+        printf("dirty area   : %.1f%% of the screen per frame, %lu frames with nothing to redraw\n",
+               frames ? dirtyPixels * 100.0 / ((double)frames * SCREEN_WIDTH * SCREEN_HEIGHT) : 0.0, cleanFrames);
+    }
+
+    if (allocCheck){
+        Arena_Reset(arena);
+        printf("frame arena  : peak %lu of %lu bytes, %lu overflows\n", arena.peak, arena.size, arena.overflows);
+        if (allocFrames > 0){
+            printf("heap allocs  : %lu in %lu frames after warm-up (first at frame %lu)\n", allocCount, allocFrames, firstAllocFrame);
+            fprintf(stderr, "heap was used after warm-up\n");
+            return 1;
+        }
+        printf("heap allocs  : none after warm-up (%d frames)\n", ALLOC_WARMUP_FRAMES);
+    }
+
+    if (seek){
+        // ԋ߂ʂɖ߂āA瓪ot[܂ŋL^ꂽ͂Őiߒ܂
+        if (seekFrame > frames) seekFrame = frames;
+        if (seekFrame == 0) seekHash = Sim_Hash(first.world);
+        const RewindSnapshot* snap = Rewind_Seek(rewind, seekFrame);
+        if (snap == NULL) snap = &first;
+
+        clock_t seekStart = clock();
+        unsigned long f;
+        Rewind_Restore(*snap, world);
+        Sim_SetChunkProvider(world, NULL, NULL);    // R[XW͂~߂̂ŁAԂ͂̏ō܂
+        Replay_Seek(replay, snap->replay);
+        for (f = snap->frame; f < seekFrame; f++){
+            InputFrame input;
+            Replay_NextFrame(replay, input);
+            Sim_Step(world, input);
+        }
+        double seekSeconds = (double)(clock() - seekStart) / CLOCKS_PER_SEC;
+
+        printf("seek         : frame %lu from the snapshot at frame %lu (%lu frames re-simulated, %.1f us), hash %08lx\n",
+               seekFrame, snap->frame, seekFrame - snap->frame, seekSeconds * 1e6, Sim_Hash(world));
+        if (Sim_Hash(world) != seekHash){
+            fprintf(stderr, "seeking to frame %lu gave a different state (%08lx, expected %08lx)\n", seekFrame, Sim_Hash(world), seekHash);
+            return 1;
+        }
+    }
+
+    if (recordPath != NULL){
+        Replay_EndRecord(replay);
+        if (!Replay_Save(replay, recordPath)){
+            fprintf(stderr, "cannot write %s\n", recordPath);
+            return 1;
+        }
+        printf("recorded     : %s (%lu frames, %lu bytes of input)\n", recordPath, replay.frameCount, replay.size);
+    }
+    Replay_Free(replay);
+    StagePack_Close(pack);
+
+    if (profilePrefix != NULL){
+#ifdef PROFILER_ENABLED
+        char path[512];
+        sprintf(path, "%.500s.csv", profilePrefix);
+        bool ok = Profiler_WriteCSV(path);
+        sprintf(path, "%.500s.json", profilePrefix);
+        ok = Profiler_WriteTrace(path) && ok;
+        if (!ok){
+            fprintf(stderr, "cannot write %s.csv / .json\n", profilePrefix);
+            return 1;
+        }
+        printf("profile      : %s.csv, %s.json\n", profilePrefix, profilePrefix);
+#else
+        fprintf(stderr, "profiler is compiled out (NDEBUG is defined)\n");
+#endif
+    }
+
+    if (dumpPath != NULL){
+        if (!Render_SavePPM(dumpPath, fb)){
+            fprintf(stderr, "cannot write %s\n", dumpPath);
+            return 1;
+        }
+        printf("saved        : %s\n", dumpPath);
+    }
+    return 0;
+}
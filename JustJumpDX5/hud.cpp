@@ -0,0 +1,138 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ʂ̕ (HUD)
+//
+//  ̈ʒuƐF́AȑO main.cpp  Draw_* ֐ TextOut ĂƂƓłB
+//
+//=============================================================================
+#include <stdio.h>
+#include <string.h>
+#include "hud.h"
+
+//-----------------------------------------------------------------------------
+//  ʂɏo
+//   (ɏAgXɏĂt܂B₵ HUD_CHARSET ɂĂ)
+//-----------------------------------------------------------------------------
+#define HUD_TITLE           "WXgWv DX5"
+#define HUD_PRESS_START     "Xy[XL[ ͂߂"
+#define HUD_PRESS_QUIT      "ESCL[ "
+#define HUD_HIGH_SCORE      "nCXRAF%ld"
+#define HUD_STATUS          "Xe[W %ld  XRAF%ld (NA܂ł %ld)"
+#define HUD_ENDLESS_MODE    "GhX[h"
+#define HUD_ENDLESS_STATUS  "GhX  GA %ld  XRAF%ld"
+#define HUD_LIVES           "̂F%ld"
+#define HUD_POPUP           "+10"
+#define HUD_STAGE_CLEAR     "Xe[W %ld NAI"
+#define HUD_NEXT_STAGE      "Xy[XL[ ̃Xe[W"
+#define HUD_CONGRATULATIONS "߂łƂI"
+#define HUD_ALL_CLEAR       "ׂẴXe[WNA܂I"
+#define HUD_FINAL_SCORE     "ŏIXRAF%ld"
+#define HUD_TO_TITLE        "Xy[XL[ ^Cg"
+#define HUD_GAME_OVER       "Q[I[o["
+#define HUD_QUIT_GAME       "ESCL[ Q["
+
+#define HUD_CHARSET  HUD_TITLE HUD_PRESS_START HUD_PRESS_QUIT HUD_HIGH_SCORE HUD_STATUS HUD_ENDLESS_MODE HUD_ENDLESS_STATUS HUD_LIVES HUD_POPUP \
+                     HUD_STAGE_CLEAR HUD_NEXT_STAGE HUD_CONGRATULATIONS HUD_ALL_CLEAR HUD_FINAL_SCORE \
+                     HUD_TO_TITLE HUD_GAME_OVER HUD_QUIT_GAME
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static const char* Hud_Format(Hud& hud, HudLine& line, const char* format, long a, long b, long c);
+
+//=============================================================================
+//  Hud_Init֐ - ƂĂׂĎ̂Ă܂
+//=============================================================================
+void Hud_Init(Hud& hud)
+{
+    memset(&hud, 0, sizeof(hud));
+}
+
+//=============================================================================
+//  Hud_Build֐ - ̉ʂɏoA`惊Xgɐς݂܂
+//   (͎lp`̌ɁAς񂾏ɕ`܂)
+//=============================================================================
+void Hud_Build(Hud& hud, RenderList& list, const World& world)
+{
+    int i;
+    const int cx = SCREEN_WIDTH / 2, cy = SCREEN_HEIGHT / 2;
+
+    switch (world.gameState){
+
+        case STATE_TITLE:
+            Render_Text(list, cx - 100, cy - 80, HUD_TITLE, 255, 255, 0);
+            if (world.endless){
+                Render_Text(list, cx - 80, cy - 50, HUD_ENDLESS_MODE, 255, 150, 0);
+            }
+            Render_Text(list, cx - 100, cy, HUD_PRESS_START, 255, 255, 255);
+            Render_Text(list, cx - 80, cy + 30, HUD_PRESS_QUIT, 255, 255, 255);
+            Render_Text(list, cx - 80, cy + 80, Hud_Format(hud, hud.highScore, HUD_HIGH_SCORE, (long)world.highScore, 0, 0), 255, 255, 255);
+            break;
+
+        case STATE_PLAYING:
+        {
+            if (world.endless){
+                // GÁAR[XɕׂĂԂ̔ԍł
+                Render_Text(list, 10, 35, Hud_Format(hud, hud.endlessStatus, HUD_ENDLESS_STATUS, (long)world.chunk.index + 1, (long)world.score, 0), 255, 255, 255);
+            }else{
+                long remaining = (long)world.stages[world.currentStage].clearScore - (long)world.currentStageScore;
+                if (remaining < 0){
+                    remaining = 0;
+                }
+                Render_Text(list, 10, 35, Hud_Format(hud, hud.status, HUD_STATUS, world.currentStage + 1, (long)world.score, remaining), 255, 255, 255);
+            }
+            Render_Text(list, 10, 10, Hud_Format(hud, hud.lives, HUD_LIVES, world.lives, 0, 0), 255, 255, 255);
+
+            for (i = 0; i < world.popupCount; i++){
+                Render_Text(list, Scalar_ToInt(world.popupX[i]), Scalar_ToInt(world.popupY[i]), HUD_POPUP, 255, 255, 150);
+            }
+            break;
+        }
+
+        case STATE_STAGE_CLEAR:
+            Render_Text(list, cx - 120, cy - 40, Hud_Format(hud, hud.stageClear, HUD_STAGE_CLEAR, world.currentStage + 1, 0, 0), 255, 255, 0);
+            Render_Text(list, cx - 140, cy, HUD_NEXT_STAGE, 255, 255, 255);
+            break;
+
+        case STATE_GAME_CLEAR:
+            Render_Text(list, cx - 100, cy - 80, HUD_CONGRATULATIONS, 255, 255, 255);
+            Render_Text(list, cx - 160, cy - 50, HUD_ALL_CLEAR, 255, 255, 255);
+            Render_Text(list, cx - 90, cy - 20, Hud_Format(hud, hud.finalScore, HUD_FINAL_SCORE, (long)world.score, 0, 0), 255, 255, 255);
+            Render_Text(list, cx - 125, cy + 30, HUD_TO_TITLE, 255, 255, 255);
+            break;
+
+        case STATE_GAMEOVER:
+            Render_Text(list, cx - 80, cy - 80, HUD_GAME_OVER, 255, 0, 0);
+            Render_Text(list, cx - 110, cy - 40, Hud_Format(hud, hud.finalScore, HUD_FINAL_SCORE, (long)world.score, 0, 0), 255, 255, 255);
+            Render_Text(list, cx - 90, cy - 20, Hud_Format(hud, hud.highScore, HUD_HIGH_SCORE, (long)world.highScore, 0, 0), 255, 255, 255);
+            Render_Text(list, cx - 125, cy + 30, HUD_TO_TITLE, 255, 255, 255);
+            Render_Text(list, cx - 115, cy + 60, HUD_QUIT_GAME, 255, 255, 255);
+            break;
+    }
+}
+
+//=============================================================================
+//  Hud_Charset֐ - ʂɏo\̂镶AׂĕׂԂ܂
+//   (AgXƂɎg܂BƋL͔p̉pɊ܂܂Ă܂)
+//=============================================================================
+const char* Hud_Charset()
+{
+    return HUD_CHARSET;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// OƓȂAƂĂ̂܂ܕԂ܂
+static const char* Hud_Format(Hud& hud, HudLine& line, const char* format, long a, long b, long c)
+{
+    if (!line.valid || line.values[0] != a || line.values[1] != b || line.values[2] != c){
+        sprintf(line.text, format, a, b, c);
+        line.values[0] = a;
+        line.values[1] = b;
+        line.values[2] = c;
+        line.valid = true;
+        hud.formatCount++;
+    }
+    return line.text;
+}
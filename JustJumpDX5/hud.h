@@ -0,0 +1,44 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ʂ̕ (HUD)
+//
+//  XRA₢̂ȂǁAʂɏo`惊Xgɐς݂܂B
+//  ̓镶́AςƂ蒼āA܂ł͂ƂĂ܂
+//  (t[ wsprintf Kv͂܂)B
+//
+//=============================================================================
+#ifndef HUD_H
+#define HUD_H
+
+#include "sim.h"
+#include "render.h"
+
+#define HUD_LINE_LENGTH     96
+
+// ̓镶1{ (Ƃ̐oĂ܂)
+struct HudLine
+{
+    char text[HUD_LINE_LENGTH];
+    long values[3];
+    bool valid;
+};
+
+struct Hud
+{
+    HudLine status;         // Xe[WEXRAENA܂ł̎c
+    HudLine endlessStatus;  // GhX[h̃GAEXRA
+    HudLine lives;
+    HudLine highScore;
+    HudLine finalScore;
+    HudLine stageClear;
+    unsigned long formatCount;  // 蒼 (LbVĂ邩̊mFp)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Hud_Init(Hud& hud);
+void Hud_Build(Hud& hud, RenderList& list, const World& world);
+const char* Hud_Charset();
+
+#endif // HUD_H
@@ -0,0 +1,142 @@
+//=============================================================================
+//
+//  wWXgWv DX5x L[͂̑҂s (CxgL[)
+//
+//=============================================================================
+#include <string.h>
+#include "input.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+// INPUT_QUEUE_SIZE 2ׂ̂łȂ΂Ȃ܂ (ԍrbgZŋ߂邽)
+typedef char InputQueue_Size_Check[((INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE - 1)) == 0) ? 1 : -1];
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void InputQueue_Apply(InputQueue& queue, const InputEvent& ev, InputFrame& input);
+static long InputQueue_Load(volatile long* p);
+static void InputQueue_Store(volatile long* p, long n);
+
+//=============================================================================
+//  InputQueue_Init֐ - ҂sɂāAǂ̃L[Ԃɂ܂
+//=============================================================================
+void InputQueue_Init(InputQueue& queue)
+{
+    memset(&queue, 0, sizeof(queue));
+}
+
+//=============================================================================
+//  InputQueue_Push֐ - L[EƂm点Aƈꏏɓ܂ (鑤)
+//   (L[̏ԂςȂm点͓܂Bς̂Ƃ͓ꂸɐ邾ł)
+//=============================================================================
+void InputQueue_Push(InputQueue& queue, InputKey key, bool down, unsigned long time)
+{
+    long tail = queue.tail;
+
+    if (queue.pushed[key] == down){
+        return;
+    }
+    if (tail - InputQueue_Load(&queue.head) >= INPUT_QUEUE_SIZE){
+        queue.dropped++;
+        return;
+    }
+
+    InputEvent& ev = queue.events[tail & (INPUT_QUEUE_SIZE - 1)];
+    ev.time = time;
+    ev.key = (unsigned char)key;
+    ev.down = (unsigned char)(down ? 1 : 0);
+    queue.pushed[key] = down;
+    InputQueue_Store(&queue.tail, tail + 1);     // IĂAo悤ɂ܂
+}
+
+//=============================================================================
+//  InputQueue_ReleaseAll֐ - ĂL[SƂɂ܂ (鑤)
+//   (ق̃EBhEɐ؂ւƁAm点Ȃ߂ł)
+//=============================================================================
+void InputQueue_ReleaseAll(InputQueue& queue, unsigned long time)
+{
+    int key;
+    for (key = 0; key < INPUT_KEY_COUNT; key++){
+        InputQueue_Push(queue, (InputKey)key, false, time);
+    }
+}
+
+//=============================================================================
+//  InputQueue_Read֐ - frameEnd ܂łɋNm点oāA1t[̓͂ɂ܂Ƃ߂܂ (o)
+//   (frameEnd ̒m点́Ãt[̂߂ɎcĂ܂)
+//=============================================================================
+InputFrame InputQueue_Read(InputQueue& queue, unsigned long frameEnd)
+{
+    InputFrame input;
+    long head = queue.head;
+    long tail = InputQueue_Load(&queue.tail);
+
+    input.jump = queue.held[INPUT_KEY_JUMP];
+    input.jumpPressed = false;
+    input.escape = queue.held[INPUT_KEY_ESCAPE];
+
+    while (head != tail){
+        const InputEvent& ev = queue.events[head & (INPUT_QUEUE_SIZE - 1)];
+
+        // ͕t̍Ŕׂ܂ (timeGetTime Ăׂ܂)
+        if ((long)(ev.time - frameEnd) > 0){
+            break;
+        }
+        InputQueue_Apply(queue, ev, input);
+        head++;
+    }
+    InputQueue_Store(&queue.head, head);         // ǂݏIĂAꏊ󂯂܂
+    return input;
+}
+
+//=============================================================================
+//  Input_SetEdges֐ - Ă邩ǂ̓͂ɁAu (jumpPressed) t܂
+//   (jumpWasDown ɂ́AÕt[ŉĂĂ܂BĂԂтɏ܂)
+//=============================================================================
+void Input_SetEdges(InputFrame& input, bool& jumpWasDown)
+{
+    input.jumpPressed = input.jump && !jumpWasDown;
+    jumpWasDown = input.jump;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// m点1AĂL[̏ԂƁÃt[̓͂ɔf܂
+static void InputQueue_Apply(InputQueue& queue, const InputEvent& ev, InputFrame& input)
+{
+    bool wasDown = queue.held[ev.key];
+    queue.held[ev.key] = ev.down != 0;
+
+    if (ev.key == INPUT_KEY_JUMP && ev.down){
+        if (!wasDown){
+            input.jumpPressed = true;
+        }
+        input.jump = true;
+    }else if (ev.key == INPUT_KEY_ESCAPE && ev.down){
+        input.escape = true;
+    }
+}
+
+// 鑤ƎoŁAʒuǂݏ܂ (m点̒g̓ǂݏƁAԂւȂ悤ɂ܂)
+static long InputQueue_Load(volatile long* p)
+{
+#ifdef _WIN32
+    return InterlockedExchangeAdd((LONG volatile*)p, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void InputQueue_Store(volatile long* p, long n)
+{
+#ifdef _WIN32
+    InterlockedExchange((LONG volatile*)p, n);
+#else
+    __atomic_store_n(p, n, __ATOMIC_RELEASE);
+#endif
+}
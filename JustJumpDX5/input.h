@@ -0,0 +1,77 @@
+//=============================================================================
+//
+//  wWXgWv DX5x L[͂̑҂s (CxgL[)
+//
+//  L[EƂm点 (WM_KEYDOWN / WM_KEYUP) A̎ƈꏏ
+//  Oobt@ɂ߂ĂAQ[1t[i߂邽тɁũt[̎Ԃ̊Ԃ
+//  Nvo InputFrame ɂ܂Ƃ߂܂B
+//
+//  1t[1L[̏Ԃ𒲂ׂ (GetAsyncKeyState) ƔׂāA
+//    Et[ƃt[̊ԂɑfėA肱ڂ܂
+//    Eu (jumpPressed) ̑҂s񂩂킩̂ŁAʂƂ
+//      uOɉĂvoĂKv܂
+//    Êt[ڂAŐ܂܂
+//      (xĂ܂Ƃ߂ĉt[i߂ƂAt[Œт܂)
+//
+//  ҂śu鑤1Eo1v̌܂ŎĝŁAʁX̃Xbhł
+//  bNȂŎg܂ (Windowsłł́AEBhẼXbhāAQ[i߂Xbho܂)B
+//    tail ... 鑤܂ (m点IĂ1i߂܂)
+//    head ... o܂ (m点ǂݏIĂ1i߂܂)
+//
+//  ̓~błΉł܂܂ (Windowsł timeGetTime)B
+//
+//  g:
+//    InputQueue_Init(queue);
+//    InputQueue_Push(queue, INPUT_KEY_JUMP, true, );       // L[̃bZ[W
+//    InputFrame input = InputQueue_Read(queue, t[̏I̎);
+//
+//  vĈ悤ɁA1t[1uĂ邩ǂv߂镨́A
+//  ҂s̑ Input_SetEdges  jumpPressed ܂B
+//
+//=============================================================================
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "sim.h"
+
+#define INPUT_QUEUE_SIZE    64      // ߂Ăm点̐ (2ׂ̂B1t[̊ԂȂ\ł)
+
+// Q[ŎgL[
+enum InputKey{
+    INPUT_KEY_JUMP,                 // Xy[XL[
+    INPUT_KEY_ESCAPE,               // ESCL[
+    INPUT_KEY_COUNT
+};
+
+// L[EƂm点1
+struct InputEvent
+{
+    unsigned long time;             // N (~b)
+    unsigned char key;              // InputKey
+    unsigned char down;             // 1 Ȃ牟A0 Ȃ痣
+};
+
+struct InputQueue
+{
+    InputEvent    events[INPUT_QUEUE_SIZE];
+    volatile long head;             // Ɏoʒu (o܂Bz̔ԍ INPUT_QUEUE_SIZE Ŋ])
+    volatile long tail;             // ɓʒu (鑤܂)
+
+    // og܂
+    bool          held[INPUT_KEY_COUNT];    // oI܂łŁAĂL[
+
+    // 鑤g܂
+    bool          pushed[INPUT_KEY_COUNT];  // I܂łŁAĂL[
+    unsigned long dropped;          // ςœȂm点̐ (vp)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void       InputQueue_Init(InputQueue& queue);
+void       InputQueue_Push(InputQueue& queue, InputKey key, bool down, unsigned long time);
+void       InputQueue_ReleaseAll(InputQueue& queue, unsigned long time);
+InputFrame InputQueue_Read(InputQueue& queue, unsigned long frameEnd);
+void       Input_SetEdges(InputFrame& input, bool& jumpWasDown);
+
+#endif // INPUT_H
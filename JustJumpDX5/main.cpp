@@ -8,6 +8,11 @@
 //    Xy[XL[ŃWvāAĂǂ◎ƂЂ
 //    S5Xe[W̃Vv2DANVQ[łB
 //
+//  Xbh̕S:
+//    CXbh         ... Windows̃bZ[W (L[͂Ȃ) 󂯎邾ł
+//    Q[i߂Xbh ... Ԋu (SIM_TICK_MS) ŃQ[i߁AԂ̎ʂuĂ܂
+//    ʂ`Xbh     ... ԐVʂ`܂ (Flip ̑҂Ŏ~܂ĂAق͎~܂܂)
+//
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -19,6 +24,10 @@
 #include <ddraw.h>        // DirectX̕`@\ (DirectDraw)
 #include <mmsystem.h>     // Ԃ@\(timeGetTime)
 #include <stdio.h>        // @\(wsprintf)
+#include <process.h>      // Xbh@\ (_beginthreadex)
+#ifdef _DEBUG
+#include <crtdbg.h>       // fobOp̏o (_RPT)
+#endif
 
 //-----------------------------------------------------------------------------
 //  STEP 2: Cu̎w
@@ -29,38 +38,44 @@
 
 //-----------------------------------------------------------------------------
 //  STEP 3: Q[ŜŎgݒl (}N)
+//   (ʃTCYXe[WȂǂ́AQ[WbNƋʂ sim.h ɂ܂)
 //-----------------------------------------------------------------------------
 #define APP_NAME            "WXgWv DX5"
-#define SCREEN_WIDTH        640
-#define SCREEN_HEIGHT       480
-#define MAX_STAGES          5
-#define MAX_POPUPS          5
-#define MAX_OBSTACLES       3
-#define NUM_GROUND_SEGMENTS 10
+#define REPLAY_FILE_NAME    "lastplay.jjr"     // IɁÃvCL^t@C
+#define STAGEPACK_FILE_NAME "stages.jjs"       // Xe[Wݒ (oCi`BNɃɊ蓖Ă܂)
+#define STAGE_TEXT_FILE_NAME "stages.txt"      // Xe[Wݒ (eLXg`BXVĂ stages.jjs ɕϊ܂)
+#define FONT_FILE_NAME      "glyphs.jja"       // Ăť` (Ȃ΋N GDI ōĕۑ܂)
+#define PROFILE_CSV_FILE_NAME    "profile.csv"     // IɏoԂ̋L^ (fobOł)
+#define PROFILE_TRACE_FILE_NAME  "profile.json"    // L^ Chrome g[X` (chrome://tracing ŊJ܂)
+#define WINDOWED_STYLE      (WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX)  // EBhEŗVԂƂ̘g
+#define FULLSCREEN_BACK_BUFFERS  1     // Sʂ̂Ƃ̗̖ (2 ɂƁA`悪xĂ Flip ҂Ɏ`܂)
+#define INACTIVE_WAIT_MS    100         // Sʂłق̃Avɐ؂ւĂԁA`Xbh鎞
+#define PRACTICE_REWIND_FRAMES  (2000 / SIM_TICK_MS)    // K[hŃ~XƂɁA߂t[ (2b)
 
 //-----------------------------------------------------------------------------
-//  STEP 4: Q[̏ԂǗ邽߂̖O` (enum)
-//   (ԍɕ₷OtāAvOǂ݂₷܂)
+//  STEP 4: Q[WbN (V~[V) ̓ǂݍ
+//   (Ԃ̖O`E\́E萔 sim.h ɂ܂Ƃ߂Ă܂)
 //-----------------------------------------------------------------------------
-// Q[Ŝ̐is
-enum GameState{
-    STATE_TITLE,
-    STATE_PLAYING,
-    STATE_STAGE_CLEAR,
-    STATE_GAME_CLEAR,
-    STATE_GAMEOVER
-};
-
-// vC[l̏
-enum PlayerState{
-    PSTATE_NORMAL,
-    PSTATE_MISS,
-    PSTATE_RESPAWNING
-};
+#include "sim.h"
+#include "timestep.h"
+#include "input.h"
+#include "render.h"
+#include "replay.h"
+#include "stagepack.h"
+#include "profiler.h"
+#include "text.h"
+#include "hud.h"
+#include "chunkstream.h"
+#include "arena.h"
+#include "allocwatch.h"
+#include "ddcache.h"
+#include "snapshot.h"
+#include "rewind.h"
+#include "ghost.h"
 
 //-----------------------------------------------------------------------------
-//  STEP 5: vOŜŎgϐƐ݌v} (O[oϐE\)
-//   (ǂłgϐAf[^̂܂Ƃ܂`܂)
+//  STEP 5: vOŜŎgϐ (O[oϐ)
+//   (ǂłgϐ`܂)
 //-----------------------------------------------------------------------------
 
 // --- DirectX֘A ---
@@ -69,60 +84,82 @@ LPDIRECTDRAWSURFACE  g_pDDSPrimary = NULL; // 
 LPDIRECTDRAWSURFACE  g_pDDSBack    = NULL; // G`߂̗ (obNobt@)
 LPDIRECTDRAWCLIPPER  g_pDDClipper = NULL; // EBhE̊Oɕ`悵Ȃ߂̓
 HWND                 g_hwnd       = NULL; // 쐬EBhE̎ID
-
-// --- Q[̏ ---
-GameState g_eGameState = STATE_TITLE;   // ݂̃Q[
-BOOL      g_bSpaceKeyWasDown = FALSE; // Xy[XL[OɉĂL^tO
-
-// --- ݌v} (\) ---
-struct StageData      { float scrollSpeed; int clearScore; BOOL hasPits; };
-struct Player         { float x, y; float vy; BOOL onGround; PlayerState state; DWORD stateChangeTime; };
-struct Obstacle       { float x; int height; BOOL active; BOOL scored; };
-struct ScorePopup     { BOOL active; float x, y; DWORD startTime; };
-struct GroundSegment  { float x; int width; BOOL isPit; };
+BOOL                 g_bFullscreen = FALSE; // TRUE ȂS (ʂƂ߂āAFlip ŗƕ\ʂւ)
+BOOL                 g_bActive    = TRUE; // FALSE Ȃق̃Avɐ؂ւĂ (Sʂ̂Ƃ͎~߂܂)
+DDPIXELFORMAT        g_ddpfBack;          // ̐F̌` (1sNZrbgAȂ)
+DDCache              g_DDCache;           // ̐F̌`ɕϊς݂́AhԂ̐F (32rbgłȂƂɎg܂)
 
 // --- Q[Ŏgϐ ---
-Player          g_Player;
-Obstacle        g_Obstacles[MAX_OBSTACLES];
-ScorePopup      g_ScorePopups[MAX_POPUPS];
-GroundSegment   g_GroundSegments[NUM_GROUND_SEGMENTS];
-StageData       g_StageSettings[MAX_STAGES];
-DWORD           g_dwLastFrameTime = 0;
-DWORD           g_dwScore = 0;
-DWORD           g_dwCurrentStageScore = 0;
-DWORD           g_dwHighScore = 0;
-int             g_nPlayerLives = 0;
-int             g_nCurrentStage = 0;
+World           g_World;                  // Q[ÊׂĂ̏ (vC[EǁEnʁEXRAȂ)
+World           g_PrevWorld;              // 1t[O g_World (`̕ԂɎg܂)
+World           g_DrawWorld;              // ʂɕ` (ʂ prev  cur ̊ԂԂ)
+FixedTimestep   g_Timestep;               // ԊuŃQ[i߂邽߂̎Ԃ̒
+InputQueue      g_InputQueue;             // L[EƂm点Aƈꏏɂ߂Ă
+RenderList      g_RenderList;             // 1t[̎lp`ƕ߂Ă`惊Xg
+RenderHistory   g_RenderHistory;          // Õt[ɕ` (ς`)
+GlyphAtlas      g_Font;                   // ʂ̌̕` (N1񂾂Ăt܂)
+Hud             g_Hud;                    // XRAȂǂ̕ (ςƂ蒼܂)
+StagePack       g_StagePack;              // Xe[Wݒ̃t@C (JȂΑgݍ݂̃Xe[Wg܂)
+ChunkStream     g_ChunkStream;            // GhX[h̃R[XAʂ̃XbhŐɍĂW
+BOOL            g_bEndless = FALSE;       // TRUE ȂGhX[hŗV
+BOOL            g_bPractice = FALSE;      // TRUE ȂK[h (~XAOɊ߂Ă蒼)
+RewindRing      g_Rewind;                 // K[h̊߂ṕAŌ̖30b̎ʂ
+unsigned long   g_ulRewindFrame = 0;      // ߂̎ʂɕtt[̔ԍ (߂ƈꏏɖ߂܂)
+RewindSnapshot  g_StageStart;             // ̃Xe[Wn܂Ƃ̎ʂ (Oɂ͊߂܂)
+GhostRace       g_Ghost;                  // ԗǂ̃S[Xg (̋L^܂)
+GhostPose       g_PrevGhost;              // 1t[ÕS[Xg̎p (`̕ԂɎg܂)
+GhostPose       g_DrawGhost;              // ʂɕ`S[Xg̎p
+FrameArena      g_FrameArena;             // 1t[̊Ԃg̒u (t[̍ŏɋɂ܂)
+
+// --- Xbh֘A ---
+//   g_WorldEg_PrevWorldEg_TimestepEg_Replay ̓Q[i߂XbhA
+//   g_DrawWorldE`惊XgET[tFX͉ʂ`Xbhg܂B
+//   2̃Xbh̊Ԃ́Ag_Snapshots ̎ʂłƂ肵܂
+SnapshotBuffer  g_Snapshots;              // Q[̏Ԃ̎ʂ̒u (gvobt@)
+HANDLE          g_hUpdateThread = NULL;   // Q[i߂Xbh
+HANDLE          g_hRenderThread = NULL;   // ʂ`Xbh
+HANDLE          g_hQuitEvent = NULL;      // XbhɏIĂ炤߂̒m点
+HANDLE          g_hSnapshotEvent = NULL;  // VʂuƂA`Xbhւ̒m点
+volatile LONG   g_lRepaint = 0;           // 1 Ȃ玟ɕ`ƂɑŜ` (WM_PAINT ŗĂ܂)
+unsigned long   g_ulTick = 0;             // ܂łɐi߂t[̐ (Q[i߂Xbh܂)
+double          g_dUpdateMicroseconds = 0.0;      // Sim_Step ɂԂ̍v (Q[i߂Xbh܂)
+unsigned long   g_ulDrawnTick = 0;                // O`ʂ̃t[̔ԍ (`Xbhg܂)
+double          g_dDrawnUpdateMicroseconds = 0.0; // O`ʂ updateMicroseconds (`Xbhg܂)
+
+// --- vC֘A ---
+Replay          g_Replay;                 // L^ (܂͍Đ) ̃vC
+BOOL            g_bReplayPlayback = FALSE; // TRUE ȂL[{[h̑ɃvC̓͂g
+char            g_szReplayPath[260] = ""; // R}hCŎw肳ꂽĐ郊vCt@C
+
+// --- fobOp ---
+BOOL            g_bShowProfiler = FALSE;  // TRUE Ȃ珈Ԃ̃Otd˂ĕ` (F3L[Ő؂ւ)
+DWORD           g_dwFrameCount = 0;       // ܂łɕ`t[̐ (q[v̌̃EH[AbvɎg܂)
 
 //-----------------------------------------------------------------------------
-//  STEP 6: Q[̕@ՓxɊւݒl (萔)
-//-----------------------------------------------------------------------------
-const float GRAVITY = 0.4f;
-const float JUMP_POWER = -10.0f;
-const int   PLAYER_SIZE = 20;
-const int   GROUND_Y = 400;
-const int   OBSTACLE_WIDTH = 30;
-
-//-----------------------------------------------------------------------------
-//  STEP 7: ꂩ֐̖OXg (vg^Cv錾)
+//  STEP 6: ꂩ֐̖OXg (vg^Cv錾)
 //   (vỎ̕Œ`֐̖OAɋĂ܂)
 //-----------------------------------------------------------------------------
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 BOOL Game_Init(HWND hwnd);
 void Game_Shutdown();
-void Game_Main();
+BOOL Game_StartThreads();
+void Game_StopThreads();
+unsigned __stdcall Game_UpdateThread(void* pParam);
+unsigned __stdcall Game_RenderThread(void* pParam);
+void Game_Update();
+void Game_Render();
+void Publish_Snapshot(DWORD dwTime);
+void Practice_Update();
 void Flip_To_Screen();
-void Update_Title();
-void Draw_Title();
-void Update_Playing();
-void Draw_Playing();
-void Update_StageClear(); void Draw_StageClear();
-void Update_GameClear();  void Draw_GameClear();
-void Update_GameOver();
-void Draw_GameOver();
-void Draw_Rect(int x, int y, int w, int h, int r, int g, int b);
-void Reset_Game();
-void StartNextStage();
+InputFrame Read_Input(DWORD dwTickEnd);
+DWORD Message_Time();
+void Draw_Screen();
+BOOL Draw_RenderList();
+void Center_Window(HWND hwnd);
+BOOL Init_Display(HWND hwnd);
+BOOL Create_Surfaces();
+void Release_Surfaces();
+BOOL Restore_Surfaces();
 
 
 //=============================================================================
@@ -151,19 +188,33 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         return 0;
     }
 
-    // 2. EBhẼX^CƃTCYvZ܂
-    DWORD dwStyle = WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX;
-
-    RECT  wr = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
-
-    AdjustWindowRect(&wr, dwStyle, FALSE);
+    // 2. R}hCǂݎ܂
+    //    (u-replay t@CvŋNƁÃvCĐ܂B
+    //     u-endlessvŋNƁAGhX[hŗVт܂B
+    //     u-fullscreenvŋNƁASʂŗVт܂B
+    //     u-practicevŋNƁAK[hŗVт܂B2 -endless ƈꏏɂg܂)
+    if (strncmp(lpCmdLine, "-replay ", 8) == 0){
+        lstrcpyn(g_szReplayPath, lpCmdLine + 8, sizeof(g_szReplayPath));
+    }else{
+        g_bEndless    = strstr(lpCmdLine, "-endless") != NULL;
+        g_bFullscreen = strstr(lpCmdLine, "-fullscreen") != NULL;
+        g_bPractice   = strstr(lpCmdLine, "-practice") != NULL;
+    }
 
-    // 3. EBhEʂ̒ɍ쐬܂
-    g_hwnd = CreateWindow(APP_NAME, APP_NAME, dwStyle, (GetSystemMetrics(SM_CXSCREEN) - (wr.right - wr.left)) / 2, (GetSystemMetrics(SM_CYSCREEN) - (wr.bottom - wr.top)) / 2, wr.right - wr.left, wr.bottom - wr.top, NULL, NULL, hInstance, NULL);
+    // 3. EBhE쐬܂
+    //    (Sʂ̂Ƃ͘ĝȂEBhEʂςɁAłȂΘgtŉʂ̒)
+    if (g_bFullscreen){
+        g_hwnd = CreateWindowEx(WS_EX_TOPMOST, APP_NAME, APP_NAME, WS_POPUP, 0, 0, GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN), NULL, NULL, hInstance, NULL);
+    }else{
+        g_hwnd = CreateWindow(APP_NAME, APP_NAME, WINDOWED_STYLE, 0, 0, 0, 0, NULL, NULL, hInstance, NULL);
+    }
 
     if (g_hwnd == NULL){
         return 0;
     }
+    if (!g_bFullscreen){
+        Center_Window(g_hwnd);
+    }
 
     // 4. EBhE\܂
     ShowWindow(g_hwnd, nCmdShow);
@@ -175,19 +226,12 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         return 0;
     }
 
-    // 6. Q[̃C[vłB̒Ɖ葱܂
-    while (TRUE){
-        if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)){
-            if (msg.message == WM_QUIT){
-                break; // [v𔲂܂
-            }
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }else{
-
-            // Windows̃bZ[WȂ΁AQ[̏1t[i߂܂
-            Game_Main();
-        }
+    // 6. bZ[W̃[vłBQ[i߂̂ʂ`̂ʂ̃XbĥŁA
+    //    ł̓L[͂Ȃǂ̃bZ[W҂āA炷ɏ邾ł
+    //    (`̂ Flip ő҂ĂĂAL[͂ɋL^܂)
+    while (GetMessage(&msg, NULL, 0, 0) > 0){
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
     }
 
     // 7. Q[̏Ił
@@ -203,9 +247,63 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     switch (msg){
         case WM_DESTROY:
         {
+            // EBhEȂȂOɁAQ[i߂Xbhƕ`Xbh~߂܂
+            Game_StopThreads();
             PostQuitMessage(0); // Q[ĨbZ[W𑗂܂
             return 0;
         }
+
+        case WM_ACTIVATEAPP:
+        {
+            // ق̃Avɐ؂ւA߂Ă
+            g_bActive = (BOOL)wParam;
+            return 0;
+        }
+
+        case WM_PAINT:
+        {
+            // EBhẺBĂȂǂ͏Ă܂̂ŁÃt[őŜ`܂
+            // (`̋L^͕`Xbh̕Ȃ̂ŁAł͈t邾ł)
+            InterlockedExchange(&g_lRepaint, 1);
+            ValidateRect(hwnd, NULL);
+            return 0;
+        }
+
+        case WM_KEYDOWN:
+        case WM_KEYUP:
+        {
+            // L[ςȂɂƂ́AԂ̒m点͖܂
+            BOOL bDown = (msg == WM_KEYDOWN);
+            if (bDown && (lParam & 0x40000000) != 0){
+                return 0;
+            }
+
+            // Q[ŎgL[́AEƈꏏɑ҂sɓĂ܂B
+            // Q[i߂ƂɁA̎̃t[Ŏo܂ (Read_Input)
+            if (wParam == VK_SPACE){
+                InputQueue_Push(g_InputQueue, INPUT_KEY_JUMP, bDown != FALSE, Message_Time());
+                return 0;
+            }
+            if (wParam == VK_ESCAPE){
+                InputQueue_Push(g_InputQueue, INPUT_KEY_ESCAPE, bDown != FALSE, Message_Time());
+                return 0;
+            }
+#ifdef PROFILER_ENABLED
+            // F3L[ŏԂ̃Oto肵܂ (fobOł)
+            if (bDown && wParam == VK_F3){
+                g_bShowProfiler = !g_bShowProfiler;
+                return 0;
+            }
+#endif
+            break;
+        }
+
+        case WM_KILLFOCUS:
+        {
+            // ق̃EBhEɈڂƁAL[𗣂m点Ȃ̂ŁAőSƂɂ܂
+            InputQueue_ReleaseAll(g_InputQueue, timeGetTime());
+            break;
+        }
     }
 
     // ɏȂbZ[WWindowsɔC܂
@@ -221,57 +319,76 @@ BOOL Game_Init(HWND hwnd)
 
     // DirectX̏
     hr = DirectDrawCreate(NULL, &g_pDD, NULL); if (FAILED(hr)) { return FALSE; }
-    hr = g_pDD->SetCooperativeLevel(hwnd, DDSCL_NORMAL); if (FAILED(hr)) { return FALSE; }
-
-    // `̈(T[tFX)̏
-    DDSURFACEDESC ddsd;
-    ZeroMemory(&ddsd, sizeof(ddsd));
-    ddsd.dwSize = sizeof(ddsd);
-    ddsd.dwFlags = DDSD_CAPS;
-    ddsd.ddsCaps.dwCaps = DDSCAPS_PRIMARYSURFACE;
-    hr = g_pDD->CreateSurface(&ddsd, &g_pDDSPrimary, NULL); if (FAILED(hr)) { return FALSE; }
-    
-    ddsd.dwFlags = DDSD_CAPS | DDSD_WIDTH | DDSD_HEIGHT;
-    ddsd.ddsCaps.dwCaps = DDSCAPS_OFFSCREENPLAIN;
-    ddsd.dwWidth = SCREEN_WIDTH;
-    ddsd.dwHeight = SCREEN_HEIGHT;
-    hr = g_pDD->CreateSurface(&ddsd, &g_pDDSBack, NULL); if (FAILED(hr)) { return FALSE; }
-    
-    // Nbp[(͂ݏoh~)̏
-    hr = g_pDD->CreateClipper(0, &g_pDDClipper, NULL); if (FAILED(hr)) { return FALSE; }
-    hr = g_pDDClipper->SetHWnd(0, hwnd); if (FAILED(hr)) { return FALSE; }
-    hr = g_pDDSPrimary->SetClipper(g_pDDClipper); if (FAILED(hr)) { return FALSE; }
-
-    // SXe[W̐ݒ
-	// Xe[W1
-    g_StageSettings[0].scrollSpeed = -4.0f; 
-	g_StageSettings[0].clearScore = 150; 
-	g_StageSettings[0].hasPits = FALSE;
-
-	// Xe[W2
-    g_StageSettings[1].scrollSpeed = -4.5f; 
-	g_StageSettings[1].clearScore = 150; 
-	g_StageSettings[1].hasPits = TRUE;
-
-	// Xe[W3
-    g_StageSettings[2].scrollSpeed = -5.0f; 
-	g_StageSettings[2].clearScore = 150; 
-	g_StageSettings[2].hasPits = TRUE;
-
-	// Xe[W4
-    g_StageSettings[3].scrollSpeed = -5.5f; 
-	g_StageSettings[3].clearScore = 150; 
-	g_StageSettings[3].hasPits = TRUE;
-
-	// Xe[W5
-    g_StageSettings[4].scrollSpeed = -6.0f; 
-	g_StageSettings[4].clearScore = 150; 
-	g_StageSettings[4].hasPits = TRUE;
+
+    // ʂ̎g (SʂEBhE) ƁA`̈(T[tFX)EhԂ̐F̏
+    if (!Init_Display(hwnd)) { return FALSE; }
+
+    // Xe[Wݒ̃t@CJ܂BȂƂ g_StagePack.stages  NULL ̂܂܂Ȃ̂ŁA
+    // Sim_Init ͑gݍ݂5Xe[Wg܂
+    StagePack_Init(g_StagePack);
+    StagePack_Load(g_StagePack, STAGEPACK_FILE_NAME, STAGE_TEXT_FILE_NAME);
 
     // Q[ϐ̏
-    srand(timeGetTime());
-    g_eGameState = STATE_TITLE;
-    g_dwLastFrameTime = timeGetTime();
+    // vCĐƂ͋L^ꂽ̎AłȂ΍̎ɂ܂
+    // (ႤXe[W\ŋL^vC͓ǂݍ߂Ȃ̂ŁA̎ɂĕʂɗVт܂)
+    unsigned long stageHash = Sim_StageHash(g_StagePack.stages, g_StagePack.stageCount);
+    Replay_Init(g_Replay);
+    if (g_szReplayPath[0] != '\0' && Replay_Load(g_Replay, g_szReplayPath, stageHash)){
+        g_bReplayPlayback = TRUE;
+        g_bEndless = (g_Replay.flags & REPLAY_FLAG_ENDLESS) != 0;
+        Replay_BeginPlayback(g_Replay);
+        Sim_Init(g_World, g_Replay.seed, g_StagePack.stages, g_StagePack.stageCount);
+    }else{
+        DWORD seed = timeGetTime();
+        Replay_BeginRecord(g_Replay, seed, g_bEndless ? REPLAY_FLAG_ENDLESS : 0, stageHash);
+        Sim_Init(g_World, seed, g_StagePack.stages, g_StagePack.stageCount);
+    }
+
+    // GhX[h̃R[X́Aʂ̃XbhŐɍĂ܂
+    // (XbhȂ΁ASim KvȂƂɂ̏ō܂)
+    if (g_bEndless){
+        Sim_SetEndless(g_World, true);
+        if (ChunkStream_Start(g_ChunkStream)){
+            Sim_SetChunkProvider(g_World, ChunkStream_Provide, &g_ChunkStream);
+        }
+    }
+    g_PrevWorld = g_World;
+    g_DrawWorld = g_World;
+
+    // K[hł́Aŏ̏Ԃ犪߂̎ʂƂn߂܂
+    Rewind_Init(g_Rewind);
+    if (g_bPractice){
+        Rewind_Record(g_Rewind, g_ulRewindFrame, g_World, NULL);
+    }
+
+    // Xe[WƂ̈ԗǂAS[XgƂĈꏏɑ点܂
+    // (vC̍Đ́AS[Xgǂނŏ܂)
+    GhostRace_Init(g_Ghost, NULL, !g_bReplayPlayback);
+
+    // ʂ̌̕`pӂ܂BۑAgXɑȂ (ʂ̕
+    // ƂȂ)AVXetHgŏĂtĕۑ܂
+    if (!Text_LoadAtlas(g_Font, FONT_FILE_NAME) || !Text_HasAll(g_Font, Hud_Charset())){
+        if (Text_BakeGDI(g_Font, Hud_Charset())){
+            Text_SaveAtlas(g_Font, FONT_FILE_NAME);
+        }else{
+            Text_InitBuiltin(g_Font);
+        }
+    }
+    Hud_Init(g_Hud);
+    Render_Invalidate(g_RenderHistory);
+
+    // 1t[p̒úAňxmۂ܂BfobOłł́A
+    // Q[̃t[Ńq[vgĂȂ܂
+    if (!Arena_Init(g_FrameArena, FRAME_ARENA_SIZE)) { return FALSE; }
+    AllocWatch_Install();
+
+    // ^C}[̐x1~bɂāAԂ̌vn߂܂
+    timeBeginPeriod(1);
+    InputQueue_Init(g_InputQueue);
+    PROFILE_INIT();
+
+    // Q[i߂XbhƁAʂ`Xbh𓮂n߂܂
+    if (!Game_StartThreads()) { return FALSE; }
 
     return TRUE;
 }
@@ -281,465 +398,656 @@ BOOL Game_Init(HWND hwnd)
 //=============================================================================
 void Game_Shutdown()
 {
+    // Xbh DirectDraw ⃊vCgIĂЕt܂
+    Game_StopThreads();
+    ChunkStream_Stop(g_ChunkStream);
+    GhostRace_Shutdown(g_Ghost);        // ȓ́AL^܂
+
+    Release_Surfaces();
     if (g_pDDClipper)  { g_pDDClipper->Release();  g_pDDClipper = NULL;  }
-    if (g_pDDSBack)    { g_pDDSBack->Release();    g_pDDSBack = NULL;    }
-    if (g_pDDSPrimary) { g_pDDSPrimary->Release(); g_pDDSPrimary = NULL; }
+    if (g_pDD && g_bFullscreen) {
+        g_pDD->RestoreDisplayMode();
+        g_pDD->SetCooperativeLevel(g_hwnd, DDSCL_NORMAL);
+    }
     if (g_pDD)         { g_pDD->Release();         g_pDD = NULL;         }
+    timeEndPeriod(1);
+
+    // ̃vCvCt@Cɕۑ܂ (vC[̕s񍐂Ɏg܂)
+    // (K[h͊߂̂ŁA͂ł͓WJԂ܂Bۑ܂)
+    if (!g_bReplayPlayback && !g_bPractice){
+        Replay_EndRecord(g_Replay);
+        Replay_Save(g_Replay, REPLAY_FILE_NAME);
+    }
+    Replay_Free(g_Replay);
+
+    // Xe[W\̓t@C̒𒼐ڎwĂ̂ŁAQ[IĂ܂
+    StagePack_Close(g_StagePack);
+    Arena_Free(g_FrameArena);
+
+#ifdef PROFILER_ENABLED
+    // Ō̖1Ԃ̏Ԃo܂
+    Profiler_WriteCSV(PROFILE_CSV_FILE_NAME);
+    Profiler_WriteTrace(PROFILE_TRACE_FILE_NAME);
+#endif
 }
 
 //=============================================================================
-//  Game_Main֐ - Q[[v̖{́BԂɉďU蕪܂
+//  Game_StartThreads֐ - Q[i߂XbhƁAʂ`Xbh܂
+//   (ǂ̃Xbh C ̕WCu (reallocEfopenEsprintf Ȃ) ĝŁA
+//    CreateThread ł͂Ȃ _beginthreadex ō܂BvWFNg̐ݒA
+//    }`Xbhp̃^C (/MTAfobOł /MTd) ɂĂ܂)
 //=============================================================================
-void Game_Main()
+BOOL Game_StartThreads()
 {
-    DWORD currentTime = timeGetTime();
+    unsigned uThreadId;
 
-    if (currentTime - g_dwLastFrameTime < 16){
-        return;
+    g_hQuitEvent     = CreateEvent(NULL, TRUE, FALSE, NULL);    // xĂ痧܂ (̃Xbh܂)
+    g_hSnapshotEvent = CreateEvent(NULL, FALSE, FALSE, NULL);   // `Xbh󂯎玩ŉ܂
+    if (g_hQuitEvent == NULL || g_hSnapshotEvent == NULL){
+        Game_StopThreads();
+        return FALSE;
     }
 
-    g_dwLastFrameTime = currentTime;
+    Snapshot_Init(g_Snapshots);
+    g_hUpdateThread = (HANDLE)_beginthreadex(NULL, 0, Game_UpdateThread, NULL, 0, &uThreadId);
+    g_hRenderThread = (HANDLE)_beginthreadex(NULL, 0, Game_RenderThread, NULL, 0, &uThreadId);
+    if (g_hUpdateThread == NULL || g_hRenderThread == NULL){
+        Game_StopThreads();
+        return FALSE;
+    }
 
-    switch (g_eGameState){
+    // `̂dȂĂAQ[i߂̂xȂ悤ɁADxɂ܂
+    SetThreadPriority(g_hUpdateThread, THREAD_PRIORITY_ABOVE_NORMAL);
+    return TRUE;
+}
 
-        case STATE_TITLE:       
-			Update_Title();
-			Draw_Title();
-			break;
+//=============================================================================
+//  Game_StopThreads֐ - XbhɏIĂ炢AI܂ő҂܂ (Ăł܂܂)
+//=============================================================================
+void Game_StopThreads()
+{
+    if (g_hQuitEvent == NULL){
+        return;
+    }
 
-        case STATE_PLAYING:
-			Update_Playing();
-			Draw_Playing();
-			break;
+    SetEvent(g_hQuitEvent);
+    if (g_hUpdateThread) { WaitForSingleObject(g_hUpdateThread, INFINITE); CloseHandle(g_hUpdateThread); g_hUpdateThread = NULL; }
+    if (g_hRenderThread) { WaitForSingleObject(g_hRenderThread, INFINITE); CloseHandle(g_hRenderThread); g_hRenderThread = NULL; }
 
-        case STATE_STAGE_CLEAR:
-			Update_StageClear();
-			Draw_StageClear();
-			break;
+    if (g_hSnapshotEvent) { CloseHandle(g_hSnapshotEvent); g_hSnapshotEvent = NULL; }
+    CloseHandle(g_hQuitEvent);
+    g_hQuitEvent = NULL;
+}
 
-        case STATE_GAME_CLEAR:
-			Update_GameClear();
-			Draw_GameClear();
-			break;
+//=============================================================================
+//  Game_UpdateThread֐ - Q[i߂Xbh̖{̂ł
+//=============================================================================
+unsigned __stdcall Game_UpdateThread(void* pParam)
+{
+    // ŏ̏ԂuĂ܂ (`Xbh́AɃ^Cgʂ`܂)
+    Timestep_Init(g_Timestep, timeGetTime());
+    Publish_Snapshot(timeGetTime());
 
-        case STATE_GAMEOVER:
-			Update_GameOver();
-			Draw_GameOver();
-			break;
+    // ̃t[̎܂Ŗ܂BI̒m点AɋNĔ܂
+    do {
+        Game_Update();
+    } while (WaitForSingleObject(g_hQuitEvent, Timestep_TimeToNextTick(g_Timestep, timeGetTime())) == WAIT_TIMEOUT);
 
-    }
+    return 0;
 }
 
 //=============================================================================
-//  Flip_To_Screen֐ - (obNobt@)̓e\ʂɓ]܂
+//  Game_Update֐ - O񂩂o߂Ԃ̕AԊu (SIM_TICK_MS) ŃQ[i߂܂
 //=============================================================================
-void Flip_To_Screen()
+void Game_Update()
 {
-    RECT rcSrc, rcDest;
-    POINT p = { 0, 0 };
-    SetRect(&rcSrc, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-    GetClientRect(g_hwnd, &rcDest);
-    ClientToScreen(g_hwnd, &p);
-    OffsetRect(&rcDest, p.x, p.y);
-    g_pDDSPrimary->Blt(&rcDest, g_pDDSBack, &rcSrc, DDBLT_WAIT, NULL);
+    int i;
+    DWORD dwNow = timeGetTime();
+    int ticks = Timestep_Advance(g_Timestep, dwNow);
+
+    if (ticks == 0){
+        return;
+    }
+
+    // i߂ŏ̃t[Aۂ̎łI邩 (ɎćA܂ĂȂԂł)
+    DWORD dwTickEnd = dwNow - g_Timestep.accumulator - (DWORD)(ticks - 1) * SIM_TICK_MS;
+
+#ifdef PROFILER_ENABLED
+    ProfTicks start = Profiler_Now();
+#endif
+    for (i = 0; i < ticks; i++){
+        g_PrevWorld = g_World;
+        g_PrevGhost = g_Ghost.pose;
+        Sim_Step(g_World, Read_Input(dwTickEnd));
+        dwTickEnd += SIM_TICK_MS;
+        g_ulTick++;
+        if (g_bPractice){
+            Practice_Update();
+        }else{
+            // K[h͊߂̂ŁAi񂾋ȂȂ܂BS[Xg͎g܂
+            GhostRace_Step(g_Ghost, g_World);
+        }
+
+        if (g_World.quitRequested){
+            PostMessage(g_hwnd, WM_CLOSE, 0, 0);
+        }
+    }
+#ifdef PROFILER_ENABLED
+    // Ԃ̃Ot͕`Xbht̂ŁAԂʂɓēn܂
+    g_dUpdateMicroseconds += Profiler_TicksToMicroseconds(Profiler_Now() - start);
+#endif
+
+    // GhX[hŃQ[ĂȂԂɁÃQ[̃R[Xn߂Ă炢܂
+    if (g_World.chunkProvider != NULL && g_World.gameState != STATE_PLAYING){
+        ChunkStream_Prefetch(g_ChunkStream, Sim_EndlessSeed(g_World, g_World.gameCount + 1));
+    }
+
+    Publish_Snapshot(dwTickEnd - SIM_TICK_MS);
 }
 
 //=============================================================================
-//  ^Cgʂ̏
+//  Practice_Update֐ - K[hŁA1t[i߂邽тɌĂт܂
+//   (߂̎ʂƂĂA~XAcl炳ɖ2bO蒼܂B
+//    ÃXe[Wn܂O (^CgʂAÕXe[W̃NA) ɂ͖߂܂)
 //=============================================================================
-void Update_Title()
+void Practice_Update()
 {
-    if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) { 
-		PostMessage(g_hwnd, WM_CLOSE, 0, 0); 
-	}
+    g_ulRewindFrame++;
+
+    // Xe[Wn܂t[ȂȀԂoĂ܂
+    // (ւ̎ʂ REWIND_INTERVAL ƂȂ̂ŁAn܂uԂ̎ʂƂ͌܂)
+    if (g_World.gameState == STATE_PLAYING
+        && (g_PrevWorld.gameState != STATE_PLAYING || g_PrevWorld.currentStage != g_World.currentStage || g_PrevWorld.gameCount != g_World.gameCount)){
+        g_StageStart.frame = g_ulRewindFrame;
+        g_StageStart.world = g_World;
+        ZeroMemory(&g_StageStart.replay, sizeof(g_StageStart.replay));
+    }
 
-    if (GetAsyncKeyState(VK_SPACE) & 0x8000) {
-		g_bSpaceKeyWasDown = TRUE;
-	}else{ 
-		if (g_bSpaceKeyWasDown) { 
-			g_eGameState = STATE_PLAYING; Reset_Game(); 
-			g_bSpaceKeyWasDown = FALSE; 
-		} 
-	}
+    if (g_World.gameState == STATE_PLAYING && g_World.player.state == PSTATE_MISS && g_PrevWorld.player.state != PSTATE_MISS){
+        unsigned long ulTarget = g_ulRewindFrame > PRACTICE_REWIND_FRAMES ? g_ulRewindFrame - PRACTICE_REWIND_FRAMES : 0;
+        const RewindSnapshot* pSnap;
+        if (ulTarget < g_StageStart.frame){
+            ulTarget = g_StageStart.frame;
+        }
+        // Xe[Wn܂Ăŏ̎ʂOɖ߂Ƃ́An܂Ƃ̎ʂg܂
+        // (ւ̒́AO̎ʂ́AỎʂ̕ł)
+        if ((ulTarget / REWIND_INTERVAL) * REWIND_INTERVAL < g_StageStart.frame){
+            Rewind_Seek(g_Rewind, g_StageStart.frame);     // ̎ʂYĂ炢܂
+            pSnap = &g_StageStart;
+        }else{
+            pSnap = Rewind_Seek(g_Rewind, ulTarget);
+        }
+        if (pSnap != NULL){
+            Rewind_Restore(*pSnap, g_World);
+            g_PrevWorld = g_World;      // ߂ÖʒuAԂŊĂ悤ɌȂ悤ɂ܂
+            g_ulRewindFrame = pSnap->frame;
+        }
+    }
+
+    Rewind_Record(g_Rewind, g_ulRewindFrame, g_World, NULL);
 }
 
-void Draw_Title()
+//=============================================================================
+//  Publish_Snapshot֐ - ̏Ԃ̎ʂuāA`Xbhɒm点܂
+//   (dwTime  g_World ̃t[Ił)
+//=============================================================================
+void Publish_Snapshot(DWORD dwTime)
 {
-    HDC hdc; char szBuffer[128];
-    Draw_Rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 80);
-    if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))){
-        SetBkMode(hdc, TRANSPARENT);
-        SetTextColor(hdc, RGB(255, 255, 0));
-        TextOut(hdc, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 80, "WXgWv DX5", lstrlen("WXgWv DX5"));
-        SetTextColor(hdc, RGB(255, 255, 255));
-        TextOut(hdc, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2, "Xy[XL[ ͂߂", lstrlen("Xy[XL[ ͂߂"));
-        TextOut(hdc, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 + 30, "ESCL[ ", lstrlen("ESCL[ "));
-        wsprintf(szBuffer, "nCXRAF%d", g_dwHighScore);
-        TextOut(hdc, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 + 80, szBuffer, lstrlen(szBuffer));
-        g_pDDSBack->ReleaseDC(hdc);
-    }
-    Flip_To_Screen();
+    SimSnapshot& snap = Snapshot_BeginWrite(g_Snapshots);
+    snap.prev = g_PrevWorld;
+    snap.cur  = g_World;
+    snap.tick = g_ulTick;
+    snap.time = dwTime;
+    snap.updateMicroseconds = g_dUpdateMicroseconds;
+    snap.hash = 0;
+    snap.ghostPrev = g_PrevGhost;
+    snap.ghost = g_Ghost.pose;
+    Snapshot_Publish(g_Snapshots);
+
+    SetEvent(g_hSnapshotEvent);
 }
 
 //=============================================================================
-//  Q[vC̏ ( 炪C̏ł )
+//  Game_RenderThread֐ - ʂ`Xbh̖{̂ł
 //=============================================================================
-void Update_Playing()
+unsigned __stdcall Game_RenderThread(void* pParam)
 {
-    int i, j;
-    DWORD currentTime = timeGetTime();
-    float currentSpeed = g_StageSettings[g_nCurrentStage].scrollSpeed;
-
-    // --- ESCL[ꂽQ[I ---
-    if (GetAsyncKeyState(VK_ESCAPE) & 0x8000)
-    {
-        PostMessage(g_hwnd, WM_CLOSE, 0, 0);
-    }
-    
-    // --- u+10vXRAo̍XV (\Ԃ߂) ---
-    for (i = 0; i < MAX_POPUPS; i++)
-    {
-        if (g_ScorePopups[i].active)
-        {
-            if (currentTime - g_ScorePopups[i].startTime > 1000)
-            {
-                g_ScorePopups[i].active = FALSE;
-            }
-            else
-            {
-                g_ScorePopups[i].y -= 0.5f;
-            }
-        }
-    }
-    
-    // --- (Q)ɃXN[ ---
-    for (i = 0; i < MAX_OBSTACLES; i++)
-    {
-        if (g_Obstacles[i].active)
-        {
-            g_Obstacles[i].x += currentSpeed;
-            if (g_Obstacles[i].x < -OBSTACLE_WIDTH)
-            {
-                g_Obstacles[i].active = FALSE;
-            }
-        }
-    }
-    
-    // --- nʂXN[AVnʂƕǂ𐶐 ---
-    for (i = 0; i < NUM_GROUND_SEGMENTS; i++)
-    {
-        g_GroundSegments[i].x += currentSpeed;
-        
-        // nʃp[cʂ̍[ɊSɏ
-        if (g_GroundSegments[i].x + g_GroundSegments[i].width < 0)
-        {
-            // ܂Anʂ̒ňԉE[ɂ̂T
-            float maxX = -9999.0f;
-            for (j = 0; j < NUM_GROUND_SEGMENTS; j++)
-            {
-                float rightEdge = g_GroundSegments[j].x + (float)g_GroundSegments[j].width;
-                if (rightEdge > maxX)
-                {
-                    maxX = rightEdge;
-                }
-            }
-            
-            // VnʂÄԉE[̂ɉEɐ
-            g_GroundSegments[i].x = maxX;
-            
-            // Xe[WݒɉėƂɂ邩߂
-            if (g_StageSettings[g_nCurrentStage].hasPits && (rand() % 5 == 0))
-            {
-                g_GroundSegments[i].isPit = TRUE;
-                g_GroundSegments[i].width = 60 + rand() % 40;
-            }
-            else
-            {
-                g_GroundSegments[i].isPit = FALSE;
-                g_GroundSegments[i].width = 100 + rand() % 200;
-                
-                // VnʂƂłȂ΁Amŕǂu
-                if (rand() % 3 == 0)
-                {
-                    for (j = 0; j < MAX_OBSTACLES; j++)
-                    {
-                        if (!g_Obstacles[j].active)
-                        {
-                            g_Obstacles[j].active = TRUE;
-                            g_Obstacles[j].scored = FALSE;
-                            g_Obstacles[j].height = 30 + rand() % 50;
-                            int random_pos = rand() % (g_GroundSegments[i].width - OBSTACLE_WIDTH);
-                            g_Obstacles[j].x = g_GroundSegments[i].x + (float)random_pos;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }
+    HANDLE handles[2];
+    DWORD dwResult;
 
-    // --- vC[̏Ԃɉ ---
-    switch (g_Player.state)
-    {
-        case PSTATE_NORMAL:
-        case PSTATE_RESPAWNING:
-        {
-            // vC[̑ƕZ
-            if ((GetAsyncKeyState(VK_SPACE) & 0x8000) && g_Player.onGround)
-            {
-                g_Player.vy = JUMP_POWER;
-                g_Player.onGround = FALSE;
-            }
-            g_Player.vy += GRAVITY;
-            g_Player.y += g_Player.vy;
-            
-            // n
-            BOOL onSolidGround = FALSE;
-            for(i = 0; i < NUM_GROUND_SEGMENTS; i++) { if (g_Player.x + PLAYER_SIZE > g_GroundSegments[i].x && g_Player.x < g_GroundSegments[i].x + g_GroundSegments[i].width) { if (!g_GroundSegments[i].isPit) { onSolidGround = TRUE; } break; } }
-            if (onSolidGround && g_Player.y >= GROUND_Y - PLAYER_SIZE) { g_Player.y = GROUND_Y - PLAYER_SIZE; g_Player.vy = 0; g_Player.onGround = TRUE; } else { g_Player.onGround = FALSE; }
-
-            // ~X (GԒ͍sȂ)
-            BOOL isMiss = FALSE;
-            if (g_Player.state == PSTATE_NORMAL)
-            {
-                for (i = 0; i < MAX_OBSTACLES; i++) { if (g_Obstacles[i].active) { RECT playerRect = { (int)g_Player.x, (int)g_Player.y, (int)g_Player.x + PLAYER_SIZE, (int)g_Player.y + PLAYER_SIZE }; RECT obstacleRect = { (int)g_Obstacles[i].x, GROUND_Y - g_Obstacles[i].height, (int)g_Obstacles[i].x + OBSTACLE_WIDTH, GROUND_Y }; RECT dest; if (IntersectRect(&dest, &playerRect, &obstacleRect)) { isMiss = TRUE; break; } } }
-                if (!onSolidGround && g_Player.y > GROUND_Y) isMiss = TRUE; // Ƃ
-            }
-            if (isMiss) { g_nPlayerLives--; g_Player.state = PSTATE_MISS; g_Player.stateChangeTime = currentTime; }
-            
-            // XRAZ
-            for (i = 0; i < MAX_OBSTACLES; i++) { if (g_Obstacles[i].active && !g_Obstacles[i].scored && g_Obstacles[i].x + OBSTACLE_WIDTH < g_Player.x) { g_dwScore += 10; g_dwCurrentStageScore += 10; g_Obstacles[i].scored = TRUE; for (j = 0; j < MAX_POPUPS; j++) { if (!g_ScorePopups[j].active) { g_ScorePopups[j].active = TRUE; g_ScorePopups[j].x = g_Player.x; g_ScorePopups[j].y = g_Player.y - 15; g_ScorePopups[j].startTime = timeGetTime(); break; } } } }
-
-            // Xe[WNA
-            if (g_dwCurrentStageScore >= (DWORD)g_StageSettings[g_nCurrentStage].clearScore) { g_eGameState = STATE_STAGE_CLEAR; g_bSpaceKeyWasDown = TRUE; }
-            
-            // GԂ̏I
-            if (g_Player.state == PSTATE_RESPAWNING && currentTime - g_Player.stateChangeTime > 2000) { g_Player.state = PSTATE_NORMAL; }
-            break;
+    handles[0] = g_hQuitEvent;
+    handles[1] = g_hSnapshotEvent;
+
+    while (TRUE){
+        if (!g_bFullscreen){
+            // EBhÊƂ́AVʂu܂Ŗ܂
+            dwResult = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+        }else{
+            // Sʂ̂Ƃ Flip ʂ̏ () ҂̂ŁAł͑҂ɕ`܂B
+            // ق̃Avɐ؂ւĂԂ́A`ɖ܂
+            dwResult = WaitForSingleObject(g_hQuitEvent, g_bActive ? 0 : INACTIVE_WAIT_MS);
         }
-        case PSTATE_MISS:
-        {
-            // ~XA1bɕ邩Q[I[o[ɂȂ
-            if (currentTime - g_Player.stateChangeTime > 1000) { if (g_nPlayerLives > 0) { g_Player.state = PSTATE_RESPAWNING; g_Player.stateChangeTime = currentTime; g_Player.x = 100; g_Player.y = GROUND_Y - PLAYER_SIZE; g_Player.vy = 0; g_Player.onGround = TRUE; } else { if (g_dwScore > g_dwHighScore) { g_dwHighScore = g_dwScore; } g_eGameState = STATE_GAMEOVER; g_bSpaceKeyWasDown = TRUE; } }
-            break;
+        if (dwResult == WAIT_OBJECT_0){
+            break;  // I̒m点ł
+        }
+        if (!g_bFullscreen || g_bActive){
+            Game_Render();
         }
     }
+    return 0;
 }
 
-void Draw_Playing()
+//=============================================================================
+//  Game_Render֐ - ԐVʂAÕt[Ƃ̊ԂԂĕ`܂
+//=============================================================================
+void Game_Render()
 {
-    int i; HDC hdc; char szBuffer[256];
- 
-	DDBLTFX ddbltfx; ZeroMemory(&ddbltfx, sizeof(ddbltfx)); 
-	ddbltfx.dwSize = sizeof(DDBLTFX); 
-	ddbltfx.dwFillColor = RGB(0, 0, 100); 
-	g_pDDSBack->Blt(NULL, NULL, NULL, DDBLT_COLORFILL | DDBLT_WAIT, &ddbltfx);
- 
-	for (i = 0; i < NUM_GROUND_SEGMENTS; i++) { 
-		if (!g_GroundSegments[i].isPit) Draw_Rect((int)g_GroundSegments[i].x, GROUND_Y, g_GroundSegments[i].width, SCREEN_HEIGHT - GROUND_Y, 139, 69, 19);
-	}
+    const SimSnapshot* pSnap;
+    float alpha;
+    int ticks;
 
-    for (i = 0; i < MAX_OBSTACLES; i++) { 
-		if (g_Obstacles[i].active) Draw_Rect((int)g_Obstacles[i].x, GROUND_Y - g_Obstacles[i].height, OBSTACLE_WIDTH, g_Obstacles[i].height, 0, 200, 0); 
-	}
- 
-	if (g_Player.state == PSTATE_RESPAWNING) { 
-		if ((timeGetTime() / 100) % 2 == 0) Draw_Rect((int)g_Player.x, (int)g_Player.y, PLAYER_SIZE, PLAYER_SIZE, 255, 255, 0); 
-	}else if (g_Player.state != PSTATE_MISS) {
-		Draw_Rect((int)g_Player.x, (int)g_Player.y, PLAYER_SIZE, PLAYER_SIZE, 255, 255, 0); 
-	}
+    // Õt[Ŏg܂Ƃ߂ĕЕt܂ (ŁAq[v͎g܂)
+    Arena_Reset(g_FrameArena);
+    AllocWatch_BeginFrame();
 
-    if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))) { 
-		SetBkMode(hdc, TRANSPARENT); 
-		SetTextColor(hdc, RGB(255, 255, 255)); 
-		int remainingScore = g_StageSettings[g_nCurrentStage].clearScore - g_dwCurrentStageScore; 
-		
-		if (remainingScore < 0) { 
-			remainingScore = 0; 
-		}
-		
-		wsprintf(szBuffer, "Xe[W %d  XRAF%d (NA܂ł %d)", g_nCurrentStage + 1, g_dwScore, remainingScore); 
-		TextOut(hdc, 10, 35, szBuffer, lstrlen(szBuffer)); 
-		wsprintf(szBuffer, "̂F%d", g_nPlayerLives); 
-		TextOut(hdc, 10, 10, szBuffer, lstrlen(szBuffer)); 
-		SetTextColor(hdc, RGB(255, 255, 150)); 
+    pSnap = Snapshot_Latest(g_Snapshots);
+    if (pSnap == NULL){
+        return;
+    }
 
-		for (i = 0; i < MAX_POPUPS; i++) { 
+    // ʂ̃t[IĂ̎ԂŁÃt[ւǂꂾi񂾂߂܂
+    alpha = (float)(long)(timeGetTime() - pSnap->time) / SIM_TICK_MS;
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
 
-			if (g_ScorePopups[i].active) { 
-				TextOut(hdc, (int)g_ScorePopups[i].x, (int)g_ScorePopups[i].y, "+10", 3); 
-			} 
+    ticks = (int)(pSnap->tick - g_ulDrawnTick);
+    g_ulDrawnTick = pSnap->tick;
 
-		} 
-		g_pDDSBack->ReleaseDC(hdc); 
-	}
+    PROFILE_BEGIN_FRAME();
+    PROFILE_ADD(PROF_UPDATE, pSnap->updateMicroseconds - g_dDrawnUpdateMicroseconds);
+    g_dDrawnUpdateMicroseconds = pSnap->updateMicroseconds;
 
-    Flip_To_Screen();
+    Sim_Interpolate(pSnap->prev, pSnap->cur, alpha, g_DrawWorld);
+    g_DrawGhost = Ghost_Interpolate(pSnap->ghostPrev, pSnap->ghost, alpha);
+    if (InterlockedExchange(&g_lRepaint, 0) != 0){
+        Render_Invalidate(g_RenderHistory);
+    }
+
+    Draw_Screen();
+    PROFILE_END_FRAME(ticks, g_DrawWorld.gameState);
+
+    // EH[Abv̌̃t[Ńq[vgĂAfobK̏o̓EBhEɒm点܂
+    g_dwFrameCount++;
+#ifdef _DEBUG
+    if (g_dwFrameCount > ALLOC_WARMUP_FRAMES && AllocWatch_FrameCount() > 0){
+        _RPT2(_CRT_WARN, "frame %lu: %lu heap allocations\n", g_dwFrameCount, AllocWatch_FrameCount());
+    }
+#endif
 }
 
 //=============================================================================
-//  eʂ̏
+//  Read_Input֐ - dwTickEnd ܂łɉEL[oAQ[WbNɓn`ɂ܂
+//   (t[ƃt[̊ԂɑfėWvÃt[̓͂ɂȂ܂B
+//    Q[i߂XbhĂт܂)
 //=============================================================================
-void Update_StageClear() 
-{ 
-	if (GetAsyncKeyState(VK_SPACE) & 0x8000) { 
-		g_bSpaceKeyWasDown = TRUE;
-	}else{
-		if (g_bSpaceKeyWasDown) {
-			StartNextStage();
-			g_bSpaceKeyWasDown = FALSE;
-		}
-	}
+InputFrame Read_Input(DWORD dwTickEnd)
+{
+    InputFrame input = InputQueue_Read(g_InputQueue, dwTickEnd);
+
+    if (g_bReplayPlayback){
+        // vCĐ́AL^ꂽ͂g܂ (ESCL[͌悤ɂ܂)
+        BOOL bEscape = input.escape;
+        if (!Replay_NextFrame(g_Replay, input)){
+            input.jump = false;
+            input.jumpPressed = false;
+            input.escape = false;
+        }
+        input.escape = input.escape || bEscape;
+    }else{
+        Replay_RecordFrame(g_Replay, input);
+    }
+    return input;
 }
 
-void Draw_StageClear()
+//=============================================================================
+//  Message_Time֐ - ܏Ă郁bZ[WNAtimeGetTime ̎vŕԂ܂
+//   (GetMessageTime  GetTickCount ̎vȂ̂ŁAbZ[W҂ĂԂ̎܂)
+//=============================================================================
+DWORD Message_Time()
 {
-	HDC hdc;
-	char szBuffer[128];
-	Draw_Rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 80, 0);
-	
-	if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))) { 
-		SetBkMode(hdc, TRANSPARENT); 
-		SetTextColor(hdc, RGB(255, 255, 0)); 
-		wsprintf(szBuffer, "Xe[W %d NAI", g_nCurrentStage + 1); TextOut(hdc, SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 - 40, szBuffer, lstrlen(szBuffer)); 
-		SetTextColor(hdc, RGB(255, 255, 255)); TextOut(hdc, SCREEN_WIDTH / 2 - 140, SCREEN_HEIGHT / 2, "Xy[XL[ ̃Xe[W", lstrlen("Xy[XL[ ̃Xe[W")); 
-		g_pDDSBack->ReleaseDC(hdc); 
-	}
-	
-	Flip_To_Screen(); 
+    DWORD dwAge = GetTickCount() - (DWORD)GetMessageTime();
+    if (dwAge > 1000){
+        dwAge = 0;      // v̓ǂݕƂ́A󂯎Ƃɂ܂
+    }
+    return timeGetTime() - dwAge;
 }
 
-void Update_GameClear() 
+//=============================================================================
+//  Flip_To_Screen֐ - (obNobt@)̓e\ʂɓ]܂
+//   (̃t[ŕ`̈悾]܂BςĂȂΉ܂)
+//=============================================================================
+void Flip_To_Screen()
 {
-	if (GetAsyncKeyState(VK_SPACE) & 0x8000) {
-		g_bSpaceKeyWasDown = TRUE;
-	}else{ 
-		if (g_bSpaceKeyWasDown) { 
-			g_eGameState = STATE_TITLE; g_bSpaceKeyWasDown = FALSE; 
-		} 
-	} 
+    int i;
+    PROFILE_SCOPE(PROF_FLIP);
+
+    // T[tFX蒼ȂƂ́A]܂
+    if (g_pDDSPrimary == NULL || g_pDDSBack == NULL){
+        return;
+    }
+
+    // Sʂ̂Ƃ́Aƕ\ʂւ邾ł (Rs[Nbp[܂)B
+    // Flip ͎̐œւ̂ŁAGrŐ؂ (eBAO) Ƃ܂
+    if (g_bFullscreen){
+        if (g_pDDSPrimary->Flip(NULL, DDFLIP_WAIT) == DDERR_SURFACELOST){
+            Restore_Surfaces();
+        }
+        return;
+    }
+
+    POINT p = { 0, 0 };
+    ClientToScreen(g_hwnd, &p);
+
+    for (i = 0; i < g_RenderHistory.dirtyCount; i++){
+        const DirtyRect& d = g_RenderHistory.dirty[i];
+        RECT rcSrc, rcDest;
+        SetRect(&rcSrc, d.left, d.top, d.right, d.bottom);
+        rcDest = rcSrc;
+        OffsetRect(&rcDest, p.x, p.y);
+        if (g_pDDSPrimary->Blt(&rcDest, g_pDDSBack, &rcSrc, DDBLT_WAIT, NULL) == DDERR_SURFACELOST){
+            Restore_Surfaces();
+            return;
+        }
+    }
 }
 
-void Draw_GameClear() 
+//=============================================================================
+//  Draw_Screen֐ - ̏Ԃ̉ʂ`܂
+//   (EnʁEǁEvC[Ɖʂ̕`惊XgɐςŁAɂ܂Ƃ߂ĕ`܂B
+//    ̓OtAgX璼ڎʂ̂ŁAGDI  TextOut ͎g܂)
+//=============================================================================
+void Draw_Screen()
 {
-	HDC hdc; char szBuffer[128]; 
-	Draw_Rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 100, 100, 0); 
-
-	if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))) { 
-		SetBkMode(hdc, TRANSPARENT); 
-		SetTextColor(hdc, RGB(255, 255, 255)); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 80, "߂łƂI", lstrlen("߂łƂI")); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 160, SCREEN_HEIGHT / 2 - 50, "ׂẴXe[WNA܂I", lstrlen("ׂẴXe[WNA܂I")); 
-		wsprintf(szBuffer, "ŏIXRAF%d", g_dwScore); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 - 20, szBuffer, lstrlen(szBuffer)); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 125, SCREEN_HEIGHT / 2 + 30, "Xy[XL[ ^Cg", lstrlen("Xy[XL[ ^Cg")); 
-		g_pDDSBack->ReleaseDC(hdc); 
-	}
+    // T[tFX蒼ȂƂ (ʂ̐FςĂrȂ) ́A蒼܂ŕ`܂
+    if (g_pDDSBack == NULL && !Create_Surfaces()){
+        return;
+    }
 
-	Flip_To_Screen(); 
-}
+    // Sʂ Flip ̗ɂ́AÕt[ł͂ȂȂOɕ\ɏoĂG
+    // cĂ܂BÕt[Ƃ͎̍gȂ̂ŁAt[Ŝ`܂
+    if (g_bFullscreen){
+        Render_Invalidate(g_RenderHistory);
+    }
 
-void Update_GameOver() 
-{ 
-	if (GetAsyncKeyState(VK_SPACE) & 0x8000) { 
-		g_bSpaceKeyWasDown = TRUE; 
-	}else{ 
-		if (g_bSpaceKeyWasDown) { 
-			g_eGameState = STATE_TITLE; g_bSpaceKeyWasDown = FALSE; 
-		} 
-	} 
-
-	if (GetAsyncKeyState(VK_ESCAPE) & 0x8000){
-		PostMessage(g_hwnd, WM_CLOSE, 0, 0); 
-	}
-}
+    Render_Begin(g_RenderList);
+    Render_World(g_RenderList, g_DrawWorld);
+    Ghost_Draw(g_RenderList, g_DrawWorld, g_DrawGhost);
+
+    PROFILE_BEGIN(PROF_TEXT);
+    Hud_Build(g_Hud, g_RenderList, g_DrawWorld);
+    PROFILE_END(PROF_TEXT);
 
-void Draw_GameOver() 
-{ 
-	HDC hdc; char szBuffer[128]; 
-	Draw_Rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 80, 0, 0); 
-
-	if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))) { 
-		SetBkMode(hdc, TRANSPARENT); 
-		SetTextColor(hdc, RGB(255, 0, 0)); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 - 80, "Q[I[o[", lstrlen("Q[I[o[")); 
-		SetTextColor(hdc, RGB(255, 255, 255)); 
-		wsprintf(szBuffer, "ŏIXRAF%d", g_dwScore); TextOut(hdc, SCREEN_WIDTH / 2 - 110, SCREEN_HEIGHT / 2 - 40, szBuffer, lstrlen(szBuffer)); 
-		wsprintf(szBuffer, "nCXRAF%d", g_dwHighScore); TextOut(hdc, SCREEN_WIDTH / 2 - 90, SCREEN_HEIGHT / 2 - 20, szBuffer, lstrlen(szBuffer)); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 125, SCREEN_HEIGHT / 2 + 30, "Xy[XL[ ^Cg", lstrlen("Xy[XL[ ^Cg")); 
-		TextOut(hdc, SCREEN_WIDTH / 2 - 115, SCREEN_HEIGHT / 2 + 60, "ESCL[ Q[", lstrlen("ESCL[ Q[")); 
-		g_pDDSBack->ReleaseDC(hdc); 
-	} 
-	
-	Flip_To_Screen(); 
+    // `ĂrŃT[tFXꂽÃt[͕\ʂɏo܂
+    // (蒼ȂƂ g_pDDSPrimary  NULL ɂȂĂ܂)
+    if (Draw_RenderList()){
+        Flip_To_Screen();
+    }
 }
 
 //=============================================================================
 //  [eBeB֐ (⏕Iȕ֗֐)
 //=============================================================================
-void Draw_Rect(int x, int y, int w, int h, int r, int g, int b) 
-{ 
-	HDC hdc; 
+//-----------------------------------------------------------------------------
+// Draw_RenderList֐ - `惊Xg̎lp`ƕAɂ܂Ƃ߂ĕ`܂
+//   (1񂾂 Lock āA\tgEFAŒڃɏ݂܂B
+//    Õt[ς̈悾`AςĂȂ Lock ܂)
+//   rŃT[tFXĕ`ȂƂ FALSE Ԃ܂
+//-----------------------------------------------------------------------------
+BOOL Draw_RenderList()
+{
+	int i;
+	DDSURFACEDESC ddsd;
+	PROFILE_SCOPE(PROF_RECTS);
+
+#ifdef PROFILER_ENABLED
+	// Ԃ̃OtA`惊Xgɐςňꏏɓh܂
+	if (g_bShowProfiler) {
+		Profiler_DrawOverlay(g_RenderList, g_FrameArena);
+	}
+#endif
 
-	if (SUCCEEDED(g_pDDSBack->GetDC(&hdc))) { 
+	if (Render_FindDirty(g_RenderHistory, g_RenderList, &g_Font, SCREEN_WIDTH, SCREEN_HEIGHT) == 0) {
+		return TRUE;
+	}
 
-		RECT rc = { x, y, x + w, y + h }; 
+	if (g_ddpfBack.dwRGBBitCount == 32) {
+		HRESULT hr;
+		ZeroMemory(&ddsd, sizeof(ddsd));
+		ddsd.dwSize = sizeof(ddsd);
 
-		COLORREF color = RGB(r, g, b); 
-		HBRUSH hBrush = CreateSolidBrush(color); 
-		FillRect(hdc, &rc, hBrush); 
-		DeleteObject(hBrush); 
-		g_pDDSBack->ReleaseDC(hdc); 
+		hr = g_pDDSBack->Lock(NULL, &ddsd, DDLOCK_WAIT, NULL);
+		if (hr == DDERR_SURFACELOST) {
+			Restore_Surfaces();
+			return FALSE;
+		}
+		if (SUCCEEDED(hr)) {
+			Framebuffer fb;
+			fb.pixels = (unsigned int*)ddsd.lpSurface;
+			fb.width  = (int)ddsd.dwWidth;
+			fb.height = (int)ddsd.dwHeight;
+			fb.pitch  = (int)(ddsd.lPitch / 4);
+			Render_FlushDirty(g_RenderList, fb, &g_Font, g_RenderHistory);
+			g_pDDSBack->Unlock(NULL);
+			return TRUE;
+		}
+	}
+
+	// 32rbgȊỎʂł́ADirectDraw ̓hԂ@\1h܂
+	// (F g_DDCache ɕϊς݂̕ĝŁADC FvZ肵܂B
+	//  hԂ@\ł͔ɂłȂ̂ŁAS[XgȂǂ̔̎lp`́A
+	//  h炸1sNZ̘g`܂BhĂ܂ƁAdȂvC[B܂)
+	for (i = 0; i < g_RenderList.count; i++) {
+		const RenderRect& rc = g_RenderList.rects[i];
+		LPDDBLTFX lpFill = (LPDDBLTFX)DDCache_Fill(g_DDCache, rc.color & ~RENDER_BLEND);
+		RECT rcParts[4];
+		int nParts, p, d;
+
+		if (rc.color & RENDER_BLEND) {
+			SetRect(&rcParts[0], rc.x,            rc.y,            rc.x + rc.w, rc.y + 1);              // 
+			SetRect(&rcParts[1], rc.x,            rc.y + rc.h - 1, rc.x + rc.w, rc.y + rc.h);           // 
+			SetRect(&rcParts[2], rc.x,            rc.y + 1,        rc.x + 1,    rc.y + rc.h - 1);       // 
+			SetRect(&rcParts[3], rc.x + rc.w - 1, rc.y + 1,        rc.x + rc.w, rc.y + rc.h - 1);       // E
+			nParts = 4;
+		} else {
+			SetRect(&rcParts[0], rc.x, rc.y, rc.x + rc.w, rc.y + rc.h);
+			nParts = 1;
+		}
+
+		for (p = 0; p < nParts; p++) {
+			for (d = 0; d < g_RenderHistory.dirtyCount; d++) {
+				const DirtyRect& dirty = g_RenderHistory.dirty[d];
+				RECT rcDirty = { dirty.left, dirty.top, dirty.right, dirty.bottom };
+				RECT rcDest;
+				if (IntersectRect(&rcDest, &rcParts[p], &rcDirty)) {
+					if (g_pDDSBack->Blt(&rcDest, NULL, NULL, DDBLT_COLORFILL | DDBLT_WAIT, lpFill) == DDERR_SURFACELOST) {
+						Restore_Surfaces();
+						return FALSE;
+					}
+				}
+			}
+		}
+	}
 
+	// ʃɒڂ͏Ȃ̂ŁÂƂ GDI ŕ`܂
+	// (`̈̊Oɕ`Ă͂܂Bwih蒼ĂȂ TRANSPARENT 
+	//  d˕`ƁAȂ߂炩ȕ (ClearType Ȃ) ̂ӂ̔̕t[ZȂ܂B
+	//  ŁA`̈悾ɕ`悤ɁADC ̈Ő؂蔲 (Nbv) `܂)
+	HDC hdc;
+	if (g_RenderList.textCount > 0 && SUCCEEDED(g_pDDSBack->GetDC(&hdc))) {
+		HRGN hClip = CreateRectRgn(0, 0, 0, 0);
+		for (i = 0; i < g_RenderHistory.dirtyCount; i++) {
+			const DirtyRect& dirty = g_RenderHistory.dirty[i];
+			HRGN hRect = CreateRectRgn(dirty.left, dirty.top, dirty.right, dirty.bottom);
+			CombineRgn(hClip, hClip, hRect, RGN_OR);
+			DeleteObject(hRect);
+		}
+		SelectClipRgn(hdc, hClip);     // (DC ͗̈̎ʂ̂ŁAɏĂ܂܂)
+		DeleteObject(hClip);
+
+		SetBkMode(hdc, TRANSPARENT);
+		for (i = 0; i < g_RenderList.textCount; i++) {
+			const RenderText& rt = g_RenderList.texts[i];
+			SetTextColor(hdc, RGB((rt.color >> 16) & 0xFF, (rt.color >> 8) & 0xFF, rt.color & 0xFF));
+			TextOut(hdc, rt.x, rt.y, rt.text, lstrlen(rt.text));
+		}
+		SelectClipRgn(hdc, NULL);
+		g_pDDSBack->ReleaseDC(hdc);
 	}
+	return TRUE;
 }
 
-//=============================================================================
-//  Xe[WJnEQ[Zbg̏ (ǂ̏zuC)
-//=============================================================================
-void StartNextStage()
+//-----------------------------------------------------------------------------
+// Q[ŎgF (render.cpp ƓF)BT[tFXƂɁAɕϊĂ܂
+//-----------------------------------------------------------------------------
+static const unsigned int s_GameColors[] = {
+	RENDER_RGB(0, 0, 100),      // 
+	RENDER_RGB(139, 69, 19),    // n
+	RENDER_RGB(0, 200, 0),      // 
+	RENDER_RGB(255, 255, 0),    // vC[
+	RENDER_RGB(0, 0, 80),       // ^Cg
+	RENDER_RGB(0, 80, 0),       // Xe[WNA
+	RENDER_RGB(100, 100, 0),    // Q[NA
+	RENDER_RGB(80, 0, 0)        // Q[I[o[
+};
+
+//-----------------------------------------------------------------------------
+// Center_Window֐ - ʂ`傤ǃQ[̑傫ɂȂ悤ɂāAEBhEʂ̒ɒu܂
+//-----------------------------------------------------------------------------
+void Center_Window(HWND hwnd)
 {
-    int i;
-    g_nCurrentStage++;
-    if ((DWORD)g_nCurrentStage >= MAX_STAGES)
-    {
-        if (g_dwScore > g_dwHighScore) { g_dwHighScore = g_dwScore; }
-        g_eGameState = STATE_GAME_CLEAR;
-    }
-    else
-    {
-        g_dwCurrentStageScore = 0;
-        g_Player.state = PSTATE_NORMAL;
-        g_Player.x = 100; g_Player.y = GROUND_Y - PLAYER_SIZE; g_Player.vy = 0; g_Player.onGround = TRUE;
-        
-        int current_x = 0;
-        for(i=0; i < NUM_GROUND_SEGMENTS; i++)
-        {
-            g_GroundSegments[i].x = (float)current_x;
-            g_GroundSegments[i].isPit = FALSE;
-            g_GroundSegments[i].width = 200 + rand() % 100;
-            current_x += g_GroundSegments[i].width;
-        }
+	RECT wr = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+	AdjustWindowRectEx(&wr, (DWORD)GetWindowLong(hwnd, GWL_STYLE), FALSE, (DWORD)GetWindowLong(hwnd, GWL_EXSTYLE));
 
-        g_Obstacles[0].active = TRUE; g_Obstacles[0].scored = FALSE; g_Obstacles[0].height = 30 + rand() % 50;
-        g_Obstacles[0].x = (float)SCREEN_WIDTH + 100.0f;
-        for (i = 1; i < MAX_OBSTACLES; i++)
-        {
-            g_Obstacles[i].active = TRUE; g_Obstacles[i].scored = FALSE; g_Obstacles[i].height = 30 + rand() % 50;
-            g_Obstacles[i].x = g_Obstacles[i-1].x + (float)(250 + rand() % 150);
-        }
-        g_eGameState = STATE_PLAYING;
-    }
+	int w = wr.right - wr.left, h = wr.bottom - wr.top;
+	SetWindowPos(hwnd, HWND_NOTOPMOST, (GetSystemMetrics(SM_CXSCREEN) - w) / 2, (GetSystemMetrics(SM_CYSCREEN) - h) / 2, w, h, SWP_FRAMECHANGED);
 }
 
-void Reset_Game()
+//-----------------------------------------------------------------------------
+// Init_Display֐ - SʂEBhE߂āAT[tFX܂
+//   (SʂɂłȂƂ́AEBhEɖ߂đ܂)
+//-----------------------------------------------------------------------------
+BOOL Init_Display(HWND hwnd)
 {
-    g_dwScore = 0; 
-	g_dwCurrentStageScore = 0; 
-	g_nPlayerLives = 3; 
-	g_nCurrentStage = -1; 
-	g_bSpaceKeyWasDown = TRUE; 
-	StartNextStage();
+	HRESULT hr;
+
+	// S: ʂƂ߂āAQ[Ɠ傫̉ʃ[hɐ؂ւ܂
+	// (32rbg̉ʂɂłȂ 16rbgɂ܂B32rbgȂ璼ڃɕ`܂)
+	if (g_bFullscreen) {
+		hr = g_pDD->SetCooperativeLevel(hwnd, DDSCL_EXCLUSIVE | DDSCL_FULLSCREEN | DDSCL_MULTITHREADED);
+		if (SUCCEEDED(hr)) {
+			hr = g_pDD->SetDisplayMode(SCREEN_WIDTH, SCREEN_HEIGHT, 32);
+			if (FAILED(hr)) {
+				hr = g_pDD->SetDisplayMode(SCREEN_WIDTH, SCREEN_HEIGHT, 16);
+			}
+		}
+		if (SUCCEEDED(hr) && Create_Surfaces()) {
+			ShowCursor(FALSE);
+			return TRUE;
+		}
+
+		g_pDD->RestoreDisplayMode();
+		g_bFullscreen = FALSE;
+		SetWindowLong(hwnd, GWL_EXSTYLE, 0);
+		SetWindowLong(hwnd, GWL_STYLE, WINDOWED_STYLE | WS_VISIBLE);
+		Center_Window(hwnd);
+	}
+
+	// EBhE: fXNgbv̉ʂ̂܂܁ANbp[ (͂ݏoh~) tăEBhE̒ɕ`܂
+	hr = g_pDD->SetCooperativeLevel(hwnd, DDSCL_NORMAL | DDSCL_MULTITHREADED); if (FAILED(hr)) { return FALSE; }
+	hr = g_pDD->CreateClipper(0, &g_pDDClipper, NULL); if (FAILED(hr)) { return FALSE; }
+	hr = g_pDDClipper->SetHWnd(0, hwnd); if (FAILED(hr)) { return FALSE; }
+	return Create_Surfaces();
 }
 
+//-----------------------------------------------------------------------------
+// Create_Surfaces֐ - \ʂƗA̐F̌`œhԂ̐Fpӂ܂
+//-----------------------------------------------------------------------------
+BOOL Create_Surfaces()
+{
+	HRESULT hr;
+	int i;
+	DDSURFACEDESC ddsd;
+
+	ZeroMemory(&ddsd, sizeof(ddsd));
+	ddsd.dwSize = sizeof(ddsd);
+
+	if (g_bFullscreen) {
+		// \ʂƗAFlip œւ1g (tbv`F[) Ƃč܂
+		DDSCAPS ddscaps;
+		ddsd.dwFlags = DDSD_CAPS | DDSD_BACKBUFFERCOUNT;
+		ddsd.ddsCaps.dwCaps = DDSCAPS_PRIMARYSURFACE | DDSCAPS_FLIP | DDSCAPS_COMPLEX;
+		ddsd.dwBackBufferCount = FULLSCREEN_BACK_BUFFERS;
+		hr = g_pDD->CreateSurface(&ddsd, &g_pDDSPrimary, NULL); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
+
+		ZeroMemory(&ddscaps, sizeof(ddscaps));
+		ddscaps.dwCaps = DDSCAPS_BACKBUFFER;
+		hr = g_pDDSPrimary->GetAttachedSurface(&ddscaps, &g_pDDSBack); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
+	} else {
+		// EBhÊƂ́A\ʂƂ͕ʂɗAς\ʂɎʂ܂
+		ddsd.dwFlags = DDSD_CAPS;
+		ddsd.ddsCaps.dwCaps = DDSCAPS_PRIMARYSURFACE;
+		hr = g_pDD->CreateSurface(&ddsd, &g_pDDSPrimary, NULL); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
+
+		ddsd.dwFlags = DDSD_CAPS | DDSD_WIDTH | DDSD_HEIGHT;
+		ddsd.ddsCaps.dwCaps = DDSCAPS_OFFSCREENPLAIN;
+		ddsd.dwWidth = SCREEN_WIDTH;
+		ddsd.dwHeight = SCREEN_HEIGHT;
+		hr = g_pDD->CreateSurface(&ddsd, &g_pDDSBack, NULL); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
+
+		hr = g_pDDSPrimary->SetClipper(g_pDDClipper); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
+	}
+
+	// ̐F̌`𒲂ׂĂ܂ (32rbgȂAڃɕ`܂)
+	ZeroMemory(&g_ddpfBack, sizeof(g_ddpfBack));
+	g_ddpfBack.dwSize = sizeof(g_ddpfBack);
+	hr = g_pDDSBack->GetPixelFormat(&g_ddpfBack); if (FAILED(hr)) { Release_Surfaces(); return FALSE; }
 
+	DDCache_Init(g_DDCache, g_ddpfBack);
+	for (i = 0; i < (int)(sizeof(s_GameColors) / sizeof(s_GameColors[0])); i++) {
+		DDCache_AddColor(g_DDCache, s_GameColors[i]);
+	}
+
+	// V̒g͋Ȃ̂ŁÃt[őŜ`܂
+	Render_Invalidate(g_RenderHistory);
+	return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+// Release_Surfaces֐ - \ʂƗЕt܂
+//-----------------------------------------------------------------------------
+void Release_Surfaces()
+{
+	if (g_pDDSBack)    { g_pDDSBack->Release();    g_pDDSBack = NULL;    }
+	if (g_pDDSPrimary) { g_pDDSPrimary->Release(); g_pDDSPrimary = NULL; }
+	DDCache_Shutdown(g_DDCache);
+}
+
+//-----------------------------------------------------------------------------
+// Restore_Surfaces֐ - ꂽT[tFX߂܂
+//   (ق̃AvʂSgƂȂǂ́AT[tFX̃̂Ă
+//    DDERR_SURFACELOST ԂĂ܂BRestore Ŏ߂̒g͉Ă̂ŁA
+//    ̃t[őŜ`܂Bʂ̐FςĂ蒼܂)
+//-----------------------------------------------------------------------------
+BOOL Restore_Surfaces()
+{
+	HRESULT hrPrimary, hrBack;
+
+	Render_Invalidate(g_RenderHistory);
+	hrPrimary = g_pDDSPrimary->Restore();
+	hrBack = g_bFullscreen ? DD_OK : g_pDDSBack->Restore();    // Sʂ̗́A\ʂƈꏏɖ߂܂
+	if (hrPrimary == DDERR_WRONGMODE || hrBack == DDERR_WRONGMODE) {
+		Release_Surfaces();
+		return Create_Surfaces();
+	}
+	return SUCCEEDED(hrPrimary) && SUCCEEDED(hrBack);
+}
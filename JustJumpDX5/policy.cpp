@@ -0,0 +1,89 @@
+//=============================================================================
+//
+//  wWXgWv DX5x vC (ǂăXy[XL[)
+//
+//=============================================================================
+#include <string.h>
+#include "input.h"
+#include "policy.h"
+
+//=============================================================================
+//  Policy_Init֐ - vC̕jƁA̎߂܂
+//=============================================================================
+void Policy_Init(PolicyState& state, Policy policy, unsigned long seed)
+{
+    state.policy = policy;
+    state.lookAhead = SCALAR_CONST(40.0f);
+    state.jumpOneIn = 8;
+    state.jumpWasDown = false;
+    Rng_Seed(state.rng, seed, POLICY_RNG_STREAM);
+}
+
+//=============================================================================
+//  Policy_Choose֐ - vC̕jɏ]āA1t[̓͂܂
+//=============================================================================
+InputFrame Policy_Choose(PolicyState& state, const World& world, unsigned long frame)
+{
+    int i;
+    InputFrame input;
+    input.jump = false;
+    input.escape = false;
+
+    // ^CgNAʂł́AJԂĐɐi݂܂
+    if (world.gameState != STATE_PLAYING){
+        input.jump = (frame % 2) == 0;
+        Input_SetEdges(input, state.jumpWasDown);
+        return input;
+    }
+
+    switch (state.policy){
+        case POLICY_AUTO:
+        {
+            const Player& player = world.player;
+
+            for (i = 0; i < world.obstacleCount; i++){
+                Scalar x = Sim_ScreenX(world, world.obstacleX[Sim_ObstacleSlot(world, i)]);
+                if (x > player.x && x - (player.x + Scalar_FromInt(PLAYER_SIZE)) < state.lookAhead){ input.jump = true; }
+            }
+            for (i = 0; i < NUM_GROUND_SEGMENTS; i++){
+                const GroundSegment& seg = Sim_GroundAt(world, i);
+                Scalar x = Sim_ScreenX(world, seg.x);
+                if (seg.isPit && x > player.x && x - (player.x + Scalar_FromInt(PLAYER_SIZE)) < SCALAR_CONST(10.0f)){ input.jump = true; }
+            }
+
+            // 󒆂ł͗Ă܂ (Wv͉uԂȂ̂ŁAnx悤)
+            if (!player.onGround){ input.jump = false; }
+            break;
+        }
+        case POLICY_RANDOM:
+            // Q[{̂ƓvZ̗ł (Q[̗Ƃ͕ʂɐi݂܂)
+            input.jump = Rng_Range(state.rng, state.jumpOneIn) == 0;
+            break;
+        case POLICY_IDLE:
+            break;
+    }
+    Input_SetEdges(input, state.jumpWasDown);
+    return input;
+}
+
+//=============================================================================
+//  Policy_FromName / Policy_Name֐ - jƖO ("auto" Ȃ) ϊ܂
+//=============================================================================
+bool Policy_FromName(const char* name, Policy& policy)
+{
+    if      (strcmp(name, "auto")   == 0) policy = POLICY_AUTO;
+    else if (strcmp(name, "random") == 0) policy = POLICY_RANDOM;
+    else if (strcmp(name, "idle")   == 0) policy = POLICY_IDLE;
+    else return false;
+    return true;
+}
+
+const char* Policy_Name(Policy policy)
+{
+    switch (policy){
+        case POLICY_AUTO:   return "auto";
+        case POLICY_RANDOM: return "random";
+        case POLICY_IDLE:   return "idle";
+    }
+    return "?";
+}
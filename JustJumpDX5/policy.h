@@ -0,0 +1,42 @@
+//=============================================================================
+//
+//  wWXgWv DX5x vC (ǂăXy[XL[)
+//
+//  wbhXłAՓxp̂܂Ƃ߂Ďsc[ŁAl̑
+//  Q[V΂邽߂̓͂܂B
+//   PolicyState ̒Ɏ̃Xg[Ă̂ŁA{̃Q[ʁX̃Xbh
+//  ɓĂA݂ɉe܂B
+//
+//=============================================================================
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "sim.h"
+
+// vC̗̃Xg[ԍ (Q[E RngStream ƏdȂȂԍɂ܂)
+#define POLICY_RNG_STREAM   0x100
+
+enum Policy{
+    POLICY_AUTO,     // ڂ̑Oɕǂ◎ƂWv
+    POLICY_RANDOM,   // ł߂ɃWv
+    POLICY_IDLE      // Ȃ
+};
+
+struct PolicyState
+{
+    Policy        policy;
+    Scalar        lookAhead;     // AUTO: ǂ̋ (sNZ) ܂ŋ߂ÂWv
+    int           jumpOneIn;     // RANDOM: 1/jumpOneIn ̊mŃWv
+    Rng           rng;           // RANDOM Ŏg (Q[E̗Ƃ͕ʂ̃Xg[ł)
+    bool          jumpWasDown;   // Õt[ŃXy[XL[Ă (uԂ̂Ɏg܂)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void        Policy_Init(PolicyState& state, Policy policy, unsigned long seed);
+InputFrame  Policy_Choose(PolicyState& state, const World& world, unsigned long frame);
+bool        Policy_FromName(const char* name, Policy& policy);
+const char* Policy_Name(Policy policy);
+
+#endif // POLICY_H
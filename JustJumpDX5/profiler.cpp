@@ -0,0 +1,316 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Ԃ̌v (vt@C)
+//
+//  L^ނ̂̓Q[̃XbhłBIt[̐
+//  (s_Published) ŌɍXV̂ŁAǂޑ̓bNȂŁAI
+//  t[Sɓǂݎ܂B
+//
+//=============================================================================
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+#include "render.h"
+#include "arena.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏgϐ
+//-----------------------------------------------------------------------------
+static double      s_MicrosecondsPerTick = 1.0;
+static ProfTicks   s_Origin;                              // vn߂ (o̊)
+static ProfFrame   s_Current;                             // ṽt[
+static ProfTicks   s_Open[PROF_SECTION_COUNT];            // v̋Ԃn܂
+static ProfFrame   s_Ring[PROF_RING_FRAMES];              // It[
+static volatile long s_Published;                         // ܂łɏIt[̐
+
+static const char* s_SectionNames[PROF_SECTION_COUNT] = { "update", "rects", "text", "flip" };
+
+// ʕ\ł̋ԂƂ̐F
+static const unsigned int s_SectionColors[PROF_SECTION_COUNT] =
+{
+    RENDER_RGB(255, 80, 80), RENDER_RGB(80, 220, 80), RENDER_RGB(90, 140, 255), RENDER_RGB(255, 220, 60)
+};
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static long Profiler_LoadPublished();
+static void Profiler_StorePublished(long n);
+
+//=============================================================================
+//  Profiler_Init֐ - ^C}[̐x𒲂ׂāAL^ɂ܂
+//=============================================================================
+void Profiler_Init()
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    if (QueryPerformanceFrequency(&freq) && freq.QuadPart > 0){
+        s_MicrosecondsPerTick = 1e6 / (double)freq.QuadPart;
+    }
+#else
+    s_MicrosecondsPerTick = 1e-3;   // clock_gettime ̓imbP
+#endif
+    memset(&s_Current, 0, sizeof(s_Current));
+    memset(s_Open, 0, sizeof(s_Open));
+    Profiler_StorePublished(0);
+    s_Origin = Profiler_Now();
+}
+
+//=============================================================================
+//  Profiler_Now֐ - x^C}[̍̒lԂ܂
+//=============================================================================
+ProfTicks Profiler_Now()
+{
+#ifdef _WIN32
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (ProfTicks)now.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ProfTicks)ts.tv_sec * 1000000000ULL + (ProfTicks)ts.tv_nsec;
+#endif
+}
+
+// ^C}[̒l̍}CNbɒ܂
+double Profiler_TicksToMicroseconds(ProfTicks ticks)
+{
+    return (double)ticks * s_MicrosecondsPerTick;
+}
+
+//=============================================================================
+//  t[ƋԂ̌v
+//=============================================================================
+void Profiler_BeginFrame()
+{
+    memset(&s_Current, 0, sizeof(s_Current));
+    s_Current.start = Profiler_Now();
+}
+
+// vt[Oobt@ɏ݁AǂޑɌ悤ɂ܂
+void Profiler_EndFrame(int simTicks, int gameState)
+{
+    s_Current.end = Profiler_Now();
+    s_Current.simTicks = simTicks;
+    s_Current.gameState = gameState;
+
+    long n = Profiler_LoadPublished();
+    s_Ring[n & (PROF_RING_FRAMES - 1)] = s_Current;
+    Profiler_StorePublished(n + 1);
+}
+
+void Profiler_Begin(ProfSection section)
+{
+    ProfTicks now = Profiler_Now();
+    s_Open[section] = now;
+    if (s_Current.begin[section] == 0){
+        s_Current.begin[section] = now;
+    }
+}
+
+void Profiler_End(ProfSection section)
+{
+    s_Current.ticks[section] += Profiler_Now() - s_Open[section];
+}
+
+// ق̃XbhőԂÃt[̋Ԃɑ܂
+// (n܂͂킩Ȃ̂ŁAg[Xł̓t[̍ŏn܂Ƃɂ܂)
+void Profiler_Add(ProfSection section, double microseconds)
+{
+    if (s_Current.begin[section] == 0){
+        s_Current.begin[section] = s_Current.start;
+    }
+    s_Current.ticks[section] += (ProfTicks)(microseconds / s_MicrosecondsPerTick);
+}
+
+//=============================================================================
+//  Profiler_Snapshot֐ - ŐV maxFrames t[̋L^AÂ out Ɏʂ܂
+//   (ʂĂԂɏ㏑Ă܂t[͎̂Ă܂BʂԂ܂)
+//=============================================================================
+int Profiler_Snapshot(ProfFrame* out, int maxFrames)
+{
+    int i;
+    long last = Profiler_LoadPublished();
+    long count = last < maxFrames ? last : maxFrames;
+    if (count > PROF_RING_FRAMES) count = PROF_RING_FRAMES;
+
+    long first = last - count;
+    for (i = 0; i < count; i++){
+        out[i] = s_Ring[(first + i) & (PROF_RING_FRAMES - 1)];
+    }
+
+    // ʂĂԂɏ܂ꂽAÂق㏑Ă܂
+    long overwritten = Profiler_LoadPublished() - PROF_RING_FRAMES - first;
+    if (overwritten > 0){
+        if (overwritten > count) overwritten = count;
+        memmove(out, out + overwritten, (count - overwritten) * sizeof(ProfFrame));
+        count -= overwritten;
+    }
+    return (int)count;
+}
+
+//=============================================================================
+//  Profiler_DrawOverlay֐ - Ԃ̃Ot`惊Xgɐς݂܂
+//   : ŋ߂̃t[Ƃ̐ςݏグ_Ot (FԁA 16ms)
+//   : t[Ԃ̕z ( 0`32msA1ms )
+//   (ʂL^ƕρEő́̕Ãt[̊ԂĝŃA[iɒu܂)
+//=============================================================================
+#define OVERLAY_FRAMES      120
+#define OVERLAY_X           (SCREEN_WIDTH - OVERLAY_FRAMES * 2 - 10)
+#define OVERLAY_Y           60
+#define OVERLAY_PX_PER_MS   3
+#define OVERLAY_MAX_MS      32
+#define OVERLAY_HIST_H      40
+
+void Profiler_DrawOverlay(RenderList& list, FrameArena& arena)
+{
+    int histogram[OVERLAY_MAX_MS + 1];
+    int i, s;
+    double sumUs = 0, maxUs = 0;
+
+    ProfFrame* frames = (ProfFrame*)Arena_Alloc(arena, sizeof(ProfFrame) * OVERLAY_FRAMES);
+    if (frames == NULL){
+        return;
+    }
+    int count = Profiler_Snapshot(frames, OVERLAY_FRAMES);
+    int graphH = OVERLAY_MAX_MS * OVERLAY_PX_PER_MS;
+    int bottom = OVERLAY_Y + graphH;
+
+    // wi 16ms ̐
+    Render_Rect(list, OVERLAY_X - 4, OVERLAY_Y - 4, OVERLAY_FRAMES * 2 + 8, graphH + OVERLAY_HIST_H + 14, 0, 0, 0);
+    Render_Rect(list, OVERLAY_X, bottom - 16 * OVERLAY_PX_PER_MS, OVERLAY_FRAMES * 2, 1, 255, 255, 255);
+
+    memset(histogram, 0, sizeof(histogram));
+    for (i = 0; i < count; i++){
+        const ProfFrame& f = frames[i];
+        int x = OVERLAY_X + (OVERLAY_FRAMES - count + i) * 2;
+        int y = bottom;
+
+        for (s = 0; s < PROF_SECTION_COUNT; s++){
+            int h = (int)(Profiler_TicksToMicroseconds(f.ticks[s]) * OVERLAY_PX_PER_MS / 1000.0 + 0.5);
+            if (y - h < OVERLAY_Y) h = y - OVERLAY_Y;
+            if (h <= 0) continue;
+            y -= h;
+            Render_Rect(list, x, y, 2, h, (s_SectionColors[s] >> 16) & 0xFF, (s_SectionColors[s] >> 8) & 0xFF, s_SectionColors[s] & 0xFF);
+        }
+
+        double us = Profiler_TicksToMicroseconds(f.end - f.start);
+        int ms = (int)(us / 1000.0);
+        histogram[ms < OVERLAY_MAX_MS ? ms : OVERLAY_MAX_MS]++;
+        sumUs += us;
+        if (us > maxUs) maxUs = us;
+    }
+
+    // t[Ԃ̕z
+    int peak = 1;
+    for (i = 0; i <= OVERLAY_MAX_MS; i++) if (histogram[i] > peak) peak = histogram[i];
+    int histBottom = bottom + 8 + OVERLAY_HIST_H;
+    int barW = (OVERLAY_FRAMES * 2) / (OVERLAY_MAX_MS + 1);
+    for (i = 0; i <= OVERLAY_MAX_MS; i++){
+        int h = histogram[i] * OVERLAY_HIST_H / peak;
+        Render_Rect(list, OVERLAY_X + i * barW, histBottom - h, barW - 1, h, i < 16 ? 120 : 255, i < 16 ? 200 : 90, 120);
+    }
+
+    // t[Ԃ̕ςƍő (}CNb)
+    if (count > 0){
+        Render_Text(list, OVERLAY_X, OVERLAY_Y, Arena_Format(arena, "avg %ld  max %ld us", (long)(sumUs / count), (long)maxUs, 0), 255, 255, 255);
+    }
+}
+
+//=============================================================================
+//  Profiler_WriteCSV֐ - cĂL^ CSV (\vZ\tgŊJ`) ŏo܂
+//   (Ԃׂ͂ă}CNbł)
+//=============================================================================
+bool Profiler_WriteCSV(const char* path)
+{
+    static ProfFrame frames[PROF_RING_FRAMES];
+    int i, s;
+    int count = Profiler_Snapshot(frames, PROF_RING_FRAMES);
+
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL){
+        return false;
+    }
+
+    fprintf(fp, "frame,start_us,interval_us,frame_us");
+    for (s = 0; s < PROF_SECTION_COUNT; s++) fprintf(fp, ",%s_us", s_SectionNames[s]);
+    fprintf(fp, ",sim_ticks,game_state\n");
+
+    for (i = 0; i < count; i++){
+        const ProfFrame& f = frames[i];
+        fprintf(fp, "%d,%.1f,%.1f,%.1f", i,
+                Profiler_TicksToMicroseconds(f.start - s_Origin),
+                i > 0 ? Profiler_TicksToMicroseconds(f.start - frames[i - 1].start) : 0.0,
+                Profiler_TicksToMicroseconds(f.end - f.start));
+        for (s = 0; s < PROF_SECTION_COUNT; s++) fprintf(fp, ",%.1f", Profiler_TicksToMicroseconds(f.ticks[s]));
+        fprintf(fp, ",%d,%d\n", f.simTicks, f.gameState);
+    }
+    return fclose(fp) == 0;
+}
+
+//=============================================================================
+//  Profiler_WriteTrace֐ - cĂL^ Chrome ̃g[X` (JSON) ŏo܂
+//   (Ԃ̒ŉxvƂ́AŏɎn܂獇v̒1{̑тɂ܂)
+//=============================================================================
+bool Profiler_WriteTrace(const char* path)
+{
+    static ProfFrame frames[PROF_RING_FRAMES];
+    int i, s;
+    int count = Profiler_Snapshot(frames, PROF_RING_FRAMES);
+
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL){
+        return false;
+    }
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (i = 0; i < count; i++){
+        const ProfFrame& f = frames[i];
+        fprintf(fp, "%s{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f,\"args\":{\"sim_ticks\":%d,\"game_state\":%d}}",
+                i > 0 ? ",\n" : "",
+                Profiler_TicksToMicroseconds(f.start - s_Origin), Profiler_TicksToMicroseconds(f.end - f.start),
+                f.simTicks, f.gameState);
+        for (s = 0; s < PROF_SECTION_COUNT; s++){
+            if (f.begin[s] == 0) continue;
+            fprintf(fp, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f}", s_SectionNames[s],
+                    Profiler_TicksToMicroseconds(f.begin[s] - s_Origin), Profiler_TicksToMicroseconds(f.ticks[s]));
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    return fclose(fp) == 0;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// It[̐ǂݏ܂BƂ́At[̒gIĂ
+// 𑝂₷ƂAق̃XbhԂŌ悤ɂ܂
+static long Profiler_LoadPublished()
+{
+#ifdef _WIN32
+    return InterlockedExchangeAdd((LONG volatile*)&s_Published, 0);
+#else
+    return __atomic_load_n(&s_Published, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void Profiler_StorePublished(long n)
+{
+#ifdef _WIN32
+    InterlockedExchange((LONG volatile*)&s_Published, n);
+#else
+    __atomic_store_n(&s_Published, n, __ATOMIC_RELEASE);
+#endif
+}
+
+#endif // PROFILER_ENABLED
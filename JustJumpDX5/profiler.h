@@ -0,0 +1,112 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Ԃ̌v (vt@C)
+//
+//  1t[̒ŁAQ[̍XVElp`̓hԂE̕`Eʂւ̓]
+//  ꂼꉽ}CNbAx̃^C}[őċL^܂B
+//  (timeGetTime 1~bPʂȂ̂ŁAł͎g܂)
+//
+//  L^͍ŐV PROF_RING_FRAMES t[Oobt@ɎcA
+//  ʂɏd˂ĕ\AI CSV  Chrome ̃g[X` (chrome://tracing ŊJ܂)
+//  ɏoł܂B
+//
+//  [Xrh (NDEBUG `ĂƂ) ł́Ã}NSɂȂA
+//  v̏͂܂܂B[Xł肽Ƃ JJ_PROFILE `ĂB
+//
+//  g:
+//    PROFILE_BEGIN_FRAME();
+//    { PROFILE_SCOPE(PROF_UPDATE); ...Q[̍XV... }
+//    PROFILE_BEGIN(PROF_TEXT); ...̗p... PROFILE_END(PROF_TEXT);
+//    PROFILE_END_FRAME(ticks, gameState);
+//
+//  L^̂1̃Xbh (ʂ`Xbh) ̃t[łBق̃XbhőԂ́A
+//  PROFILE_ADD(, }CNb) ł̃Xbh`XbhɓnāÃt[ɑ܂B
+//
+//=============================================================================
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#if !defined(NDEBUG) || defined(JJ_PROFILE)
+    #define PROFILER_ENABLED
+#endif
+
+// v
+enum ProfSection{
+    PROF_UPDATE,        // Q[̍XV (Sim_Step)
+    PROF_RECTS,         // wiEnʁEǁEvC[̓hԂ
+    PROF_TEXT,          // ʂ̗̕p (Hud_Build)
+    PROF_FLIP,          // \ʂւ̓]
+    PROF_SECTION_COUNT
+};
+
+// t[̋L^c (2ׂ̂B60fps ł悻1)
+#define PROF_RING_FRAMES    4096
+
+// ^C}[̒l (VC6 ͕Ȃ64rbg double ɕϊłȂ̂ŁAtɂ܂)
+#ifdef _MSC_VER
+typedef __int64     ProfTicks;
+#else
+typedef long long   ProfTicks;
+#endif
+
+// 1t[̋L^
+struct ProfFrame
+{
+    ProfTicks start;                             // t[̊Jn
+    ProfTicks end;                               // t[̏I
+    ProfTicks begin[PROF_SECTION_COUNT];         // eԂŏɎn܂ (0 ȂʂȂ)
+    ProfTicks ticks[PROF_SECTION_COUNT];         // eԂɂԂ̍v
+    int       simTicks;                          // ̃t[Ői߂Q[̃t[
+    int       gameState;
+};
+
+#ifdef PROFILER_ENABLED
+
+struct RenderList;
+struct FrameArena;
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void      Profiler_Init();
+ProfTicks Profiler_Now();
+double    Profiler_TicksToMicroseconds(ProfTicks ticks);
+void      Profiler_BeginFrame();
+void      Profiler_EndFrame(int simTicks, int gameState);
+void      Profiler_Begin(ProfSection section);
+void      Profiler_End(ProfSection section);
+void      Profiler_Add(ProfSection section, double microseconds);
+int       Profiler_Snapshot(ProfFrame* out, int maxFrames);
+void      Profiler_DrawOverlay(RenderList& list, FrameArena& arena);
+bool      Profiler_WriteCSV(const char* path);
+bool      Profiler_WriteTrace(const char* path);
+
+// { } ̒v܂ (ƂɎŏI܂)
+struct ProfScope
+{
+    ProfSection section;
+    ProfScope(ProfSection s) : section(s) { Profiler_Begin(s); }
+    ~ProfScope()                          { Profiler_End(section); }
+};
+
+#define PROFILE_INIT()                      Profiler_Init()
+#define PROFILE_BEGIN_FRAME()               Profiler_BeginFrame()
+#define PROFILE_END_FRAME(simTicks, state)  Profiler_EndFrame((simTicks), (state))
+#define PROFILE_BEGIN(section)              Profiler_Begin(section)
+#define PROFILE_END(section)                Profiler_End(section)
+#define PROFILE_SCOPE(section)              ProfScope profScope_(section)
+#define PROFILE_ADD(section, microseconds)  Profiler_Add((section), (microseconds))
+
+#else
+
+#define PROFILE_INIT()
+#define PROFILE_BEGIN_FRAME()
+#define PROFILE_END_FRAME(simTicks, state)
+#define PROFILE_BEGIN(section)
+#define PROFILE_END(section)
+#define PROFILE_SCOPE(section)
+#define PROFILE_ADD(section, microseconds)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,401 @@
+//=============================================================================
+//
+//  wWXgWv DX5x \tgEFA` (܂Ƃߕ`)
+//
+//=============================================================================
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "render.h"
+#include "text.h"
+
+//-----------------------------------------------------------------------------
+//  ̓hԂɎg߂̑I
+//   (RpCΉĂ SIMD ߂ 4`8 sNZxɏ܂B
+//    Visual C++ 6.0 Ȃǂ̌ÂRpCł́Aʂ C++ 1sNZ܂)
+//-----------------------------------------------------------------------------
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RENDER_SPAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RENDER_SPAN_SSE2
+#endif
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void Render_FlushRegion(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font, const DirtyRect& region);
+static void Render_AddDirty(RenderHistory& history, int x, int y, int w, int h, int width, int height);
+static int  Render_TextWidth(const GlyphAtlas& font, const char* text);
+
+//=============================================================================
+//  Render_Begin֐ - `惊XgɂāAVt[n߂܂
+//=============================================================================
+void Render_Begin(RenderList& list)
+{
+    list.count = 0;
+    list.textCount = 0;
+}
+
+//=============================================================================
+//  Render_Rect֐ - hԂlp``惊Xgɒǉ܂
+//=============================================================================
+void Render_Rect(RenderList& list, int x, int y, int w, int h, int r, int g, int b)
+{
+    if (list.count >= MAX_RENDER_RECTS || w <= 0 || h <= 0){
+        return;
+    }
+
+    RenderRect& rc = list.rects[list.count++];
+    rc.x = x; rc.y = y; rc.w = w; rc.h = h;
+    rc.color = RENDER_RGB(r, g, b);
+}
+
+//=============================================================================
+//  Render_BlendRect֐ - ̐FƔēh () lp`A`惊Xgɒǉ܂
+//=============================================================================
+void Render_BlendRect(RenderList& list, int x, int y, int w, int h, int r, int g, int b)
+{
+    int count = list.count;
+    Render_Rect(list, x, y, w, h, r, g, b);
+    if (list.count > count){
+        list.rects[count].color |= RENDER_BLEND;
+    }
+}
+
+//=============================================================================
+//  Render_Text֐ - ``惊Xgɒǉ܂
+//=============================================================================
+void Render_Text(RenderList& list, int x, int y, const char* text, int r, int g, int b)
+{
+    if (list.textCount >= MAX_RENDER_TEXTS || text == NULL){
+        return;
+    }
+
+    RenderText& rt = list.texts[list.textCount++];
+    rt.x = x; rt.y = y;
+    rt.color = RENDER_RGB(r, g, b);
+    rt.text = text;
+}
+
+//=============================================================================
+//  Render_World֐ - Q[ȄԂAwiƕ̂̎lp``惊Xgɐς݂܂
+//   (͊܂݂܂)
+//=============================================================================
+void Render_World(RenderList& list, const World& world)
+{
+    int i;
+
+    switch (world.gameState){
+
+        case STATE_TITLE:
+            Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 80);
+            break;
+
+        case STATE_PLAYING:
+        {
+            // 
+            Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 100);
+
+            // n (Ƃ͕̕`܂Bʂ̉E[͕`ĂȂ̂őł؂܂)
+            for (i = 0; i < NUM_GROUND_SEGMENTS; i++){
+                const GroundSegment& seg = Sim_GroundAt(world, i);
+                int x = Scalar_ToInt(Sim_ScreenX(world, seg.x));
+                if (x >= SCREEN_WIDTH) break;
+                if (!seg.isPit) Render_Rect(list, x, GROUND_Y, seg.width, SCREEN_HEIGHT - GROUND_Y, 139, 69, 19);
+            }
+
+            // 
+            for (i = 0; i < world.obstacleCount; i++){
+                int slot = Sim_ObstacleSlot(world, i);
+                int x = Scalar_ToInt(Sim_ScreenX(world, world.obstacleX[slot]));
+                if (x >= SCREEN_WIDTH) break;
+                Render_Rect(list, x, GROUND_Y - world.obstacleHeight[slot], OBSTACLE_WIDTH, world.obstacleHeight[slot], 0, 200, 0);
+            }
+
+            // vC[ (̖GԒ͓_ł܂)
+            if (world.player.state == PSTATE_RESPAWNING){
+                if ((world.time / 100) % 2 == 0) Render_Rect(list, Scalar_ToInt(world.player.x), Scalar_ToInt(world.player.y), PLAYER_SIZE, PLAYER_SIZE, 255, 255, 0);
+            }else if (world.player.state != PSTATE_MISS){
+                Render_Rect(list, Scalar_ToInt(world.player.x), Scalar_ToInt(world.player.y), PLAYER_SIZE, PLAYER_SIZE, 255, 255, 0);
+            }
+            break;
+        }
+
+        case STATE_STAGE_CLEAR:
+            Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 80, 0);
+            break;
+
+        case STATE_GAME_CLEAR:
+            Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 100, 100, 0);
+            break;
+
+        case STATE_GAMEOVER:
+            Render_Rect(list, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 80, 0, 0);
+            break;
+    }
+}
+
+//=============================================================================
+//  Render_Flush֐ - `惊Xg̎lp`ς񂾏ɉʃ֓hȀɕ`܂
+//   (font  NULL ̂Ƃ͕`܂)
+//=============================================================================
+void Render_Flush(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font)
+{
+    DirtyRect all = { 0, 0, fb.width, fb.height };
+    Render_FlushRegion(list, fb, font, all);
+}
+
+//=============================================================================
+//  Render_Invalidate֐ - ̃t[͉ʑŜ`悤ɂ܂
+//   (EBhEBꂽAʂ̃ꂽȂǂɌĂт܂)
+//=============================================================================
+void Render_Invalidate(RenderHistory& history)
+{
+    history.valid = false;
+}
+
+//=============================================================================
+//  Render_FindDirty֐ - Õt[ƍ̕`惊XgׂāA`̈߂܂
+//   (ʂ history.dirty ɓA̐Ԃ܂Bhistory ͍̃t[̓eɍXV܂)
+//
+//   Xg̓ԍǂׁAĂΑOƍ̗͈̔͂`܂B
+//   _ɏdȂ̂AOԍœgȂA̓_̐F͕ς܂B
+//   EƂ́Aꂽׂ̕ĈႤƂɂȂ̂ŁA߂ɕ`łB
+//=============================================================================
+int Render_FindDirty(RenderHistory& history, const RenderList& list, const GlyphAtlas* font, int width, int height)
+{
+    int i;
+
+    history.dirtyCount = 0;
+    if (!history.valid){
+        Render_AddDirty(history, 0, 0, width, height, width, height);
+    }else{
+        // lp`
+        int n = list.count > history.count ? list.count : history.count;
+        for (i = 0; i < n; i++){
+            const RenderRect* cur  = i < list.count    ? &list.rects[i]    : NULL;
+            const RenderRect* prev = i < history.count ? &history.rects[i] : NULL;
+            if (cur != NULL && prev != NULL && memcmp(cur, prev, sizeof(RenderRect)) == 0){
+                continue;
+            }
+            if (cur != NULL)  Render_AddDirty(history, cur->x, cur->y, cur->w, cur->h, width, height);
+            if (prev != NULL) Render_AddDirty(history, prev->x, prev->y, prev->w, prev->h, width, height);
+        }
+
+        //  (font  NULL Ȃ`Ȃ̂Ŕׂ܂)
+        if (font != NULL){
+            n = list.textCount > history.textCount ? list.textCount : history.textCount;
+            for (i = 0; i < n; i++){
+                const RenderText* cur  = i < list.textCount    ? &list.texts[i]    : NULL;
+                const RenderText* prev = i < history.textCount ? &history.texts[i] : NULL;
+                if (cur != NULL && prev != NULL && cur->x == prev->x && cur->y == prev->y && cur->color == prev->color
+                    && strlen(cur->text) < RENDER_TEXT_COPY && strcmp(cur->text, history.textCopy[i]) == 0){
+                    continue;
+                }
+                if (cur != NULL)  Render_AddDirty(history, cur->x, cur->y, Render_TextWidth(*font, cur->text), TEXT_CELL_H, width, height);
+                if (prev != NULL) Render_AddDirty(history, prev->x, prev->y, history.textWidth[i], TEXT_CELL_H, width, height);
+            }
+        }
+    }
+
+    // ̃t[̓eoĂ܂
+    history.valid = true;
+    history.count = list.count;
+    memcpy(history.rects, list.rects, list.count * sizeof(RenderRect));
+    history.textCount = font != NULL ? list.textCount : 0;
+    for (i = 0; i < history.textCount; i++){
+        history.texts[i] = list.texts[i];
+        strncpy(history.textCopy[i], list.texts[i].text, RENDER_TEXT_COPY - 1);
+        history.textCopy[i][RENDER_TEXT_COPY - 1] = '\0';
+        history.textWidth[i] = Render_TextWidth(*font, list.texts[i].text);
+    }
+    return history.dirtyCount;
+}
+
+//=============================================================================
+//  Render_FlushDirty֐ - Render_FindDirty ŋ߂̈悾`܂
+//   (̈̊O͑Õt[̂܂܎cĂKv܂)
+//=============================================================================
+void Render_FlushDirty(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font, const RenderHistory& history)
+{
+    int i;
+    for (i = 0; i < history.dirtyCount; i++){
+        Render_FlushRegion(list, fb, font, history.dirty[i]);
+    }
+}
+
+//=============================================================================
+//  Render_FillSpan֐ -  count sNZ𓯂Fœh܂
+//=============================================================================
+void Render_FillSpan(unsigned int* dst, int count, unsigned int color)
+{
+#if defined(RENDER_SPAN_AVX2)
+    // 32oCgE܂ł1sNZA8sNZ܂
+    while (count > 0 && ((size_t)dst & 31) != 0){ *dst++ = color; count--; }
+    __m256i v = _mm256_set1_epi32((int)color);
+    while (count >= 8){ _mm256_store_si256((__m256i*)dst, v); dst += 8; count -= 8; }
+#elif defined(RENDER_SPAN_SSE2)
+    // 16oCgE܂ł1sNZA4sNZ܂
+    while (count > 0 && ((size_t)dst & 15) != 0){ *dst++ = color; count--; }
+    __m128i v = _mm_set1_epi32((int)color);
+    while (count >= 8){ _mm_store_si128((__m128i*)dst, v); _mm_store_si128((__m128i*)(dst + 4), v); dst += 8; count -= 8; }
+    while (count >= 4){ _mm_store_si128((__m128i*)dst, v); dst += 4; count -= 4; }
+#else
+    while (count >= 4){ dst[0] = color; dst[1] = color; dst[2] = color; dst[3] = color; dst += 4; count -= 4; }
+#endif
+    // c̒[
+    while (count > 0){ *dst++ = color; count--; }
+}
+
+//=============================================================================
+//  Render_BlendSpan֐ -  count sNZA̐F color ̔̐Fɂ܂
+//   (eF̈ԉ̃rbg𗎂ƂĂ甼ɂ΁AĂׂ̐Fɂӂ܂)
+//=============================================================================
+void Render_BlendSpan(unsigned int* dst, int count, unsigned int color)
+{
+    unsigned int half = (color & 0xFEFEFE) >> 1;
+    while (count > 0){ *dst = ((*dst & 0xFEFEFE) >> 1) + half; dst++; count--; }
+}
+
+//=============================================================================
+//  Render_SpanFillName֐ - ǂ̓hԂ߂ŃrhꂽԂ܂ (vʂ̕\p)
+//=============================================================================
+const char* Render_SpanFillName()
+{
+#if defined(RENDER_SPAN_AVX2)
+    return "AVX2";
+#elif defined(RENDER_SPAN_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+//=============================================================================
+//  Render_SavePPM֐ - t[obt@ PPM 摜 (ǂ̊łJȒPȌ`) ŕۑ܂
+//=============================================================================
+bool Render_SavePPM(const char* path, const Framebuffer& fb)
+{
+    int x, y;
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL){
+        return false;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", fb.width, fb.height);
+    for (y = 0; y < fb.height; y++){
+        const unsigned int* row = fb.pixels + y * fb.pitch;
+        for (x = 0; x < fb.width; x++){
+            unsigned char rgb[3];
+            rgb[0] = (unsigned char)(row[x] >> 16);
+            rgb[1] = (unsigned char)(row[x] >> 8);
+            rgb[2] = (unsigned char)(row[x]);
+            fwrite(rgb, 1, 3, fp);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// region ̒ɁA`惊Xg̎lp`ƕ`܂
+static void Render_FlushRegion(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font, const DirtyRect& region)
+{
+    int i, y;
+
+    for (i = 0; i < list.count; i++){
+        const RenderRect& rc = list.rects[i];
+
+        // ̈悩͂ݏo؂܂
+        int left   = rc.x < region.left ? region.left : rc.x;
+        int top    = rc.y < region.top  ? region.top  : rc.y;
+        int right  = rc.x + rc.w > region.right  ? region.right  : rc.x + rc.w;
+        int bottom = rc.y + rc.h > region.bottom ? region.bottom : rc.y + rc.h;
+
+        if (left >= right || top >= bottom){
+            continue;
+        }
+
+        unsigned int* row = fb.pixels + top * fb.pitch + left;
+        for (y = top; y < bottom; y++){
+            if (rc.color & RENDER_BLEND){
+                Render_BlendSpan(row, right - left, rc.color);
+            }else{
+                Render_FillSpan(row, right - left, rc.color);
+            }
+            row += fb.pitch;
+        }
+    }
+
+    if (font != NULL){
+        // ̈̕؂oʃɕ`΁A͂ݏo Text_Draw ؂܂
+        Framebuffer sub;
+        sub.pixels = fb.pixels + region.top * fb.pitch + region.left;
+        sub.width  = region.right - region.left;
+        sub.height = region.bottom - region.top;
+        sub.pitch  = fb.pitch;
+        for (i = 0; i < list.textCount; i++){
+            const RenderText& rt = list.texts[i];
+            Text_Draw(sub, *font, rt.x - region.left, rt.y - region.top, rt.text, rt.color);
+        }
+    }
+}
+
+// `̈ǉ܂BdȂ (܂͐ڂ) ̈悪΂܂Ƃ߁A
+//  MAX_DIRTY_RECTS 𒴂Ƃ́A܂Ƃ߂ĂL肪ԏȂ̈Ƃ܂Ƃ߂܂
+static void Render_AddDirty(RenderHistory& history, int x, int y, int w, int h, int width, int height)
+{
+    int i;
+    DirtyRect r;
+    r.left   = x < 0 ? 0 : x;
+    r.top    = y < 0 ? 0 : y;
+    r.right  = x + w > width  ? width  : x + w;
+    r.bottom = y + h > height ? height : y + h;
+    if (r.left >= r.right || r.top >= r.bottom){
+        return;
+    }
+
+    for (;;){
+        int merge = -1;
+        for (i = 0; i < history.dirtyCount; i++){
+            const DirtyRect& d = history.dirty[i];
+            if (r.left <= d.right && d.left <= r.right && r.top <= d.bottom && d.top <= r.bottom){
+                merge = i;
+                break;
+            }
+        }
+        if (merge < 0 && history.dirtyCount >= MAX_DIRTY_RECTS){
+            int best = 0x7FFFFFFF;
+            for (i = 0; i < history.dirtyCount; i++){
+                const DirtyRect& d = history.dirty[i];
+                int l = d.left < r.left ? d.left : r.left,  t = d.top < r.top ? d.top : r.top;
+                int rr = d.right > r.right ? d.right : r.right, b = d.bottom > r.bottom ? d.bottom : r.bottom;
+                int grow = (rr - l) * (b - t) - (d.right - d.left) * (d.bottom - d.top);
+                if (grow < best){ best = grow; merge = i; }
+            }
+        }
+        if (merge < 0){
+            break;
+        }
+
+        // ܂Ƃ߂̈oāAق̗̈Ƃxׂ܂
+        const DirtyRect& d = history.dirty[merge];
+        if (d.left   < r.left)   r.left   = d.left;
+        if (d.top    < r.top)    r.top    = d.top;
+        if (d.right  > r.right)  r.right  = d.right;
+        if (d.bottom > r.bottom) r.bottom = d.bottom;
+        history.dirty[merge] = history.dirty[--history.dirtyCount];
+    }
+    history.dirty[history.dirtyCount++] = r;
+}
+
+// 񂪕`ȂłBŌ̌̕`͎̕܂ł̕
+// ͂ݏoƂ̂ŁA1̑傫𑫂Ă܂
+static int Render_TextWidth(const GlyphAtlas& font, const char* text)
+{
+    return Text_Measure(font, text) + TEXT_CELL_W;
+}
@@ -0,0 +1,109 @@
+//=============================================================================
+//
+//  wWXgWv DX5x \tgEFA` (܂Ƃߕ`)
+//
+//  1t[̎lp`ƕu`惊Xgvɂ߂ĂAŌ
+//  32rbg̉ʃ (t[obt@) ւ܂Ƃ߂ĕ`܂B
+//  1`т GetDC / ReleaseDC ԂKvȂȂ܂B
+//   text.cpp ̃OtAgXʂ܂B
+//
+//  Õt[̕`惊Xg RenderHistory ɊoĂ΁Aς (_[eB[̈)
+//  `܂BςȂt[ (^CgʂȂ) ł́Ah]܂B
+//
+//  Windowsłł DirectDraw ̃T[tFX Lock ɁA
+//  wbhXłł͕ʂɊmۂɕ`܂B
+//
+//=============================================================================
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "sim.h"
+
+// 1t[ɂ߂Ălp`̍ő吔
+#define MAX_RENDER_RECTS    1024     // (Ԃ̃Otd˂Ă鐔)
+// 1t[ɂ߂Ă镶̍ő吔
+#define MAX_RENDER_TEXTS    32
+// Õt[Ɣׂ邽߂ɊoĂA1̒ (蒷͖`܂)
+#define RENDER_TEXT_COPY    96
+// `̈̍ő吔 (葽ȂA߂̓m܂Ƃ߂܂)
+#define MAX_DIRTY_RECTS     16
+
+// F 0x00RRGGBB ̌`ɂ܂Ƃ߂܂ (32rbgʂ X8R8G8B8 `Ɠ)
+#define RENDER_RGB(r, g, b) ((((unsigned int)(r) & 0xFF) << 16) | (((unsigned int)(g) & 0xFF) << 8) | ((unsigned int)(b) & 0xFF))
+// F̈ԏ̃rbgĂA̐FƔēh܂ (BRender_BlendRect Őς݂܂)
+#define RENDER_BLEND        0x80000000u
+
+// hԂlp`1̖
+struct RenderRect
+{
+    int          x, y, w, h;
+    unsigned int color;        // RENDER_RGB ōF (| RENDER_BLEND Ȃ甼)
+};
+
+// `1̖ (񂻂̂̂̓Rs[Ȃ̂ŁA`I܂ŏȂł)
+struct RenderText
+{
+    int          x, y;         // 
+    unsigned int color;
+    const char*  text;         // Shift_JIS ̕
+};
+
+// 1t[̕`惊Xg
+struct RenderList
+{
+    int          count;
+    RenderRect   rects[MAX_RENDER_RECTS];
+    int          textCount;
+    RenderText   texts[MAX_RENDER_TEXTS];
+};
+
+// `̈ (right  bottom ͊܂݂܂)
+struct DirtyRect
+{
+    int left, top, right, bottom;
+};
+
+// Õt[ɕ` (͒gʂĂ܂BHUD ͓̕ꏊɏ㏑邽)
+struct RenderHistory
+{
+    bool         valid;        // false Ȃ玟̃t[͑Ŝ`܂
+    int          count;
+    RenderRect   rects[MAX_RENDER_RECTS];
+    int          textCount;
+    RenderText   texts[MAX_RENDER_TEXTS];
+    char         textCopy[MAX_RENDER_TEXTS][RENDER_TEXT_COPY];
+    int          textWidth[MAX_RENDER_TEXTS];
+
+    // Render_FindDirty ŌÃt[ŕ`̈
+    int          dirtyCount;
+    DirtyRect    dirty[MAX_DIRTY_RECTS];
+};
+
+struct GlyphAtlas;
+
+// `ݐ̉ʃ (1sNZ32rbg)
+struct Framebuffer
+{
+    unsigned int* pixels;
+    int           width, height;
+    int           pitch;       // 1s̃sNZ (傫Ƃ܂)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Render_Begin(RenderList& list);
+void Render_Rect(RenderList& list, int x, int y, int w, int h, int r, int g, int b);
+void Render_BlendRect(RenderList& list, int x, int y, int w, int h, int r, int g, int b);
+void Render_Text(RenderList& list, int x, int y, const char* text, int r, int g, int b);
+void Render_World(RenderList& list, const World& world);
+void Render_Flush(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font);
+void Render_Invalidate(RenderHistory& history);
+int  Render_FindDirty(RenderHistory& history, const RenderList& list, const GlyphAtlas* font, int width, int height);
+void Render_FlushDirty(const RenderList& list, const Framebuffer& fb, const GlyphAtlas* font, const RenderHistory& history);
+void Render_FillSpan(unsigned int* dst, int count, unsigned int color);
+void Render_BlendSpan(unsigned int* dst, int count, unsigned int color);
+const char* Render_SpanFillName();
+bool Render_SavePPM(const char* path, const Framebuffer& fb);
+
+#endif // RENDER_H
@@ -0,0 +1,249 @@
+//=============================================================================
+//
+//  wWXgWv DX5x vC (͂̋L^ƍĐ)
+//
+//=============================================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void Replay_PutByte(Replay& replay, unsigned char b);
+static void Replay_PutVarint(Replay& replay, unsigned long v);
+static bool Replay_GetVarint(Replay& replay, unsigned long& v);
+static void Replay_FlushRun(Replay& replay);
+static void Replay_WriteU32(unsigned char* p, unsigned long v);
+static unsigned long Replay_ReadU32(const unsigned char* p);
+
+//=============================================================================
+//  Replay_Init / Replay_Free֐ - vC̏Ԃɂ / Ԃ
+//=============================================================================
+void Replay_Init(Replay& replay)
+{
+    memset(&replay, 0, sizeof(replay));
+}
+
+void Replay_Free(Replay& replay)
+{
+    free(replay.data);
+    Replay_Init(replay);
+}
+
+//=============================================================================
+//  L^
+//=============================================================================
+void Replay_BeginRecord(Replay& replay, unsigned long seed, unsigned long flags, unsigned long stageHash)
+{
+    Replay_Free(replay);
+    replay.seed = seed & 0xFFFFFFFFUL;
+    replay.flags = flags | (SCALAR_FIXED ? REPLAY_FLAG_FIXED : 0);
+    replay.stageHash = stageHash & 0xFFFFFFFFUL;
+
+    // ȂȂ Replay_PutByte {ɍL܂ (mۂłȂĂAL^rŐ؂邾ł)
+    replay.data = (unsigned char*)malloc(REPLAY_RESERVE_BYTES);
+    replay.capacity = replay.data != NULL ? REPLAY_RESERVE_BYTES : 0;
+}
+
+void Replay_RecordFrame(Replay& replay, const InputFrame& input)
+{
+    int bits = (input.jump ? REPLAY_BIT_JUMP : 0) | (input.escape ? REPLAY_BIT_ESCAPE : 0) | (input.jumpPressed ? REPLAY_BIT_JUMP_PRESSED : 0);
+
+    // ͂ςA܂őĂo܂
+    if (replay.runLength > 0 && bits != replay.runBits){
+        Replay_FlushRun(replay);
+    }
+    replay.runBits = bits;
+    replay.runLength++;
+    replay.frameCount++;
+}
+
+void Replay_EndRecord(Replay& replay)
+{
+    if (replay.runLength > 0){
+        Replay_FlushRun(replay);
+    }
+}
+
+bool Replay_Save(const Replay& replay, const char* path)
+{
+    unsigned char header[32];
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL){
+        return false;
+    }
+
+    memcpy(header, "JJRP", 4);
+    Replay_WriteU32(header + 4,  REPLAY_VERSION);
+    Replay_WriteU32(header + 8,  SIM_VERSION);
+    Replay_WriteU32(header + 12, replay.seed);
+    Replay_WriteU32(header + 16, replay.flags);
+    Replay_WriteU32(header + 20, replay.frameCount);
+    Replay_WriteU32(header + 24, replay.size);
+    Replay_WriteU32(header + 28, replay.stageHash);
+
+    bool ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+    if (ok && replay.size > 0){
+        ok = fwrite(replay.data, 1, replay.size, fp) == replay.size;
+    }
+    fclose(fp);
+    return ok;
+}
+
+//=============================================================================
+//  Đ
+//=============================================================================
+bool Replay_Load(Replay& replay, const char* path, unsigned long stageHash)
+{
+    unsigned char header[32];
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL){
+        return false;
+    }
+
+    Replay_Free(replay);
+
+    if (fread(header, 1, sizeof(header), fp) != sizeof(header) || memcmp(header, "JJRP", 4) != 0 || Replay_ReadU32(header + 4) != REPLAY_VERSION
+        || Replay_ReadU32(header + 8) != SIM_VERSION){
+        fclose(fp);
+        return false;
+    }
+
+    replay.seed       = Replay_ReadU32(header + 12);
+    replay.flags      = Replay_ReadU32(header + 16);
+    replay.frameCount = Replay_ReadU32(header + 20);
+    replay.size       = Replay_ReadU32(header + 24);
+    replay.stageHash  = Replay_ReadU32(header + 28);
+
+    // float łƌŒ菬_łł́A͂łWJς̂ŁAL^̂ƓłłĐł܂B
+    // Xe[W\ႤƂł
+    if (((replay.flags & REPLAY_FLAG_FIXED) != 0) != (SCALAR_FIXED != 0) || replay.stageHash != (stageHash & 0xFFFFFFFFUL)){
+        fclose(fp);
+        Replay_Free(replay);
+        return false;
+    }
+
+    replay.capacity   = replay.size;
+    replay.data       = (unsigned char*)malloc(replay.size > 0 ? replay.size : 1);
+
+    bool ok = replay.data != NULL && fread(replay.data, 1, replay.size, fp) == replay.size;
+    fclose(fp);
+
+    if (!ok){
+        Replay_Free(replay);
+    }
+    return ok;
+}
+
+void Replay_BeginPlayback(Replay& replay)
+{
+    replay.readPos = 0;
+    replay.playBits = 0;
+    replay.playRemaining = 0;
+    replay.playedFrames = 0;
+}
+
+// 1t[̓͂o܂BL^̏Iɗ false Ԃ܂
+bool Replay_NextFrame(Replay& replay, InputFrame& input)
+{
+    if (replay.playedFrames >= replay.frameCount){
+        return false;
+    }
+
+    if (replay.playRemaining == 0){
+        unsigned long token;
+        if (!Replay_GetVarint(replay, token) || (token >> REPLAY_BIT_SHIFT) == 0){
+            return false;
+        }
+        replay.playBits = (int)(token & ((1 << REPLAY_BIT_SHIFT) - 1));
+        replay.playRemaining = token >> REPLAY_BIT_SHIFT;
+    }
+
+    input.jump        = (replay.playBits & REPLAY_BIT_JUMP) != 0;
+    input.jumpPressed = (replay.playBits & REPLAY_BIT_JUMP_PRESSED) != 0;
+    input.escape      = (replay.playBits & REPLAY_BIT_ESCAPE) != 0;
+    replay.playRemaining--;
+    replay.playedFrames++;
+    return true;
+}
+
+// ̍ĐʒuԂ܂
+ReplayCursor Replay_Tell(const Replay& replay)
+{
+    ReplayCursor cursor;
+    cursor.readPos       = replay.readPos;
+    cursor.playBits      = replay.playBits;
+    cursor.playRemaining = replay.playRemaining;
+    cursor.playedFrames  = replay.playedFrames;
+    return cursor;
+}
+
+// Replay_Tell ŊoĂʒuAĐ𑱂܂
+void Replay_Seek(Replay& replay, const ReplayCursor& cursor)
+{
+    replay.readPos       = cursor.readPos;
+    replay.playBits      = cursor.playBits;
+    replay.playRemaining = cursor.playRemaining;
+    replay.playedFrames  = cursor.playedFrames;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// Ă͂ (t[ << REPLAY_BIT_SHIFT | ̓rbg) ̌`ŏo܂
+static void Replay_FlushRun(Replay& replay)
+{
+    Replay_PutVarint(replay, (replay.runLength << REPLAY_BIT_SHIFT) | (unsigned long)replay.runBits);
+    replay.runLength = 0;
+}
+
+static void Replay_PutByte(Replay& replay, unsigned char b)
+{
+    if (replay.size >= replay.capacity){
+        unsigned long newCapacity = replay.capacity ? replay.capacity * 2 : 256;
+        unsigned char* p = (unsigned char*)realloc(replay.data, newCapacity);
+        if (p == NULL){
+            return;
+        }
+        replay.data = p;
+        replay.capacity = newCapacity;
+    }
+    replay.data[replay.size++] = b;
+}
+
+// ϒ: 7rbgA΍ŏʃrbg𗧂Ăď܂
+static void Replay_PutVarint(Replay& replay, unsigned long v)
+{
+    while (v >= 0x80){
+        Replay_PutByte(replay, (unsigned char)((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    Replay_PutByte(replay, (unsigned char)v);
+}
+
+static bool Replay_GetVarint(Replay& replay, unsigned long& v)
+{
+    int shift = 0;
+    v = 0;
+    while (replay.readPos < replay.size && shift < 32){
+        unsigned char b = replay.data[replay.readPos++];
+        v |= (unsigned long)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0){
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+static void Replay_WriteU32(unsigned char* p, unsigned long v)
+{
+    p[0] = (unsigned char)(v); p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned long Replay_ReadU32(const unsigned char* p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
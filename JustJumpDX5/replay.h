@@ -0,0 +1,91 @@
+//=============================================================================
+//
+//  wWXgWv DX5x vC (͂̋L^ƍĐ)
+//
+//  ̎ƁAt[̃L[͂L^Ă΁AQ[͂܂
+//  WJԂ܂B͂́uԂt[vL^
+//  OXŁAقƂǂ̃t[̓f[^𑝂₵܂B
+//
+//  t@C` (lׂ͂ăgGfBA):
+//    "JJRP"            4oCg  ڈ
+//    o[W        4oCg  REPLAY_VERSION
+//    Q[̃o[W 4oCg  SIM_VERSION (Q[̓ςAÂL^͍Đł܂)
+//    ̎          4oCg
+//    Vѕ            4oCg  REPLAY_FLAG_` (GhX[hǂAŒ菬_łŋL^)
+//    t[        4oCg
+//    f[^̑傫    4oCg
+//    Xe[W\        4oCg  Sim_StageHash (ႤXe[W\ł́A͂łWJς̂ōĐł܂)
+//    f[^            ϒ   (At[ << REPLAY_BIT_SHIFT | ̓rbg) ϒŕׂ
+//
+//=============================================================================
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "sim.h"
+
+#define REPLAY_VERSION      5
+
+// L^n߂ƂɁAɊmۂĂf[^̑傫 (oCg)B
+// vCŖ1ԕAł߂ɘAłĂ1ԕɑ܂B
+// Vłr realloc Ȃ悤 (t[̓rŃq[vgȂ悤) 邽߂ł
+#define REPLAY_RESERVE_BYTES    65536
+
+// ̓rbg
+#define REPLAY_BIT_JUMP         0x01
+#define REPLAY_BIT_ESCAPE       0x02
+#define REPLAY_BIT_JUMP_PRESSED 0x04    // ̃t[ŃXy[XL[V (Ăc܂)
+#define REPLAY_BIT_SHIFT        3       // ̓rbg̐
+
+// Vѕ
+#define REPLAY_FLAG_ENDLESS 0x01
+#define REPLAY_FLAG_FIXED   0x02    // Œ菬_ (scalar.h) ŋL^ (tׂ̂̂ replay.cpp s܂)
+
+struct Replay
+{
+    unsigned long  seed;           // ̎
+    unsigned long  flags;          // Vѕ (REPLAY_FLAG_`)
+    unsigned long  frameCount;     // L^Ăt[
+    unsigned long  stageHash;      // L^Ƃ̃Xe[W\̃nbVl (Sim_StageHash)
+
+    unsigned char* data;           // OX̃f[^
+    unsigned long  size;           // data ̎gp̑傫 (oCg)
+    unsigned long  capacity;       // data ̊mۍς݂̑傫 (oCg)
+
+    // L^̏
+    int            runBits;        // ܑĂ
+    unsigned long  runLength;      // ̓͂Ăt[
+
+    // Đ̏
+    unsigned long  readPos;        // data ̓ǂݎʒu
+    int            playBits;       // ܍ĐĂ
+    unsigned long  playRemaining;  // ̓͂Ɖt[Đ邩
+    unsigned long  playedFrames;   // ܂łɍĐt[
+};
+
+// Đ̓r̈ʒu (߂̎ʂƈꏏɊoĂ΁AĐ𑱂܂)
+struct ReplayCursor
+{
+    unsigned long  readPos;
+    int            playBits;
+    unsigned long  playRemaining;
+    unsigned long  playedFrames;
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Replay_Init(Replay& replay);
+void Replay_Free(Replay& replay);
+
+void Replay_BeginRecord(Replay& replay, unsigned long seed, unsigned long flags, unsigned long stageHash);
+void Replay_RecordFrame(Replay& replay, const InputFrame& input);
+void Replay_EndRecord(Replay& replay);
+bool Replay_Save(const Replay& replay, const char* path);
+
+bool Replay_Load(Replay& replay, const char* path, unsigned long stageHash);
+void Replay_BeginPlayback(Replay& replay);
+bool Replay_NextFrame(Replay& replay, InputFrame& input);
+ReplayCursor Replay_Tell(const Replay& replay);
+void Replay_Seek(Replay& replay, const ReplayCursor& cursor);
+
+#endif // REPLAY_H
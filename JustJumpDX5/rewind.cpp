@@ -0,0 +1,79 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ߂ (Q[̏Ԃ̎ʂ̃Oobt@)
+//
+//=============================================================================
+#include <string.h>
+#include "rewind.h"
+
+//=============================================================================
+//  Rewind_Init֐ - ʂSY܂
+//=============================================================================
+void Rewind_Init(RewindRing& ring)
+{
+    memset(&ring, 0, sizeof(ring));
+}
+
+//=============================================================================
+//  Rewind_Record֐ - frame  REWIND_INTERVAL ̔{ȂȀԂʂ܂
+//   (ʂ trueBreplay ͍Đ̃vCBĐĂȂ NULL)
+//=============================================================================
+bool Rewind_Record(RewindRing& ring, unsigned long frame, const World& world, const Replay* replay)
+{
+    if (frame % REWIND_INTERVAL != 0){
+        return false;
+    }
+
+    unsigned long n = frame / REWIND_INTERVAL;
+    RewindSnapshot& snap = ring.slots[n % REWIND_SLOTS];
+    snap.frame = frame;
+    snap.world = world;
+    if (replay != NULL){
+        snap.replay = Replay_Tell(*replay);
+    }else{
+        memset(&snap.replay, 0, sizeof(snap.replay));
+    }
+
+    ring.count = n + 1;
+    ring.captures++;
+    return true;
+}
+
+//=============================================================================
+//  Rewind_Seek֐ - frame ̎OŁAԋ߂ʂԂ܂
+//   (㏑ĂČÂƂ NULLBԂʂ̎ʂ͖Y܂B
+//    iߒƁAԍ̎ʂƂ蒼ł)
+//=============================================================================
+const RewindSnapshot* Rewind_Seek(RewindRing& ring, unsigned long frame)
+{
+    unsigned long n = frame / REWIND_INTERVAL;
+
+    if (ring.count == 0){
+        return NULL;
+    }
+    if (n >= ring.count){
+        n = ring.count - 1;                 // ܂ʂĂȂ̃t[ȂAԐVʂ
+    }
+    if (ring.count - n > REWIND_SLOTS){
+        return NULL;                        // ւāA㏑Ă܂
+    }
+
+    ring.count = n + 1;
+    return &ring.slots[n % REWIND_SLOTS];
+}
+
+//=============================================================================
+//  Rewind_Restore֐ - ʂ̏Ԃɖ߂܂
+//   (Xe[W\ƋԂpӂ֐́AʂƂ̕ł͂Ȃ world ̍̕g܂)
+//=============================================================================
+void Rewind_Restore(const RewindSnapshot& snapshot, World& world)
+{
+    const StageData* stages = world.stages;
+    ChunkProvider provider = world.chunkProvider;
+    void* context = world.chunkContext;
+
+    world = snapshot.world;
+    world.stages = stages;
+    world.chunkProvider = provider;
+    world.chunkContext = context;
+}
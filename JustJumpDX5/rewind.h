@@ -0,0 +1,55 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ߂ (Q[̏Ԃ̎ʂ̃Oobt@)
+//
+//  REWIND_INTERVAL t[ƂɁAQ[̏ (World) ܂邲ƎʂĂ܂B
+//  World ̓|C^ȊO͂̒l̕тȂ̂ŁAʂ̂߂̂\̂̃Rs[1ōς݂܂
+//  (Xe[W\ƋԂpӂ֐̃|C^́A߂Ƃɍ World ̕g܂)B
+//  ʂ REWIND_SLOTS ւ̂悤Ɏg񂷂̂ŁAoĂ͍̂Ō̖30błB
+//
+//  ʂ̒úut[ԍ / REWIND_INTERVALvŌ܂̂ŁAǂ̃t[ɖ߂Ƃ
+//  TɈxŌ܂BʂƎʂ̊Ԃ̃t[ɖ߂肽Ƃ́A
+//  O̎ʂɖ߂ĂÃt[܂œ͂ԂĐi߂܂ (vC̓oȂ)B
+//
+//  g:
+//    Rewind_Init(ring);
+//    Sim_Step(world, input); frame++;
+//    Rewind_Record(ring, frame, world, NULL);            // t[ (Ƃ̂ REWIND_INTERVAL )
+//
+//    const RewindSnapshot* s = Rewind_Seek(ring, frame - 120);   // 2bOɖ߂
+//    if (s) { Rewind_Restore(*s, world); frame = s->frame; }
+//
+//=============================================================================
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "sim.h"
+#include "replay.h"
+
+#define REWIND_INTERVAL     15      // t[ƂɎʂƂ邩 (0.24b)
+#define REWIND_SLOTS        128     // ʂ̐ (REWIND_INTERVAL ~ REWIND_SLOTS t[ = 30b)
+
+// ʂ1 (RXgN^fXgN^Ȃ\̂Ȃ̂ŁAmemcpy ł̂܂܎ʂ܂)
+struct RewindSnapshot
+{
+    unsigned long frame;            // t[ڂ̏Ԃ
+    World         world;
+    ReplayCursor  replay;           // vCĐĂȂA̎_̍Đʒu
+};
+
+struct RewindRing
+{
+    RewindSnapshot slots[REWIND_SLOTS];
+    unsigned long  count;           // gʂ́ut[ԍ / REWIND_INTERVAL + 1v̍ől (0 Ȃ)
+    unsigned long  captures;        // ܂łɎʂƂ
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void                  Rewind_Init(RewindRing& ring);
+bool                  Rewind_Record(RewindRing& ring, unsigned long frame, const World& world, const Replay* replay);
+const RewindSnapshot* Rewind_Seek(RewindRing& ring, unsigned long frame);
+void                  Rewind_Restore(const RewindSnapshot& snapshot, World& world);
+
+#endif // REWIND_H
@@ -0,0 +1,41 @@
+//=============================================================================
+//
+//  wWXgWv DX5x  (xoshiro128**)
+//
+//=============================================================================
+#include "rng.h"
+
+// unsigned int 32rbĝ͂ł (Ⴆ΂ŃRpCG[ɂȂ܂)
+typedef char Rng_UInt_Size_Check[(sizeof(unsigned int) == 4) ? 1 : -1];
+
+//=============================================================================
+//  Rng_Seed֐ - ƃXg[ԍȀԂ܂
+//   (AƂȂ̃Xg[ԍłA܂ႤтɂȂ悤ɁA
+//    Rng_Hash ŏ\ɂĂԂɂ܂)
+//=============================================================================
+void Rng_Seed(Rng& rng, unsigned long seed, unsigned long stream)
+{
+    int i;
+    unsigned int x = Rng_Hash((unsigned int)seed) ^ Rng_Hash((unsigned int)stream + 0x632BE59BU);
+
+    for (i = 0; i < 4; i++){
+        x += 0x9E3779B9U;
+        rng.s[i] = Rng_Hash(x);
+    }
+    if ((rng.s[0] | rng.s[1] | rng.s[2] | rng.s[3]) == 0){
+        rng.s[0] = 1;   // Ԃׂ 0 ƁA 0 oȂȂ܂
+    }
+}
+
+//=============================================================================
+//  Rng_Hash֐ - 32rbg̐܂ (MurmurHash3 ̎dグƓvZł)
+//=============================================================================
+unsigned int Rng_Hash(unsigned int x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6BU;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35U;
+    x ^= x >> 16;
+    return x;
+}
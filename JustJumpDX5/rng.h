@@ -0,0 +1,61 @@
+//=============================================================================
+//
+//  wWXgWv DX5x  (xoshiro128**)
+//
+//  CRT  rand() ́ARpCɂĕт͈͂Ⴂ (Visual C++ ł 0`32767)A
+//  vOŜ1̏ԂLĂ܂Bł́AԂ Rng ̒Ɏ
+//  32rbg̗pӂ܂BprƂɕʂ Rng (Xg[) Ă΁A
+//  ݂̗̕тɉe܂B
+//
+//  g:
+//    Rng rng;
+//    Rng_Seed(rng, seed, stream);  //  seed łAstream ႦΕʂ̕тɂȂ܂
+//    int n = Rng_Range(rng, 6);    // 0`5
+//
+//=============================================================================
+#ifndef RNG_H
+#define RNG_H
+
+struct Rng
+{
+    unsigned int s[4];      //  (ׂ 0 ɂ͂Ȃ܂)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Rng_Seed(Rng& rng, unsigned long seed, unsigned long stream);
+unsigned int Rng_Hash(unsigned int x);
+
+//=============================================================================
+//  Rng_Next֐ - 32rbg̗1Ԃ܂
+//   (ZEVtgE|ZȂ̂őAǂ̃RpCłтɂȂ܂)
+//=============================================================================
+inline unsigned int Rng_Rotl(unsigned int x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+inline unsigned int Rng_Next(Rng& rng)
+{
+    unsigned int result = Rng_Rotl(rng.s[1] * 5, 7) * 9;
+    unsigned int t = rng.s[1] << 9;
+
+    rng.s[2] ^= rng.s[0];
+    rng.s[3] ^= rng.s[1];
+    rng.s[1] ^= rng.s[2];
+    rng.s[0] ^= rng.s[3];
+    rng.s[2] ^= t;
+    rng.s[3] = Rng_Rotl(rng.s[3], 11);
+    return result;
+}
+
+//=============================================================================
+//  Rng_Range֐ - 0`n-1 ̗Ԃ܂ (n  1 ȏ)
+//=============================================================================
+inline int Rng_Range(Rng& rng, int n)
+{
+    return (int)(Rng_Next(rng) % (unsigned int)n);
+}
+
+#endif // RNG_H
@@ -0,0 +1,118 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Z̐̌^ (Scalar)
+//
+//  Q[̈ʒu⑬́Aӂ float ŌvZ܂BƂ낪 float ̌vZʂ́A
+//  RpCݒ (Visual C++ 6.0  x87ASSE2AGCC ̍œKȂ) ɂāA
+//  Ō1rbgς邱Ƃ܂B1rbgłႦ΁At[ɂ
+//  ʂ̓WJɂȂAWindowsłŋL^vC Linux ̃wbhXłōĐł܂B
+//
+//  JJ_FIXED_POINT `ărhƁAScalar  16.16 ̌Œ菬_ (̉16rbg
+//  Ɏg) ɂȂ܂BZEZE|ZEZׂ͂Đ̌vZȂ̂ŁA
+//  ǂ̃RpCłAǂ̐ݒłA܂ʂɂȂ܂ (make crosscheck Ŋm߂܂)B
+//  \̂ -32768`32767.99998 ŁA|ZƊŽʂ́A͂ݏo[̒lŎ~߂܂B
+//
+//  ǂ̌^łAQ[͓̏1̃R[hłB̂߁AScalar Ɛ float 
+//  Ƃ́AK̊֐ŕϊ܂ (Œ菬_̂Ƃ́AϊYƃRpCł܂)B
+//    SCALAR_CONST(0.4f)    ... 萔
+//    Scalar_FromInt(n)     ... 
+//    Scalar_FromFloat(f)   ... float  (Xe[Wݒ̑ȂǁBۂ߂Ĉԋ߂lɂ܂)
+//    Scalar_ToInt(s)       ...  (0 ̕֐؂̂āB(int) Ɠł)
+//    Scalar_ToFloat(s)     ... float  (`AwKp̊ϑlȂǁAQ[̐isɊ֌WȂŎg܂)
+//    Scalar_Bits(s)        ... nbVlƂ́A32rbg̒g
+//
+//  float ̂Ƃ́AǂȂ̂ƓȂ̂ŁA܂łƓ (nbVl) ɂȂ܂B
+//
+//  Linux ł make FIXED=1AWindowsłł̓vWFNg̐ݒ́uvvZbT̒`v
+//  JJ_FIXED_POINT 𑫂ărh܂BvĆAL^̂Ɠ^̔łłĐł܂B
+//
+//=============================================================================
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include <string.h>       // @\(memcpy)
+
+#ifdef JJ_FIXED_POINT
+
+#define SCALAR_FIXED        1
+#define SCALAR_NAME         "fixed 16.16"
+#define SCALAR_FRAC_BITS    16
+#define SCALAR_ONE          (1 << SCALAR_FRAC_BITS)
+#define SCALAR_RAW_MAX      0x7FFFFFFF
+#define SCALAR_RAW_MIN      (-SCALAR_RAW_MAX - 1)
+
+#ifdef _MSC_VER
+typedef __int64   ScalarWide;       // |ZEZ̓r̒l (64rbg)
+#else
+typedef long long ScalarWide;
+#endif
+
+// 16.16 ̌Œ菬_ (RXgN^̂ȂA̐1̍\̂Ȃ̂ŁAmemcpy ł̂܂܎ʂ܂)
+struct Fixed
+{
+    int raw;                        // {̒l ~ 65536
+};
+typedef Fixed Scalar;
+
+inline Scalar Scalar_FromRaw(int raw)       { Scalar s; s.raw = raw; return s; }
+inline Scalar Scalar_FromInt(int n)         { return Scalar_FromRaw(n * SCALAR_ONE); }       // n  -32768`32767
+inline Scalar Scalar_FromFloat(float f)     { double d = (double)f * SCALAR_ONE; return Scalar_FromRaw((int)(d < 0 ? d - 0.5 : d + 0.5)); }
+inline float  Scalar_ToFloat(Scalar s)      { return (float)s.raw / SCALAR_ONE; }
+inline int    Scalar_ToInt(Scalar s)        { return s.raw >= 0 ? s.raw >> SCALAR_FRAC_BITS : -((-s.raw) >> SCALAR_FRAC_BITS); }
+inline unsigned long Scalar_Bits(Scalar s)  { return (unsigned long)(unsigned int)s.raw; }
+
+// num / den (num < 32768 ~ den) Ԃ܂ (\Ȃׂ͐؂̂Ă܂)
+inline Scalar Scalar_Ratio(unsigned long num, unsigned long den)
+{
+    return Scalar_FromRaw((int)(((ScalarWide)num * SCALAR_ONE) / (ScalarWide)den));
+}
+
+// 萔 (RpCɌ܂ float ̒lAԋ߂Œ菬_ɂ܂)
+#define SCALAR_CONST(f)     Scalar_FromRaw((int)((f) * (double)SCALAR_ONE + ((f) < 0 ? -0.5 : 0.5)))
+#define SCALAR_HUGE         Scalar_FromRaw(SCALAR_RAW_MAX)
+
+// |ZƊŽʂ int Ɏ܂ȂƂ́A[̒lŎ~߂܂
+inline Scalar Scalar_Saturate(ScalarWide v)
+{
+    if (v > SCALAR_RAW_MAX) return Scalar_FromRaw(SCALAR_RAW_MAX);
+    if (v < SCALAR_RAW_MIN) return Scalar_FromRaw(SCALAR_RAW_MIN);
+    return Scalar_FromRaw((int)v);
+}
+
+//-----------------------------------------------------------------------------
+//  vZ (|Z̉EVtǵAVisual C++ ł GCC łۂZpVtgł)
+//-----------------------------------------------------------------------------
+inline Scalar  operator+(Scalar a, Scalar b)     { return Scalar_FromRaw(a.raw + b.raw); }
+inline Scalar  operator-(Scalar a, Scalar b)     { return Scalar_FromRaw(a.raw - b.raw); }
+inline Scalar  operator-(Scalar a)               { return Scalar_FromRaw(-a.raw); }
+inline Scalar  operator*(Scalar a, Scalar b)     { return Scalar_Saturate(((ScalarWide)a.raw * b.raw) >> SCALAR_FRAC_BITS); }
+inline Scalar  operator/(Scalar a, Scalar b)     { return b.raw != 0 ? Scalar_Saturate(((ScalarWide)a.raw * SCALAR_ONE) / b.raw) : SCALAR_HUGE; }
+inline Scalar& operator+=(Scalar& a, Scalar b)   { a.raw += b.raw; return a; }
+inline Scalar& operator-=(Scalar& a, Scalar b)   { a.raw -= b.raw; return a; }
+inline bool    operator<(Scalar a, Scalar b)     { return a.raw < b.raw; }
+inline bool    operator<=(Scalar a, Scalar b)    { return a.raw <= b.raw; }
+inline bool    operator>(Scalar a, Scalar b)     { return a.raw > b.raw; }
+inline bool    operator>=(Scalar a, Scalar b)    { return a.raw >= b.raw; }
+inline bool    operator==(Scalar a, Scalar b)    { return a.raw == b.raw; }
+inline bool    operator!=(Scalar a, Scalar b)    { return a.raw != b.raw; }
+
+#else // JJ_FIXED_POINT
+
+#define SCALAR_FIXED        0
+#define SCALAR_NAME         "float"
+
+typedef float Scalar;
+
+inline Scalar Scalar_FromInt(int n)         { return (float)n; }
+inline Scalar Scalar_FromFloat(float f)     { return f; }
+inline float  Scalar_ToFloat(Scalar s)      { return s; }
+inline int    Scalar_ToInt(Scalar s)        { return (int)s; }
+inline Scalar Scalar_Ratio(unsigned long num, unsigned long den) { return (float)num / (float)den; }
+inline unsigned long Scalar_Bits(Scalar s)  { unsigned int bits; memcpy(&bits, &s, sizeof(bits)); return bits; }
+
+#define SCALAR_CONST(f)     (f)
+#define SCALAR_HUGE         1.0e30f
+
+#endif // JJ_FIXED_POINT
+
+#endif // SCALAR_H
@@ -0,0 +1,1037 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Q[WbN (V~[V) 
+//
+//  Ƃ main.cpp  Update_` ֐ɂAWindows ɈˑȂ
+//  `ŎôłBL[͂ InputFrameAԂ world.time Ŏ󂯎A
+//  ʂׂ͂ World \̂ɏ݂܂B
+//
+//=============================================================================
+#include <string.h>       // @\(memcpy)
+#include "sim.h"
+#include "endless.h"
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static void Sim_UpdateTitle(World& world, const InputFrame& input);
+static void Sim_UpdatePlaying(World& world, const InputFrame& input);
+static void Sim_ChooseKernel(World& world);
+static void Sim_NextStageSegment(World& world, GroundSegment& seg, bool pits);
+static void Sim_UpdateStageClear(World& world, const InputFrame& input);
+static void Sim_UpdateGameClear(World& world, const InputFrame& input);
+static void Sim_UpdateGameOver(World& world, const InputFrame& input);
+static bool Sim_IsSolidUnder(const World& world, Scalar left, Scalar right);
+static void Sim_SweepAxis(Scalar p0, Scalar d, Scalar invD, Scalar lo, Scalar hi, Scalar& enter, Scalar& leave);
+static Scalar Sim_SweepBox(Scalar x0, Scalar y0, Scalar dx, Scalar dy, Scalar invDx, Scalar invDy, Scalar l, Scalar t, Scalar r, Scalar b, HitSide& side);
+static Scalar Sim_SweepObstacles(const World& world, Scalar x0, Scalar y0, Scalar dx, Scalar dy, HitSide& side);
+static Scalar Sim_SweepPitWalls(const World& world, Scalar x0, Scalar y0, Scalar dx, Scalar dy, HitSide& side);
+static Scalar Sim_Lerp(Scalar a, Scalar b, Scalar alpha);
+static void Sim_RebaseTrack(World& world);
+static void Sim_StartEndless(World& world);
+static void Sim_LoadChunk(World& world, unsigned long index);
+static void Sim_NextChunkSegment(World& world, GroundSegment& seg);
+static void Sim_AddPopup(World& world, Scalar x, Scalar y, unsigned long startTime);
+static void Sim_RemovePopup(World& world, int i);
+
+//-----------------------------------------------------------------------------
+//  XC[v (ĂԂ̓蔻) Ŏgl
+//-----------------------------------------------------------------------------
+#define SWEEP_MISS      SCALAR_CONST(2.0f)  // ũt[ł͂ԂȂv (1.0 傫Ήł܂܂)
+#define SWEEP_FOREVER   SCALAR_HUGE         // uƁv (ĂȂ̎)
+
+// ǂ̘g̔ԍ & ŉ񂷂̂ŁAMAX_OBSTACLES 2ׂ̂ɂĂ܂
+typedef char Sim_Obstacle_Ring_Check[((MAX_OBSTACLES & (MAX_OBSTACLES - 1)) == 0) ? 1 : -1];
+
+//-----------------------------------------------------------------------------
+//  gݍ݂̃Xe[W\ (Xe[WpbNȂƂɎg܂)
+//-----------------------------------------------------------------------------
+#define DEFAULT_STAGE_COUNT 5
+
+static const StageData s_DefaultStages[DEFAULT_STAGE_COUNT] =
+{
+    //     NA  ̊m ̕    nʂ̕    ǂ̊m ǂ̍  ǂ̐  n߂̒n ŏ̕ ǂ̊Ԋu
+    {  -4.0f,   150,     0,    65, 35,   100, 200,     3,    30, 50,    3,    200, 100,    100,    250, 150 },   // Xe[W1 (ƂȂB SIM_STAGE1_SPEED ƓɂĂ܂)
+    {  -4.5f,   150,     5,    65, 35,   100, 200,     3,    30, 50,    3,    200, 100,    100,    250, 150 },   // Xe[W2
+    {  -5.0f,   150,     5,    65, 35,   100, 200,     3,    30, 50,    3,    200, 100,    100,    250, 150 },   // Xe[W3
+    {  -5.5f,   150,     5,    65, 35,   100, 200,     3,    30, 50,    3,    200, 100,    100,    250, 150 },   // Xe[W4
+    {  -6.0f,   150,     5,    65, 35,   100, 200,     3,    30, 50,    3,    200, 100,    100,    250, 150 },   // Xe[W5
+};
+
+//=============================================================================
+//  Sim_Init֐ - Q[Eŏ̏Ԃɂ܂
+//   (seed ŁA͂ƓXe[W\^΁A܂Q[WJɂȂ܂)
+//   stages  NULL ȂAgݍ݂5Xe[Wg܂B
+//   stages ̒ǵAQ[I܂ŏȂł (World ̓Rs[ɎwĂ邾ł)
+//=============================================================================
+void Sim_Init(World& world, unsigned long seed, const StageData* stages, int stageCount)
+{
+    int i;
+
+    // SXe[W̐ݒ
+    if (stages != NULL && stageCount > 0){
+        world.stages = stages;
+        world.stageCount = stageCount;
+    }else{
+        world.stages = s_DefaultStages;
+        world.stageCount = DEFAULT_STAGE_COUNT;
+    }
+
+    // Q[ϐ̏
+    world.gameState = STATE_TITLE;
+    world.jumpBufferTicks = 0;
+    world.quitRequested = false;
+    world.kernel = SIM_KERNEL_GENERIC;
+    world.genericKernel = false;
+    world.time = 0;
+    world.rngSeed = seed & 0xFFFFFFFFUL;
+    world.gameCount = 0;
+    for (i = 0; i < RNG_STREAM_COUNT; i++){
+        Rng_Seed(world.rng[i], Sim_StageSeed(world, 0), (unsigned long)i);
+    }
+    world.score = 0;
+    world.currentStageScore = 0;
+    world.highScore = 0;
+    world.lives = 0;
+    world.currentStage = 0;
+
+    world.player.x = Scalar_FromInt(100); world.player.y = Scalar_FromInt(GROUND_Y - PLAYER_SIZE); world.player.vy = Scalar_FromInt(0);
+    world.player.onGround = true; world.player.state = PSTATE_NORMAL; world.player.stateChangeTime = 0; world.player.missCause = MISS_NONE;
+    world.player.missSide = HIT_NONE; world.player.missTime = Scalar_FromInt(0); world.player.coyoteTicks = 0;
+
+    for (i = 0; i < MAX_OBSTACLES; i++)       { world.obstacleScored[i] = false; world.obstacleX[i] = Scalar_FromInt(0); world.obstacleHeight[i] = 0; }
+    for (i = 0; i < MAX_POPUPS; i++)          { world.popupX[i] = Scalar_FromInt(0); world.popupY[i] = Scalar_FromInt(0); world.popupStartTime[i] = 0; }
+    world.popupCount = 0;
+    for (i = 0; i < NUM_GROUND_SEGMENTS; i++) { world.ground[i].x = Scalar_FromInt(0); world.ground[i].width = 0; world.ground[i].isPit = false; }
+    world.scroll = Scalar_FromInt(0);
+    world.groundHead = 0;
+    world.groundTailX = Scalar_FromInt(0);
+    world.obstacleHead = 0;
+    world.obstacleCount = 0;
+
+    world.endless = false;
+    world.endlessSeed = 0;
+    memset(&world.chunk, 0, sizeof(world.chunk));
+    world.chunkPos = CHUNK_SEGMENTS;
+    world.chunkProvider = NULL;
+    world.chunkContext = NULL;
+}
+
+//=============================================================================
+//  Sim_SetEndless֐ - ̃Q[AGhX[hŗVԂǂ߂܂
+//   (Sim_Init ̌A^Cgʂ̂ɌĂł)
+//=============================================================================
+void Sim_SetEndless(World& world, bool endless)
+{
+    world.endless = endless;
+}
+
+//=============================================================================
+//  Sim_SetChunkProvider֐ - GhX[h̋ԂpӂĂ炤֐߂܂
+//   (NULL ȂAԂKvɂȂƂ Endless_GenerateChunk ł̏ō܂)
+//=============================================================================
+void Sim_SetChunkProvider(World& world, ChunkProvider provider, void* context)
+{
+    world.chunkProvider = provider;
+    world.chunkContext = context;
+}
+
+//=============================================================================
+//  Sim_SetGenericKernel֐ - true ȂAǂ̃Xe[W SIM_KERNEL_GENERIC Ői߂܂
+//   (Xe[Wɍ킹֐ƌʂm߂Aׂ肷ƂɎg܂B
+//    ɃXe[Wn܂Ƃ܂)
+//=============================================================================
+void Sim_SetGenericKernel(World& world, bool generic)
+{
+    world.genericKernel = generic;
+}
+
+//=============================================================================
+//  Sim_Step֐ - Q[E1t[ (SIM_TICK_MS) i߂܂
+//=============================================================================
+void Sim_Step(World& world, const InputFrame& input)
+{
+    world.time += SIM_TICK_MS;
+    world.quitRequested = false;
+
+    switch (world.gameState){
+        case STATE_TITLE:       Sim_UpdateTitle(world, input);      break;
+        case STATE_PLAYING:     Sim_UpdatePlaying(world, input);    break;
+        case STATE_STAGE_CLEAR: Sim_UpdateStageClear(world, input); break;
+        case STATE_GAME_CLEAR:  Sim_UpdateGameClear(world, input);  break;
+        case STATE_GAMEOVER:    Sim_UpdateGameOver(world, input);   break;
+    }
+}
+
+//=============================================================================
+//  ^Cgʂ̏
+//=============================================================================
+static void Sim_UpdateTitle(World& world, const InputFrame& input)
+{
+    if (input.escape) {
+		world.quitRequested = true;
+	}
+
+    // Xy[XL[n߂܂ (Ỏʂ牟ςȂ̂Ƃ́A񗣂Ă)
+    if (input.jumpPressed) {
+		world.gameState = STATE_PLAYING; Sim_ResetGame(world);
+	}
+}
+
+//=============================================================================
+//  Xe[Wi߂֐̐ (traits)
+//=============================================================================
+//   vC̏ (Sim_PlayKernel) ́AXe[Wɂĕς鏊A̍\̂̊֐ɕČ߂܂B
+//   ǂ̊֐g͒萔1sȂ̂ŁARpC͌Ăяȍɖߍ݁A萔 if 
+//   Ă܂܂ (Ƃ̂ȂXe[Wi߂֐ɂ́A̔肪c܂)B
+//   \̂́Aev[ǧ^߂邽߂Ɉœn܂ (Visual C++ 6.0 ́A
+//   ɏoĂȂ^ Sim_PlayKernel<`> Ǝw肷ƁAʂłȂƂ邽߂ł)
+//
+//     Pits       ... Ƃ肤邩 (false ȂAnƃ~X̔Ō𒲂ׂ܂)
+//     Speed      ... ̃XN[̑
+//     NewSegment ... E[ɕtnʂ̕ƌ߂āAǂuǂ߂܂
+
+// ߂ɁAt[ݒ܂ (ȑO Sim_UpdatePlaying Ɠł)
+struct SimTraits_Generic
+{
+    bool   Pits(const World&) const             { return true; }
+    Scalar Speed(const World& world) const      { return Scalar_FromFloat(Sim_Stage(world).scrollSpeed); }
+    void   NewSegment(World& world, GroundSegment& seg) const
+    {
+        if (world.endless) Sim_NextChunkSegment(world, seg); else Sim_NextStageSegment(world, seg, true);
+    }
+};
+
+// Ƃ̂Xe[W
+struct SimTraits_Stage
+{
+    bool   Pits(const World&) const             { return true; }
+    Scalar Speed(const World& world) const      { return Scalar_FromFloat(world.stages[world.currentStage].scrollSpeed); }
+    void   NewSegment(World& world, GroundSegment& seg) const { Sim_NextStageSegment(world, seg, true); }
+};
+
+// Ƃ̂ȂXe[W
+struct SimTraits_Flat
+{
+    bool   Pits(const World&) const             { return false; }
+    Scalar Speed(const World& world) const      { return Scalar_FromFloat(world.stages[world.currentStage].scrollSpeed); }
+    void   NewSegment(World& world, GroundSegment& seg) const { Sim_NextStageSegment(world, seg, false); }
+};
+
+// ƂȂAgݍ݂̃Xe[W1ƓXe[W (萔ɂȂ܂)
+struct SimTraits_FlatStage1 : public SimTraits_Flat
+{
+    Scalar Speed(const World&) const            { return SCALAR_CONST(SIM_STAGE1_SPEED); }
+};
+
+// GhX[h
+struct SimTraits_Endless
+{
+    bool   Pits(const World&) const             { return true; }
+    Scalar Speed(const World& world) const      { return Scalar_FromFloat(world.chunk.stage.scrollSpeed); }
+    void   NewSegment(World& world, GroundSegment& seg) const { Sim_NextChunkSegment(world, seg); }
+};
+
+//=============================================================================
+//  Q[vC̏ ( 炪C̏ł )
+//   (traits ̓Xe[W̐\Ao[ϐ̂Ȃ\̂łBƂɕʂ̊֐܂)
+//=============================================================================
+template <class Traits>
+static void Sim_PlayKernel(World& world, const InputFrame& input, const Traits& traits)
+{
+    int i;
+    unsigned long currentTime = world.time;
+    Scalar currentSpeed = traits.Speed(world);
+    Player& player = world.player;
+
+    // --- ESCL[ꂽQ[I ---
+    if (input.escape)
+    {
+        world.quitRequested = true;
+    }
+
+    // --- u+10vXRAo̍XV (\Ԃ߂) ---
+    //   (ɂ͈Ԍ̂̕ŁAi ͐i߂ɂxׂ܂)
+    for (i = 0; i < world.popupCount; )
+    {
+        if (currentTime - world.popupStartTime[i] > 1000)
+        {
+            Sim_RemovePopup(world, i);
+        }
+        else
+        {
+            world.popupY[i] -= SCALAR_CONST(0.5f);
+            i++;
+        }
+    }
+
+    // --- R[XɃXN[ ---
+    //   (̈ʒu̓R[X̍WȂ̂ŁAscroll 𑝂₷őSɓ܂)
+    world.scroll -= currentSpeed;
+
+    // --- ʂ̍[ɊSɏǂ菜 ---
+    //   (ǂ͍珇ɕł̂ŁA擪Ώ\ł)
+    while (world.obstacleCount > 0 && Sim_ScreenX(world, world.obstacleX[world.obstacleHead]) < Scalar_FromInt(-OBSTACLE_WIDTH))
+    {
+        world.obstacleHead = (world.obstacleHead + 1) % MAX_OBSTACLES;
+        world.obstacleCount--;
+    }
+
+    // --- ʂ̍[ɊSɏnʂAԉEɕtāAVnʂƕǂ𐶐 ---
+    while (Sim_ScreenX(world, world.ground[world.groundHead].x) + Scalar_FromInt(world.ground[world.groundHead].width) < Scalar_FromInt(0))
+    {
+        GroundSegment& seg = world.ground[world.groundHead];
+        world.groundHead = (world.groundHead + 1) % NUM_GROUND_SEGMENTS;
+
+        // VnʂAԉE[ (oĂ groundTailX) ̂ɉEɐ
+        // (Xe[Wł͐ݒɉāAGhX[hł͍ĂԂ珇Ɏo܂)
+        seg.x = world.groundTailX;
+        traits.NewSegment(world, seg);
+        world.groundTailX = seg.x + Scalar_FromInt(seg.width);
+    }
+
+    // --- W傫Ȃ肷AR[XŜɂ炷 ---
+    if (world.scroll >= Scalar_FromInt(TRACK_REBASE_X))
+    {
+        Sim_RebaseTrack(world);
+    }
+
+    // --- vC[̏Ԃɉ ---
+    switch (player.state)
+    {
+        case PSTATE_NORMAL:
+        case PSTATE_RESPAWNING:
+        {
+            // vC[̑ƕZ
+            //   ǂƒnʂ͂̃t[ -currentSpeed ֓܂B~܂Ăǂ猩ƁA
+            //   vC[ (startX, startY)  (dx, dy) ̂ƓȂ̂ŁA̐̏Ŕ肵܂
+            //   (̈ʒu𒲂ׂƁAXe[Wł͕ǂ蔲Ă܂܂)
+            //   uԂ΂炭oĂ (s)Anʂɂ邩AĂ (R[e^C) ȂWv܂
+            if (input.jumpPressed)
+            {
+                world.jumpBufferTicks = JUMP_BUFFER_TICKS;
+            }
+            if (world.jumpBufferTicks > 0 && (player.onGround || player.coyoteTicks > 0))
+            {
+                player.vy = JUMP_POWER;
+                player.onGround = false;
+                player.coyoteTicks = 0;
+                world.jumpBufferTicks = 0;
+            }
+            else if (world.jumpBufferTicks > 0)
+            {
+                world.jumpBufferTicks--;
+            }
+            Scalar dx = -currentSpeed;
+            Scalar startX = player.x - dx, startY = player.y;
+            player.vy += GRAVITY;
+            player.y += player.vy;
+
+            // n (nʂ̍ォ牡؂ƂȀuԂ̑ɒnʂΒn)
+            bool landed = false;
+            Scalar footStart = startY + Scalar_FromInt(PLAYER_SIZE), footEnd = player.y + Scalar_FromInt(PLAYER_SIZE);
+            if (footStart <= Scalar_FromInt(GROUND_Y) && footEnd >= Scalar_FromInt(GROUND_Y))
+            {
+                if (traits.Pits(world))
+                {
+                    Scalar t = (footEnd > footStart) ? (Scalar_FromInt(GROUND_Y) - footStart) / (footEnd - footStart) : SCALAR_CONST(0.0f);
+                    Scalar x = startX + dx * t;
+                    landed = Sim_IsSolidUnder(world, x, x + Scalar_FromInt(PLAYER_SIZE));
+                }
+                else
+                {
+                    landed = true;      // ƂȂ΁A͂ǂłnʂł
+                }
+            }
+            if (landed) { player.y = Scalar_FromInt(GROUND_Y - PLAYER_SIZE); player.vy = Scalar_FromInt(0); player.onGround = true; player.coyoteTicks = COYOTE_TICKS; }
+            else { player.onGround = false; if (player.coyoteTicks > 0) { player.coyoteTicks--; } }
+            Scalar dy = player.y - startY;
+
+            // ~X (GԒ͍sȂ)
+            bool isMiss = false;
+            if (player.state == PSTATE_NORMAL)
+            {
+                // ǂƂ̓蔻 (ԑԂǂ́AƖʂ킩܂)
+                HitSide side;
+                Scalar hitTime = Sim_SweepObstacles(world, startX, startY, dx, dy, side);
+                if (hitTime <= SCALAR_CONST(1.0f)) { isMiss = true; player.missCause = MISS_OBSTACLE; player.missSide = side; player.missTime = hitTime; }
+
+                // Ƃ (nʂ艺ɂ̂ɒnĂȂ΁A̒ɂ܂B
+                // ̌̕ǂɂԂ邩ÂS񂾂~X)
+                if (traits.Pits(world) && !isMiss && !landed && footEnd > Scalar_FromInt(GROUND_Y))
+                {
+                    hitTime = Sim_SweepPitWalls(world, startX, startY, dx, dy, side);
+                    if (hitTime <= SCALAR_CONST(1.0f)) { isMiss = true; player.missCause = MISS_PIT; player.missSide = side; player.missTime = hitTime; }
+                    else if (player.y > Scalar_FromInt(GROUND_Y)) { isMiss = true; player.missCause = MISS_PIT; player.missSide = HIT_NONE; player.missTime = SCALAR_CONST(1.0f); }
+                }
+            }
+            if (isMiss) { world.lives--; player.state = PSTATE_MISS; player.stateChangeTime = currentTime; }
+
+            // XRAZ (vC[ʂ߂ǂA璲ׂ܂)
+            for (i = 0; i < world.obstacleCount; i++) { int slot = Sim_ObstacleSlot(world, i); if (Sim_ScreenX(world, world.obstacleX[slot]) + Scalar_FromInt(OBSTACLE_WIDTH) >= player.x) break; if (!world.obstacleScored[slot]) { world.score += 10; world.currentStageScore += 10; world.obstacleScored[slot] = true; Sim_AddPopup(world, player.x, player.y - Scalar_FromInt(15), currentTime); } }
+
+            // Xe[WNA (GhX[hɂ̓NA͂܂)
+            if (!world.endless && world.currentStageScore >= (unsigned long)world.stages[world.currentStage].clearScore) { world.gameState = STATE_STAGE_CLEAR; }
+
+            // GԂ̏I
+            if (player.state == PSTATE_RESPAWNING && currentTime - player.stateChangeTime > 2000) { player.state = PSTATE_NORMAL; }
+            break;
+        }
+        case PSTATE_MISS:
+        {
+            // ~XA1bɕ邩Q[I[o[ɂȂ
+            if (currentTime - player.stateChangeTime > 1000) { if (world.lives > 0) { player.state = PSTATE_RESPAWNING; player.stateChangeTime = currentTime; player.x = Scalar_FromInt(100); player.y = Scalar_FromInt(GROUND_Y - PLAYER_SIZE); player.vy = Scalar_FromInt(0); player.onGround = true; player.coyoteTicks = 0; world.jumpBufferTicks = 0; } else { if (world.score > world.highScore) { world.highScore = world.score; } world.gameState = STATE_GAMEOVER; } }
+            break;
+        }
+    }
+}
+
+//=============================================================================
+//  Xe[Wi߂֐̕\ (SIM_KERNEL_` ̏)
+//   (ev[g̊֐́AƂ1Aō܂)
+//=============================================================================
+static void Sim_PlayGeneric(World& world, const InputFrame& input)      { Sim_PlayKernel(world, input, SimTraits_Generic()); }
+static void Sim_PlayStage(World& world, const InputFrame& input)        { Sim_PlayKernel(world, input, SimTraits_Stage()); }
+static void Sim_PlayFlat(World& world, const InputFrame& input)         { Sim_PlayKernel(world, input, SimTraits_Flat()); }
+static void Sim_PlayFlatStage1(World& world, const InputFrame& input)   { Sim_PlayKernel(world, input, SimTraits_FlatStage1()); }
+static void Sim_PlayEndless(World& world, const InputFrame& input)      { Sim_PlayKernel(world, input, SimTraits_Endless()); }
+
+typedef void (*SimKernelFunc)(World& world, const InputFrame& input);
+
+static const SimKernelFunc s_Kernels[SIM_KERNEL_COUNT] =
+{
+    Sim_PlayGeneric,
+    Sim_PlayStage,
+    Sim_PlayFlat,
+    Sim_PlayFlatStage1,
+    Sim_PlayEndless,
+};
+
+static const char* const s_KernelNames[SIM_KERNEL_COUNT] =
+{
+    "generic",
+    "stage",
+    "flat",
+    "flat-stage1",
+    "endless",
+};
+
+// Ił֐ŁA1t[i߂܂
+static void Sim_UpdatePlaying(World& world, const InputFrame& input)
+{
+    s_Kernels[world.kernel](world, input);
+}
+
+//=============================================================================
+//  Sim_KernelName֐ - Xe[Wi߂֐̖OԂ܂ (vʂ̕\p)
+//=============================================================================
+const char* Sim_KernelName(int kernel)
+{
+    if (kernel < 0 || kernel >= SIM_KERNEL_COUNT){
+        return "?";
+    }
+    return s_KernelNames[kernel];
+}
+
+//=============================================================================
+//  Sim_NextStageSegment֐ - Xe[W̐ݒɉāAVn seg (x ͌߂Ă܂) ܂
+//   (pits  false ȂAƂɂ邩̒IȂ܂BpitChance  0 ̃Xe[Wł́A
+//    ƂƒIȂ̂ŁAʂ͕ς܂)
+//=============================================================================
+static void Sim_NextStageSegment(World& world, GroundSegment& seg, bool pits)
+{
+    // Xe[WݒɉėƂɂ邩߂
+    const StageData& stage = world.stages[world.currentStage];
+    Rng& terrain = world.rng[RNG_TERRAIN];
+    Rng& obstacles = world.rng[RNG_OBSTACLES];
+    if (pits && stage.pitChance > 0 && Rng_Range(terrain, stage.pitChance) == 0)
+    {
+        seg.isPit = true;
+        seg.width = stage.pitWidthMin + Rng_Range(terrain, stage.pitWidthRange);
+    }
+    else
+    {
+        seg.isPit = false;
+        seg.width = stage.groundWidthMin + Rng_Range(terrain, stage.groundWidthRange);
+
+        // VnʂƂłȂ΁Amŕǂu (ǂ̗̈ԉEɑ܂)
+        if (stage.obstacleChance > 0 && Rng_Range(obstacles, stage.obstacleChance) == 0)
+        {
+            if (world.obstacleCount < stage.obstacleLimit)
+            {
+                int slot = Sim_ObstacleSlot(world, world.obstacleCount);
+                world.obstacleScored[slot] = false;
+                world.obstacleHeight[slot] = stage.obstacleHeightMin + Rng_Range(obstacles, stage.obstacleHeightRange);
+                int random_pos = Rng_Range(obstacles, seg.width - OBSTACLE_WIDTH);
+                world.obstacleX[slot] = seg.x + Scalar_FromInt(random_pos);
+                world.obstacleCount++;
+            }
+        }
+    }
+}
+
+//=============================================================================
+//  eʂ̏
+//=============================================================================
+//   (ǂ̉ʂAXy[XL[VƂi݂܂BWvŉςȂɂĂĂA
+//    ʂǂݔ΂Ă܂Ƃ͂܂)
+static void Sim_UpdateStageClear(World& world, const InputFrame& input)
+{
+	if (input.jumpPressed) {
+		Sim_StartNextStage(world);
+	}
+}
+
+static void Sim_UpdateGameClear(World& world, const InputFrame& input)
+{
+	if (input.jumpPressed) {
+		world.gameState = STATE_TITLE;
+	}
+}
+
+static void Sim_UpdateGameOver(World& world, const InputFrame& input)
+{
+	if (input.jumpPressed) {
+		world.gameState = STATE_TITLE;
+	}
+
+	if (input.escape){
+		world.quitRequested = true;
+	}
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// ̋ left`right ̐^ɁAƂłȂnʂł true Ԃ܂
+static bool Sim_IsSolidUnder(const World& world, Scalar left, Scalar right)
+{
+	int i;
+	for (i = 0; i < NUM_GROUND_SEGMENTS; i++) {
+		const GroundSegment& seg = Sim_GroundAt(world, i);
+		Scalar segX = Sim_ScreenX(world, seg.x);
+		if (segX >= right) break;
+		if (left < segX + Scalar_FromInt(seg.width) && !seg.isPit) return true;
+	}
+	return false;
+}
+
+// 1̃XC[v: p0  d  PLAYER_SIZE ̋ԂAlo`hi ƏdȂĂ鎞 enter`leave
+// ( 0.0 t[̎n߁A1.0 IBĂȂ́AdȂĂ΁uƁvAȂ΁uxvł)
+static void Sim_SweepAxis(Scalar p0, Scalar d, Scalar invD, Scalar lo, Scalar hi, Scalar& enter, Scalar& leave)
+{
+	// (ǂ܂Ƃ߂ČvZł悤ɁAif ŕɗvZđIт܂)
+	Scalar t1 = (lo - Scalar_FromInt(PLAYER_SIZE) - p0) * invD;
+	Scalar t2 = (hi - p0) * invD;
+	Scalar still = ((p0 + Scalar_FromInt(PLAYER_SIZE) > lo) & (p0 < hi)) ? -SWEEP_FOREVER : SWEEP_FOREVER;
+	enter = (d != SCALAR_CONST(0.0f)) ? ((t1 < t2) ? t1 : t2) : still;
+	leave = (d != SCALAR_CONST(0.0f)) ? ((t1 < t2) ? t2 : t1) : -still;
+}
+
+// vC[̔ ( x0,y0)  (dx, dy) ԂɁA~܂Ă锠 (,,E,) ƏdȂn߂鎞Ԃ܂B
+// dȂȂ SWEEP_MISS (1.0 傫l) Ԃ܂BӂGĂ邾ȂAdȂƂɂ͂܂
+// (ȑO IntersectRect Ɠł)BinvDx, invDy  dx, dy ̋t (0 ̂Ƃ͉ł܂܂)
+static Scalar Sim_SweepBox(Scalar x0, Scalar y0, Scalar dx, Scalar dy, Scalar invDx, Scalar invDy, Scalar l, Scalar t, Scalar r, Scalar b, HitSide& side)
+{
+	Scalar enterX, leaveX, enterY, leaveY;
+	Sim_SweepAxis(x0, dx, invDx, l, r, enterX, leaveX);
+	Sim_SweepAxis(y0, dy, invDy, t, b, enterY, leaveY);
+
+	// ̎ŏdȂn߂ƂuԂvŁAŌɏdȂ̖ʂɂԂĂ܂
+	// dȂĂ鎞Ԃ̃t[ (0.0`1.0) ɐ؂l߂āA܂cĂ΂ԂĂ܂
+	// (t[̎n߂dȂĂ 0 ł)
+	Scalar enter = (enterX > enterY) ? enterX : enterY;
+	Scalar leave = (leaveX < leaveY) ? leaveX : leaveY;
+	enter = (enter > SCALAR_CONST(0.0f)) ? enter : SCALAR_CONST(0.0f);
+	leave = (leave < SCALAR_CONST(1.0f)) ? leave : SCALAR_CONST(1.0f);
+	side = (enterX > enterY) ? ((dx > SCALAR_CONST(0.0f)) ? HIT_LEFT : HIT_RIGHT) : ((dy > SCALAR_CONST(0.0f)) ? HIT_TOP : HIT_BOTTOM);
+	return (enter < leave) ? enter : SWEEP_MISS;
+}
+
+// ׂĂ̕ǂƂ̃XC[vŁAԑԂ鎞Ԃ܂ (Ȃ SWEEP_MISS)B
+// 1ڂ̃[v́Az MAX_OBSTACLES ̘gׂĂAgĂ邩ǂɊ֌WȂvZŒׂ܂B
+// gƂɓƗ̂ȂvZȂ̂ŁARpC܂Ƃ߂ČvZ (xNg) ł܂B
+// gĂgIԂ̂́A2ڂ̃[v (̕ǂ珇ɁAԑT) ōs܂
+static Scalar Sim_SweepObstacles(const World& world, Scalar x0, Scalar y0, Scalar dx, Scalar dy, HitSide& side)
+{
+	int i, slot;
+	Scalar invDx = (dx != SCALAR_CONST(0.0f)) ? SCALAR_CONST(1.0f) / dx : SCALAR_CONST(0.0f);
+	Scalar invDy = (dy != SCALAR_CONST(0.0f)) ? SCALAR_CONST(1.0f) / dy : SCALAR_CONST(0.0f);
+	Scalar time[MAX_OBSTACLES];
+	int horizontal[MAX_OBSTACLES];      // ̖ʂɂԂ
+
+	for (slot = 0; slot < MAX_OBSTACLES; slot++) {
+		Scalar left = Sim_ScreenX(world, world.obstacleX[slot]);
+		Scalar enterX, leaveX, enterY, leaveY;
+		Sim_SweepAxis(x0, dx, invDx, left, left + Scalar_FromInt(OBSTACLE_WIDTH), enterX, leaveX);
+		Sim_SweepAxis(y0, dy, invDy, Scalar_FromInt(GROUND_Y - world.obstacleHeight[slot]), Scalar_FromInt(GROUND_Y), enterY, leaveY);
+
+		// ̎ŏdȂn߂ƂuԂvŁAŌɏdȂ̖ʂɂԂĂ܂B
+		// dȂĂ鎞Ԃ̃t[ (0.0`1.0) ɐ؂l߂āA܂cĂ΂ԂĂ܂
+		Scalar enter = (enterX > enterY) ? enterX : enterY;
+		Scalar leave = (leaveX < leaveY) ? leaveX : leaveY;
+		enter = (enter > SCALAR_CONST(0.0f)) ? enter : SCALAR_CONST(0.0f);
+		leave = (leave < SCALAR_CONST(1.0f)) ? leave : SCALAR_CONST(1.0f);
+		time[slot] = (enter < leave) ? enter : SWEEP_MISS;
+		horizontal[slot] = enterX > enterY;
+	}
+
+	Scalar first = SWEEP_MISS;
+	side = HIT_NONE;
+	for (i = 0; i < world.obstacleCount; i++) {
+		slot = Sim_ObstacleSlot(world, i);
+		if (time[slot] < first) {
+			first = time[slot];
+			if (horizontal[slot]) side = (dx > SCALAR_CONST(0.0f)) ? HIT_LEFT : HIT_RIGHT;
+			else side = (dy > SCALAR_CONST(0.0f)) ? HIT_TOP : HIT_BOTTOM;
+		}
+	}
+	return first;
+}
+
+// Ƃ̒̃vC[Âӂ (ƂłȂnʂ̑) ɂԂ鎞Ԃ܂ (Ȃ SWEEP_MISS)B
+// nʂ́Anʂ̍牺ɂƑƂĈ܂
+static Scalar Sim_SweepPitWalls(const World& world, Scalar x0, Scalar y0, Scalar dx, Scalar dy, HitSide& side)
+{
+	int i;
+	Scalar invDx = (dx != SCALAR_CONST(0.0f)) ? SCALAR_CONST(1.0f) / dx : SCALAR_CONST(0.0f);
+	Scalar invDy = (dy != SCALAR_CONST(0.0f)) ? SCALAR_CONST(1.0f) / dy : SCALAR_CONST(0.0f);
+	Scalar reach = ((dx > SCALAR_CONST(0.0f)) ? x0 + dx : x0) + Scalar_FromInt(PLAYER_SIZE);     // ̃t[œ͂E[
+	Scalar first = SWEEP_MISS;
+
+	side = HIT_NONE;
+	for (i = 0; i < NUM_GROUND_SEGMENTS; i++) {
+		const GroundSegment& seg = Sim_GroundAt(world, i);
+		Scalar segX = Sim_ScreenX(world, seg.x);
+		if (segX >= reach) break;
+		if (seg.isPit) continue;
+		HitSide s;
+		Scalar t = Sim_SweepBox(x0, y0, dx, dy, invDx, invDy, segX, Scalar_FromInt(GROUND_Y), segX + Scalar_FromInt(seg.width), Scalar_FromInt(GROUND_Y + SCREEN_HEIGHT), s);
+		if (t < first) { first = t; side = s; }
+	}
+	return first;
+}
+
+// a  b ̊Ԃ alpha (0.0`1.0) ̊ŕԂ܂B
+// 傫[v (W炵̃R[XAvC[) ͕ԂÄʒug܂
+static Scalar Sim_Lerp(Scalar a, Scalar b, Scalar alpha)
+{
+	Scalar d = b - a;
+	if (d > SCALAR_CONST(100.0f) || d < SCALAR_CONST(-100.0f)) {
+		return b;
+	}
+	return a + d * alpha;
+}
+
+// u+10ṽXRA\Ԍɑ܂ (ς̂Ƃ͏o܂)
+static void Sim_AddPopup(World& world, Scalar x, Scalar y, unsigned long startTime)
+{
+	if (world.popupCount >= MAX_POPUPS) {
+		return;
+	}
+	int n = world.popupCount++;
+	world.popupX[n] = x;
+	world.popupY[n] = y;
+	world.popupStartTime[n] = startTime;
+}
+
+// i Ԗڂ̃XRA\āA󂢂ɈԌ̕ڂ܂
+static void Sim_RemovePopup(World& world, int i)
+{
+	int last = --world.popupCount;
+	world.popupX[i] = world.popupX[last];
+	world.popupY[i] = world.popupY[last];
+	world.popupStartTime[i] = world.popupStartTime[last];
+}
+
+// R[XŜ̍W TRACK_REBASE_X ɂ炵܂ (ʏ̈ʒu͕ς܂)
+static void Sim_RebaseTrack(World& world)
+{
+	int i;
+	Scalar rebase = Scalar_FromInt(TRACK_REBASE_X);
+	world.scroll -= rebase;
+	world.groundTailX -= rebase;
+	for (i = 0; i < NUM_GROUND_SEGMENTS; i++) { world.ground[i].x -= rebase; }
+	for (i = 0; i < MAX_OBSTACLES; i++)       { world.obstacleX[i] -= rebase; }
+}
+
+//=============================================================================
+//  Sim_Interpolate֐ - `pɁAÕt[ƍ̃t[̊Ԃ̏Ԃ܂
+//   (Q[̐iݕ͈Ԋû܂܂ŁAʂ̓Ȃ߂炩ɂ܂)
+//=============================================================================
+void Sim_Interpolate(const World& prev, const World& cur, float alpha, World& out)
+{
+	int i, j;
+	Scalar a = Scalar_FromFloat(alpha);
+	out = cur;
+
+	// ʂ؂ւ́AȌԂƔׂĂӖ܂
+	if (prev.gameState != cur.gameState || prev.currentStage != cur.currentStage) {
+		return;
+	}
+
+	out.player.x = Sim_Lerp(prev.player.x, cur.player.x, a);
+	out.player.y = Sim_Lerp(prev.player.y, cur.player.y, a);
+
+	// nʂƕǂ̓R[X̍WȂ̂ŁAXN[ʂԂ邾ōς݂܂
+	out.scroll = Sim_Lerp(prev.scroll, cur.scroll, a);
+
+	// XRA\͏Ƃɕяς̂ŁAoƈʒuǂԂ܂
+	for (i = 0; i < cur.popupCount; i++) {
+		for (j = 0; j < prev.popupCount; j++) {
+			if (prev.popupStartTime[j] == cur.popupStartTime[i] && prev.popupX[j] == cur.popupX[i]) {
+				out.popupY[i] = Sim_Lerp(prev.popupY[j], cur.popupY[i], a);
+				break;
+			}
+		}
+	}
+}
+
+//=============================================================================
+//  Sim_StageSeed֐ - Xe[W̗̎Ԃ܂
+//   (Q[̎EQ[ڂEʂŌ܂̂ŁAʂ͉xVł
+//    n`ɂȂA̖ʂoĒׂ邱Ƃł܂)
+//=============================================================================
+unsigned long Sim_StageSeed(const World& world, int stage)
+{
+	unsigned int h = Rng_Hash((unsigned int)world.rngSeed);
+	h = Rng_Hash(h ^ (unsigned int)world.gameCount);
+	h = Rng_Hash(h ^ (unsigned int)stage);
+	return h;
+}
+
+//=============================================================================
+//  Sim_EndlessSeed֐ - game Q[ڂ̃GhX[h̃R[X̎Ԃ܂
+//   (̃Q[̋Ԃɍn߂ƂɂĝŁAQ[ڂŎ󂯎܂)
+//=============================================================================
+unsigned long Sim_EndlessSeed(const World& world, unsigned long game)
+{
+	unsigned int h = Rng_Hash((unsigned int)world.rngSeed);
+	h = Rng_Hash(h ^ (unsigned int)game);
+	h = Rng_Hash(h ^ 0x454E444CU);      // "ENDL" (Xe[W̎ƏdȂȂ悤)
+	return h;
+}
+
+//=============================================================================
+//  Sim_Hash֐ - Q[ȄԂAŵ悤Ȑl (nbVl) ܂
+//   (vČʂSɈvĂ邩m߂̂Ɏg܂)
+//=============================================================================
+static void Sim_HashBytes(unsigned long& h, const void* data, int size)
+{
+	int i;
+	const unsigned char* p = (const unsigned char*)data;
+	for (i = 0; i < size; i++) {
+		h = ((h ^ p[i]) * 16777619UL) & 0xFFFFFFFFUL;   // FNV-1a
+	}
+}
+
+static void Sim_HashInt(unsigned long& h, unsigned long v)
+{
+	unsigned char b[4];
+	b[0] = (unsigned char)(v); b[1] = (unsigned char)(v >> 8); b[2] = (unsigned char)(v >> 16); b[3] = (unsigned char)(v >> 24);
+	Sim_HashBytes(h, b, 4);
+}
+
+// ʒu⑬́Ag̃rbĝ܂܍܂ (float ƌŒ菬_ł́AႤnbVlɂȂ܂)
+static void Sim_HashScalar(unsigned long& h, Scalar s)
+{
+	Sim_HashInt(h, Scalar_Bits(s));
+}
+
+unsigned long Sim_Hash(const World& world)
+{
+	int i;
+	unsigned long h = 2166136261UL;
+
+	Sim_HashInt(h, world.gameState);
+	Sim_HashInt(h, (unsigned long)world.jumpBufferTicks);
+	Sim_HashInt(h, world.time);
+	Sim_HashInt(h, world.gameCount);
+	for (i = 0; i < RNG_STREAM_COUNT; i++) {
+		Sim_HashInt(h, world.rng[i].s[0]); Sim_HashInt(h, world.rng[i].s[1]);
+		Sim_HashInt(h, world.rng[i].s[2]); Sim_HashInt(h, world.rng[i].s[3]);
+	}
+	Sim_HashInt(h, world.score);
+	Sim_HashInt(h, world.currentStageScore);
+	Sim_HashInt(h, world.highScore);
+	Sim_HashInt(h, (unsigned long)world.lives);
+	Sim_HashInt(h, (unsigned long)world.currentStage);
+
+	Sim_HashScalar(h, world.player.x);
+	Sim_HashScalar(h, world.player.y);
+	Sim_HashScalar(h, world.player.vy);
+	Sim_HashInt(h, world.player.onGround);
+	Sim_HashInt(h, (unsigned long)world.player.coyoteTicks);
+	Sim_HashInt(h, world.player.state);
+	Sim_HashInt(h, world.player.stateChangeTime);
+
+	Sim_HashScalar(h, world.scroll);
+	Sim_HashScalar(h, world.groundTailX);
+	Sim_HashInt(h, (unsigned long)world.obstacleCount);
+
+	for (i = 0; i < world.obstacleCount; i++) {
+		int slot = Sim_ObstacleSlot(world, i);
+		Sim_HashScalar(h, world.obstacleX[slot]);
+		Sim_HashInt(h, (unsigned long)world.obstacleHeight[slot]);
+		Sim_HashInt(h, world.obstacleScored[slot]);
+	}
+	Sim_HashInt(h, (unsigned long)world.popupCount);
+	for (i = 0; i < world.popupCount; i++) {
+		Sim_HashScalar(h, world.popupX[i]);
+		Sim_HashScalar(h, world.popupY[i]);
+		Sim_HashInt(h, world.popupStartTime[i]);
+	}
+	for (i = 0; i < NUM_GROUND_SEGMENTS; i++) {
+		const GroundSegment& seg = Sim_GroundAt(world, i);
+		Sim_HashScalar(h, seg.x);
+		Sim_HashInt(h, (unsigned long)seg.width);
+		Sim_HashInt(h, seg.isPit);
+	}
+
+	// GhX[ĥƂ (Xe[WŗV񂾂Ƃ̃nbVĺAȑOƕς܂)
+	if (world.endless) {
+		Sim_HashInt(h, world.endlessSeed);
+		Sim_HashInt(h, world.chunk.index);
+		Sim_HashInt(h, (unsigned long)world.chunkPos);
+	}
+	return h;
+}
+
+//=============================================================================
+//  Sim_StageHash֐ - Xe[W\̒gAnbVl܂
+//   (stages  NULL ȂASim_Init Ɠgݍ݂5Xe[W̃nbVlłB
+//    vCƃS[Xg̃t@CɏĂAႤXe[W\ŋL^̂͂̂Ɏg܂)
+//=============================================================================
+unsigned long Sim_StageHash(const StageData* stages, int stageCount)
+{
+	int i;
+	unsigned long h = 2166136261UL;
+
+	if (stages == NULL || stageCount <= 0){
+		stages = s_DefaultStages;
+		stageCount = DEFAULT_STAGE_COUNT;
+	}
+
+	// \̂̌ԂѕɍEȂ悤ɁA1܂
+	Sim_HashInt(h, (unsigned long)stageCount);
+	for (i = 0; i < stageCount; i++){
+		const StageData& s = stages[i];
+		unsigned int speedBits;
+		memcpy(&speedBits, &s.scrollSpeed, 4);
+		Sim_HashInt(h, speedBits);
+		Sim_HashInt(h, (unsigned long)s.clearScore);
+		Sim_HashInt(h, (unsigned long)s.pitChance);
+		Sim_HashInt(h, (unsigned long)s.pitWidthMin);
+		Sim_HashInt(h, (unsigned long)s.pitWidthRange);
+		Sim_HashInt(h, (unsigned long)s.groundWidthMin);
+		Sim_HashInt(h, (unsigned long)s.groundWidthRange);
+		Sim_HashInt(h, (unsigned long)s.obstacleChance);
+		Sim_HashInt(h, (unsigned long)s.obstacleHeightMin);
+		Sim_HashInt(h, (unsigned long)s.obstacleHeightRange);
+		Sim_HashInt(h, (unsigned long)s.obstacleLimit);
+		Sim_HashInt(h, (unsigned long)s.startGroundMin);
+		Sim_HashInt(h, (unsigned long)s.startGroundRange);
+		Sim_HashInt(h, (unsigned long)s.firstObstacleX);
+		Sim_HashInt(h, (unsigned long)s.obstacleGapMin);
+		Sim_HashInt(h, (unsigned long)s.obstacleGapRange);
+	}
+	return h;
+}
+
+// Xe[Wݒ̕EԊȕ ( + ̕𒴂Xe[W͂͂܂B
+// Œ菬_̂ƂłAR[X̍W TRACK_REBASE_X ̉{ɂȂȂ悤ɂ܂)
+#define STAGE_MAX_WIDTH     4096
+
+//=============================================================================
+//  Sim_IsValidStage֐ - Xe[Wݒ肪AQ[Ȃ͈͂Ɏ܂Ă邩ׂ܂
+//   (Xe[WpbNƂƓǂݍނƂɎg܂B0 Ŋ闐̌vZA
+//    ǂnʂ͂ݏoݒAnʂ̗񂪉ʂ̕ɑȂȂݒł͂܂)
+//=============================================================================
+bool Sim_IsValidStage(const StageData& stage)
+{
+    double scroll, narrowest;
+
+    if (!(stage.scrollSpeed < 0.0f && stage.scrollSpeed > -100.0f)) return false;
+    if (stage.clearScore <= 0) return false;
+    if (stage.pitChance < 0 || stage.pitWidthMin <= 0 || stage.pitWidthRange <= 0) return false;
+    if (stage.groundWidthMin <= OBSTACLE_WIDTH || stage.groundWidthRange <= 0) return false;
+    if (stage.obstacleChance < 0 || stage.obstacleHeightMin <= 0 || stage.obstacleHeightRange <= 0) return false;
+    if (stage.obstacleHeightMin + stage.obstacleHeightRange > GROUND_Y) return false;
+    if (stage.obstacleLimit < 1 || stage.obstacleLimit > MAX_OBSTACLES) return false;
+    if (stage.startGroundRange <= 0) return false;
+    if (stage.pitWidthMin > STAGE_MAX_WIDTH - stage.pitWidthRange) return false;
+    if (stage.groundWidthMin > STAGE_MAX_WIDTH - stage.groundWidthRange) return false;
+    if (stage.startGroundMin > STAGE_MAX_WIDTH - stage.startGroundRange) return false;
+
+    // łn (Ƃnʂ1ł) SԋĂA1t[XN[
+    // ʂ̕蒷Ȃ΂܂BȂƁAʂ̓rɉȂłāAɒnʂ܂
+    // (傫Ȓlł int ̊|ZӂȂ悤ɁAdouble ŌvZ܂)
+    scroll = -stage.scrollSpeed;
+    narrowest = (stage.groundWidthMin < stage.pitWidthMin) ? stage.groundWidthMin : stage.pitWidthMin;
+    if (narrowest * NUM_GROUND_SEGMENTS <= SCREEN_WIDTH + scroll) return false;
+    if ((double)stage.startGroundMin * NUM_GROUND_SEGMENTS <= SCREEN_WIDTH + scroll) return false;
+    if (stage.firstObstacleX < 0 || stage.firstObstacleX > STAGE_MAX_WIDTH) return false;
+    if (stage.obstacleGapMin <= OBSTACLE_WIDTH || stage.obstacleGapRange <= 0) return false;
+    if (stage.obstacleGapMin > STAGE_MAX_WIDTH - stage.obstacleGapRange) return false;
+    return true;
+}
+
+//=============================================================================
+//  Xe[WJnEQ[Zbg̏ (ǂ̏zuC)
+//=============================================================================
+void Sim_StartNextStage(World& world)
+{
+    int i;
+    world.currentStage++;
+    world.jumpBufferTicks = 0;
+    world.player.coyoteTicks = 0;
+    if (world.endless)
+    {
+        Sim_StartEndless(world);
+    }
+    else if (world.currentStage >= world.stageCount)
+    {
+        if (world.score > world.highScore) { world.highScore = world.score; }
+        world.gameState = STATE_GAME_CLEAR;
+    }
+    else
+    {
+        world.currentStageScore = 0;
+        world.player.state = PSTATE_NORMAL;
+        world.player.x = Scalar_FromInt(100); world.player.y = Scalar_FromInt(GROUND_Y - PLAYER_SIZE); world.player.vy = Scalar_FromInt(0); world.player.onGround = true;
+
+        // ̃Xe[W̗AXe[W̎킩蒼܂
+        unsigned long stageSeed = Sim_StageSeed(world, world.currentStage);
+        for (i = 0; i < RNG_STREAM_COUNT; i++)
+        {
+            Rng_Seed(world.rng[i], stageSeed, (unsigned long)i);
+        }
+
+        // R[Xŏ̈ʒuɖ߂āAnʂƕǂ珇ɕׂ܂ (וXe[W̐ݒɏ]܂)
+        const StageData& stage = world.stages[world.currentStage];
+        world.scroll = Scalar_FromInt(0);
+
+        int current_x = 0;
+        for(i=0; i < NUM_GROUND_SEGMENTS; i++)
+        {
+            world.ground[i].x = Scalar_FromInt(current_x);
+            world.ground[i].isPit = false;
+            world.ground[i].width = stage.startGroundMin + Rng_Range(world.rng[RNG_TERRAIN], stage.startGroundRange);
+            current_x += world.ground[i].width;
+        }
+        world.groundHead = 0;
+        world.groundTailX = Scalar_FromInt(current_x);
+
+        Rng& obstacles = world.rng[RNG_OBSTACLES];
+        world.obstacleScored[0] = false; world.obstacleHeight[0] = stage.obstacleHeightMin + Rng_Range(obstacles, stage.obstacleHeightRange);
+        world.obstacleX[0] = Scalar_FromInt(SCREEN_WIDTH + stage.firstObstacleX);
+        for (i = 1; i < stage.obstacleLimit; i++)
+        {
+            world.obstacleScored[i] = false; world.obstacleHeight[i] = stage.obstacleHeightMin + Rng_Range(obstacles, stage.obstacleHeightRange);
+            world.obstacleX[i] = world.obstacleX[i-1] + Scalar_FromInt(stage.obstacleGapMin + Rng_Range(obstacles, stage.obstacleGapRange));
+        }
+        world.obstacleHead = 0;
+        world.obstacleCount = stage.obstacleLimit;
+        Sim_ChooseKernel(world);
+        world.gameState = STATE_PLAYING;
+    }
+}
+
+//=============================================================================
+//  Sim_ChooseKernel֐ - n܂Xe[W̐ݒ肩AXe[Wi߂֐Iт܂
+//   (Xe[W̓rŐݒ肪ς邱Ƃ͂Ȃ̂ŁAt[ׂKv͂܂)
+//=============================================================================
+static void Sim_ChooseKernel(World& world)
+{
+    if (world.genericKernel){
+        world.kernel = SIM_KERNEL_GENERIC;
+    }else if (world.endless){
+        world.kernel = SIM_KERNEL_ENDLESS;
+    }else if (world.stages[world.currentStage].pitChance > 0){
+        world.kernel = SIM_KERNEL_STAGE;
+    }else if (world.stages[world.currentStage].scrollSpeed == SIM_STAGE1_SPEED){
+        world.kernel = SIM_KERNEL_FLAT_STAGE1;
+    }else{
+        world.kernel = SIM_KERNEL_FLAT;
+    }
+}
+
+//=============================================================================
+//  GhX[h̊JnƁAԂR[Xׂ鏈
+//=============================================================================
+static void Sim_StartEndless(World& world)
+{
+    int i;
+    world.currentStageScore = 0;
+    world.player.state = PSTATE_NORMAL;
+    world.player.x = Scalar_FromInt(100); world.player.y = Scalar_FromInt(GROUND_Y - PLAYER_SIZE); world.player.vy = Scalar_FromInt(0); world.player.onGround = true;
+
+    // R[X̎̓Q[Ƃɕς܂Bop̗A̎킩܂
+    world.endlessSeed = Sim_EndlessSeed(world, world.gameCount);
+    for (i = 0; i < RNG_STREAM_COUNT; i++)
+    {
+        Rng_Seed(world.rng[i], world.endlessSeed, (unsigned long)i);
+    }
+
+    // ŏ̋ԂAʂ̍[珇ɒnʂׂ܂
+    // (ŏ̋Ԃ̎n߂͕ȒnʂȂ̂ŁAǂ͉ʂ̊O痈܂)
+    world.scroll = Scalar_FromInt(0);
+    world.obstacleHead = 0;
+    world.obstacleCount = 0;
+    world.groundHead = 0;
+    world.groundTailX = Scalar_FromInt(0);
+    Sim_LoadChunk(world, 0);
+    for (i = 0; i < NUM_GROUND_SEGMENTS; i++)
+    {
+        world.ground[i].x = world.groundTailX;
+        Sim_NextChunkSegment(world, world.ground[i]);
+        world.groundTailX += Scalar_FromInt(world.ground[i].width);
+    }
+    Sim_ChooseKernel(world);
+    world.gameState = STATE_PLAYING;
+}
+
+// index Ԗڂ̋ԂpӂāA̎n߂ׂ悤ɂ܂
+static void Sim_LoadChunk(World& world, unsigned long index)
+{
+    if (world.chunkProvider != NULL)
+    {
+        world.chunkProvider(world.chunkContext, world.endlessSeed, index, world.chunk);
+    }
+    else
+    {
+        Endless_GenerateChunk(world.endlessSeed, index, world.chunk);
+    }
+    world.chunkPos = 0;
+}
+
+// Ԃ玟̒nʂ1oāAseg (x ͌߂Ă܂) ɓ܂Bǂ΁Aǂ̗̈ԉEɑ܂
+static void Sim_NextChunkSegment(World& world, GroundSegment& seg)
+{
+    if (world.chunkPos >= CHUNK_SEGMENTS)
+    {
+        Sim_LoadChunk(world, world.chunk.index + 1);
+    }
+    const ChunkSegment& next = world.chunk.segments[world.chunkPos++];
+    seg.width = next.width;
+    seg.isPit = next.isPit != 0;
+
+    if (next.obstacleHeight > 0 && world.obstacleCount < world.chunk.stage.obstacleLimit)
+    {
+        int slot = Sim_ObstacleSlot(world, world.obstacleCount);
+        world.obstacleScored[slot] = false;
+        world.obstacleHeight[slot] = next.obstacleHeight;
+        world.obstacleX[slot] = seg.x + Scalar_FromInt(next.obstacleOffset);
+        world.obstacleCount++;
+    }
+}
+
+void Sim_ResetGame(World& world)
+{
+    world.score = 0;
+	world.currentStageScore = 0;
+	world.lives = 3;
+	world.currentStage = -1;
+	world.gameCount++;
+	Sim_StartNextStage(world);
+}
@@ -0,0 +1,274 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Q[WbN (V~[V) 
+//
+//  windows.h  ddraw.h ؎gȂA C++ ̃Q[łB
+//  Windows (main.cpp) ALinuxp̃wbhX (headless.cpp) 
+//  R[hg܂B
+//
+//  g:
+//    World world;
+//    Sim_Init(world, seed, NULL, 0);   // ŏ1 (Xe[W\nȂ΁Agݍ݂5Xe[W)
+//    Sim_Step(world, input);           // 1t[Ƃ1
+//
+//  vC1t[́AXe[W̎n߂ɑI񂾁uXe[Wi߂֐v(SIM_KERNEL_`) Ői߂܂B
+//  ƂȂXe[Wł͌̔A܂ĂXe[Wł͑̓ǂݏoA
+//  ŏȂ֐ɂȂĂ܂ (ǂ̊֐Ői߂ĂAʂ͂܂ł)B
+//
+//  ʒu⑬ Scalar ^ (scalar.h) łBӂ float łAJJ_FIXED_POINT `
+//  rhƌŒ菬_ɂȂAǂ̃RpCŃrhĂWJɂȂ܂B
+//
+//=============================================================================
+#ifndef SIM_H
+#define SIM_H
+
+#include "rng.h"
+#include "scalar.h"
+
+//-----------------------------------------------------------------------------
+//  Q[ŜŎgݒl (}N)
+//-----------------------------------------------------------------------------
+#define SCREEN_WIDTH        640
+#define SCREEN_HEIGHT       480
+#define MAX_POPUPS          5
+#define MAX_OBSTACLES       8       // R[Xɓɒuǂ̐̏ (ۂ̐̓Xe[WƂɌ߂܂)
+#define NUM_GROUND_SEGMENTS 10      // R[Xɕłnʃp[c̐
+#define CHUNK_SEGMENTS      16      // GhX[h1 (`N) ɓĂnʃp[c̐ (4`5)
+
+// 1t[Őiގ (~b)BQ[̎v͂̒li݂܂
+#define SIM_TICK_MS         16
+
+// Q[WbN̔ŔԍB͂łʂς悤ȏC1₵܂
+// (ÂvCĐāAႤWJɂȂĂ܂̂h܂)
+#define SIM_VERSION         6
+
+// XN[ʂ̒l𒴂AR[XŜ̍W܂Ƃ߂čɂ炵܂
+// (float ̒l傫Ȃ肷Đx̂ƁAŒ菬_\͈͂͂ݏôh܂)
+#ifdef JJ_FIXED_POINT
+#define TRACK_REBASE_X      16384
+#else
+#define TRACK_REBASE_X      65536
+#endif
+
+//-----------------------------------------------------------------------------
+//  Q[̏ԂǗ邽߂̖O` (enum)
+//-----------------------------------------------------------------------------
+// Q[Ŝ̐is
+enum GameState{
+    STATE_TITLE,
+    STATE_PLAYING,
+    STATE_STAGE_CLEAR,
+    STATE_GAME_CLEAR,
+    STATE_GAMEOVER
+};
+
+// vC[l̏
+enum PlayerState{
+    PSTATE_NORMAL,
+    PSTATE_MISS,
+    PSTATE_RESPAWNING
+};
+
+// ŌɃ~X (Փx̓vɎg܂BQ[̐isɂ͉e܂)
+enum MissCause{
+    MISS_NONE,
+    MISS_OBSTACLE,      // ǂɂԂ
+    MISS_PIT            // Ƃɗ
+};
+
+// Ԃ̂A̔̂ǂ̖ʂ (XC[v̌ʁB~X̓vɎg܂)
+enum HitSide{
+    HIT_NONE,
+    HIT_LEFT,           // ̖ (瑖荞)
+    HIT_RIGHT,          // E̖
+    HIT_TOP,            // ̖ (ォ痎Ă)
+    HIT_BOTTOM          // ̖
+};
+
+// vC̃Xe[Wi߂֐̎ (Sim_StartNextStage ŁAXe[W̐ݒ肩1Iт܂)
+enum SimKernel{
+    SIM_KERNEL_GENERIC,         // ߂ɁAt[Xe[W̐ݒĐi߂܂ (ׂ錳ł)
+    SIM_KERNEL_STAGE,           // Ƃ̂Xe[W
+    SIM_KERNEL_FLAT,            // Ƃ̂ȂXe[W (̔Ȃ܂)
+    SIM_KERNEL_FLAT_STAGE1,     // gݍ݂̃Xe[W1ƓAƂȂ SIM_STAGE1_SPEED ̃Xe[W
+    SIM_KERNEL_ENDLESS,         // GhX[h (ԂƂɐݒ肪ς̂ŁA̔͏Ȃ܂)
+    SIM_KERNEL_COUNT
+};
+
+// ̗pr (prƂɕʂ̕тĝŁAЁ񐔂ςĂAЕ͕ς܂)
+enum RngStream{
+    RNG_TERRAIN,        // nʂ̕ƗƂ
+    RNG_OBSTACLES,      // ǂ̍ƈʒu
+    RNG_EFFECTS,        // ڂ̉op (Q[̐isɉeȂ̂Ɏg܂)
+    RNG_STREAM_COUNT
+};
+
+//-----------------------------------------------------------------------------
+//  Q[̕@ՓxɊւݒl (萔)
+//-----------------------------------------------------------------------------
+const Scalar GRAVITY = SCALAR_CONST(0.4f);
+const Scalar JUMP_POWER = SCALAR_CONST(-10.0f);
+const int   PLAYER_SIZE = 20;
+const int   GROUND_Y = 400;
+const int   OBSTACLE_WIDTH = 30;
+const int   JUMP_BUFFER_TICKS = 6;  // s: n̏O (̃t[ȓ) ɉWvAnuԂɒт܂
+const int   COYOTE_TICKS = 5;       // R[e^C: nʂ瑫āÃt[̊Ԃ͂܂Wvł܂
+
+// gݍ݂̃Xe[W1̑ (sim.cpp ̕\ƓlBSIM_KERNEL_FLAT_STAGE1 ́A̒l萔ƂĎg܂)
+#define SIM_STAGE1_SPEED    -4.0f
+
+//-----------------------------------------------------------------------------
+//  ݌v} (\)
+//-----------------------------------------------------------------------------
+// Xe[W1̐ݒ (Xe[WpbÑt@CɂǍ`̂܂ܕł܂B
+// t@Ĉ܂܃Ɋ蓖ĂĎĝŁAo[ׂ͂4oCgɂ낦Ă܂B
+// ̓t@Č`ɍ킹 float ̂܂܂ŁAgƂ Scalar_FromFloat ŕϊ܂)
+struct StageData
+{
+    float scrollSpeed;           // XN[̑ (}CiXō֐i݂܂)
+    int   clearScore;            // ̃XRAŃXe[WNA
+    int   pitChance;             // nʂƂ 1/pitChance ̊mŗƂɂ (0 Ȃ痎ƂȂ)
+    int   pitWidthMin;           // Ƃ̕ = pitWidthMin +  % pitWidthRange
+    int   pitWidthRange;
+    int   groundWidthMin;        // nʂ̕ = groundWidthMin +  % groundWidthRange
+    int   groundWidthRange;
+    int   obstacleChance;        // nʂƂ 1/obstacleChance ̊mŕǂu (0 ȂǂȂ)
+    int   obstacleHeightMin;     // ǂ̍ = obstacleHeightMin +  % obstacleHeightRange
+    int   obstacleHeightRange;
+    int   obstacleLimit;         // ɒuǂ̐ (1`MAX_OBSTACLES)
+
+    // Xe[Wn܂Ƃ̕ו (GhX[hł͎g܂)
+    int   startGroundMin;        // ŏɕׂnʂ̕ = startGroundMin +  % startGroundRange (Ƃ͂Ȃ)
+    int   startGroundRange;
+    int   firstObstacleX;        // ŏ̕ǂ̈ʒu (ʂ̉E[̋)
+    int   obstacleGapMin;        // ŏɕׂǂ̊Ԋu = obstacleGapMin +  % obstacleGapRange
+    int   obstacleGapRange;
+};
+
+// GhX[h̃R[X1 (`N) łB
+// ƋԂ̔ԍŒg܂̂ŁAǂ̃XbhōĂɂȂ܂ (endless.h)
+struct ChunkSegment
+{
+    int   width;
+    int   isPit;                // 0 ȊOȂ痎Ƃ
+    int   obstacleHeight;       // ǂ̍ (0 ȂǂȂ)
+    int   obstacleOffset;       // ǂ̈ʒu (nʂ̍[)
+};
+
+struct Chunk
+{
+    unsigned long seed;         // R[X̎
+    unsigned long index;        // Ԗڂ̋Ԃ (0 )
+    StageData     stage;        // ̋Ԃ̓ (ȆEǂ̑)
+    ChunkSegment  segments[CHUNK_SEGMENTS];
+};
+
+// ԂpӂĂ炤֐ (ʂ̃XbhŐɍĂnƂȂǂɎg܂)B
+// K Endless_GenerateChunk(seed, index, chunk) Ɠg chunk ɏł
+typedef void (*ChunkProvider)(void* context, unsigned long seed, unsigned long index, Chunk& chunk);
+
+struct Player         { Scalar x, y; Scalar vy; bool onGround; PlayerState state; unsigned long stateChangeTime;
+                        MissCause missCause; HitSide missSide; Scalar missTime;    // missTime = Ԃ (̃t[̒ 0.0`1.0)
+                        int coyoteTicks; };                                        // coyoteTicks = Ɖt[A󒆂łWvł邩
+struct GroundSegment  { Scalar x; int width; bool isPit; };          // x ̓R[Ẍʒu
+
+// 1t[̓
+//   jump  escape ́ũt[̊ԂɈxłĂvA
+//   jumpPressed ́ũt[̊ԂɐVꂽvłB
+//   t[̓rŉĂĂAjump  jumpPressed ͗ true ɂȂ܂ (input.h)
+struct InputFrame
+{
+    bool jump;          // Xy[XL[
+    bool jumpPressed;   // Xy[XL[u (ςȂ̊Ԃ false)
+    bool escape;        // ESCL[
+};
+
+// Q[ÊׂĂ̏ԂЂƂ܂Ƃ߂ɂ
+struct World
+{
+    GameState       gameState;                          // ݂̃Q[
+    int             jumpBufferTicks;                    // s͂̃WvAƉt[oĂ
+    bool            quitRequested;                      // ESCL[ŏI߂ꂽ
+    int             kernel;                             // vC̃Xe[Wi߂֐ (SIM_KERNEL_`)
+    bool            genericKernel;                      // true ȂXe[Wɍ킹֐I΂A SIM_KERNEL_GENERIC Ői߂܂
+
+    Player          player;
+    const StageData* stages;                            // Xe[W\ (gݍ݂̕\AXe[WpbN̒gw܂)
+    int             stageCount;                         // Xe[W̐
+
+    // --- R[X (nʂƕ) ---
+    //   nʂǂA珇ɕׂOobt@ (ւ̂悤ɂȂz) łB
+    //   ̈ʒu̓R[X̍WŎAʏ̈ʒúux - scrollvŋ߂܂B
+    //   ̂߁AXN[Ă11 x Kv܂B
+    Scalar          scroll;                             // ʂ̍[AR[X̂ǂɂ邩
+    GroundSegment   ground[NUM_GROUND_SEGMENTS];
+    int             groundHead;                         // ԍ̒nʂ̔ԍ
+    Scalar          groundTailX;                        // ԉE̒nʂ̉E[ (̒nʂ͂ɒu܂)
+
+    // ǂ́AڂƂɕʁX̔zɕׂ܂ (SoA: \̂̔zł͂ȂAz̍\)B
+    //   蔻 x A_ x  scored 𑱂ēǂނ̂ŁA
+    //   gȂڂŃLbV𖳑ʂɂ܂Bi Ԗڂ̕ǂ Sim_ObstacleSlot ŋ߂܂
+    Scalar          obstacleX[MAX_OBSTACLES];           // R[Ẍʒu
+    int             obstacleHeight[MAX_OBSTACLES];
+    bool            obstacleScored[MAX_OBSTACLES];      // _
+    int             obstacleHead;                       // ԍ̕ǂ̔ԍ
+    int             obstacleCount;                      // R[Xɂǂ̐
+
+    // u+10ṽXRA\ SoA ŁA0`popupCount-1 ɌԂȂl߂ĕׂ܂
+    //   (Ƃ͈Ԍ̕󂢂Ɉڂ̂ŁAugĂ邩v̈͂܂)
+    Scalar          popupX[MAX_POPUPS];
+    Scalar          popupY[MAX_POPUPS];
+    unsigned long   popupStartTime[MAX_POPUPS];
+    int             popupCount;
+
+    // --- GhX[h ---
+    //   nʂƕǂA (Chunk) 獶ɏԂɕׂ܂BԂׂ͍Ă1̂ŁA
+    //   ǂꂾVłAg̗ʂ͕ς܂
+    bool            endless;                            // true ȂXe[Wł͂ȂAGhX[hŗVт܂
+    unsigned long   endlessSeed;                        // ̃Q[̃R[X̎
+    Chunk           chunk;                              // ׂĂ
+    int             chunkPos;                           // chunk ̒ŁAɕׂnʂ̔ԍ
+    ChunkProvider   chunkProvider;                      // ԂpӂĂ炤֐ (NULL ȂȀō܂)
+    void*           chunkContext;
+
+    unsigned long   time;                               // Q[̎v (~b)
+    unsigned long   rngSeed;                            // ̎ (vC̍ČɎg܂)
+    unsigned long   gameCount;                          // ܂łɎn߂Q[̐ (Xe[W̎ɍ܂)
+    Rng             rng[RNG_STREAM_COUNT];              // prƂ̗ (Xe[Wn܂邽тɎ킩蒼܂)
+    unsigned long   score;
+    unsigned long   currentStageScore;
+    unsigned long   highScore;
+    int             lives;
+    int             currentStage;
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Sim_Init(World& world, unsigned long seed, const StageData* stages, int stageCount);
+bool Sim_IsValidStage(const StageData& stage);
+void Sim_Step(World& world, const InputFrame& input);
+void Sim_ResetGame(World& world);
+void Sim_StartNextStage(World& world);
+void Sim_Interpolate(const World& prev, const World& cur, float alpha, World& out);
+unsigned long Sim_StageSeed(const World& world, int stage);
+void Sim_SetEndless(World& world, bool endless);
+void Sim_SetChunkProvider(World& world, ChunkProvider provider, void* context);
+unsigned long Sim_EndlessSeed(const World& world, unsigned long game);
+unsigned long Sim_Hash(const World& world);
+unsigned long Sim_StageHash(const StageData* stages, int stageCount);
+void Sim_SetGenericKernel(World& world, bool generic);
+const char* Sim_KernelName(int kernel);
+
+//-----------------------------------------------------------------------------
+//  R[X̒g珇Ɏo߂֗̕֐
+//   (n = 0 ԍłBnʂ 0`NUM_GROUND_SEGMENTS-1Aǂ 0`obstacleCount-1)
+//-----------------------------------------------------------------------------
+inline const GroundSegment& Sim_GroundAt(const World& world, int n)     { return world.ground[(world.groundHead + n) % NUM_GROUND_SEGMENTS]; }
+inline int                  Sim_ObstacleSlot(const World& world, int n) { return (world.obstacleHead + n) % MAX_OBSTACLES; }
+inline Scalar               Sim_ScreenX(const World& world, Scalar x)   { return x - world.scroll; }
+
+// ̃Xe[W̐ݒ (GhX[hł́AׂĂԂ̓)
+inline const StageData&     Sim_Stage(const World& world)               { return world.endless ? world.chunk.stage : world.stages[world.currentStage]; }
+
+#endif // SIM_H
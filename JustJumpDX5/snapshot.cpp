@@ -0,0 +1,96 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Q[̏Ԃ̎󂯓n (gvobt@)
+//
+//=============================================================================
+#include <string.h>
+#include "snapshot.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static long Snapshot_Exchange(volatile long* p, long n);
+static long Snapshot_Load(volatile long* p);
+
+//=============================================================================
+//  Snapshot_Init֐ - uɂ܂ (Xbh𓮂OɌĂł)
+//=============================================================================
+void Snapshot_Init(SnapshotBuffer& buffer)
+{
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.writeIndex = 0;
+    buffer.middle = 1;
+    buffer.readIndex = 2;
+}
+
+//=============================================================================
+//  Snapshot_BeginWrite֐ - ̎ʂޒuԂ܂ (Xbh)
+//   (OɏgcĂƂ͌܂BSĂ)
+//=============================================================================
+SimSnapshot& Snapshot_BeginWrite(SnapshotBuffer& buffer)
+{
+    return buffer.slots[buffer.writeIndex];
+}
+
+//=============================================================================
+//  Snapshot_Publish֐ - Iʂ^񒆂ɒuAǂޑ猩悤ɂ܂ (Xbh)
+//   (ǂޑ܂󂯎ĂȂÂʂ́Aŏ̒uɂȂď㏑܂)
+//=============================================================================
+void Snapshot_Publish(SnapshotBuffer& buffer)
+{
+    long old = Snapshot_Exchange(&buffer.middle, buffer.writeIndex | SNAPSHOT_FRESH);
+    buffer.writeIndex = (int)(old & 3);
+    buffer.published++;
+}
+
+//=============================================================================
+//  Snapshot_Latest֐ - ԐVʂԂ܂ (ǂރXbh)
+//   (VʂȂ΁AOƓʂԂ܂B܂1ĂȂ NULL)
+//   Ԃʂ́A Snapshot_Latest ĂԂ܂ŏ܂
+//=============================================================================
+const SimSnapshot* Snapshot_Latest(SnapshotBuffer& buffer)
+{
+    if (Snapshot_HasFresh(buffer)){
+        long old = Snapshot_Exchange(&buffer.middle, buffer.readIndex);
+        buffer.readIndex = (int)(old & 3);
+        buffer.hasRead = true;
+        buffer.taken++;
+    }
+    return buffer.hasRead ? &buffer.slots[buffer.readIndex] : NULL;
+}
+
+//=============================================================================
+//  Snapshot_HasFresh֐ - ܂󂯎ĂȂVʂ邩 (ǂރXbh)
+//=============================================================================
+bool Snapshot_HasFresh(SnapshotBuffer& buffer)
+{
+    return (Snapshot_Load(&buffer.middle) & SNAPSHOT_FRESH) != 0;
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// lւāAO̒lԂ܂Bւ̑Oɏʂ̒ǵA
+// ւ̔ԍǂ񂾂ق̃XbhAKIԂŌ܂
+static long Snapshot_Exchange(volatile long* p, long n)
+{
+#ifdef _WIN32
+    return InterlockedExchange((LONG volatile*)p, n);
+#else
+    return __atomic_exchange_n(p, n, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static long Snapshot_Load(volatile long* p)
+{
+#ifdef _WIN32
+    return InterlockedExchangeAdd((LONG volatile*)p, 0);
+#else
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+}
@@ -0,0 +1,68 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Q[̏Ԃ̎󂯓n (gvobt@)
+//
+//  Q[i߂XbhƁAʂ`Xbh̊ԂŁAQ[̏Ԃ̎ʂ (XibvVbg) 
+//  󂯓n܂Bu3Aꂼꎟ̖ڂ܂B
+//    ̒u   ... Q[i߂XbhȀԂ݂܂
+//    ǂޑ̒u   ... ʂ`XbhA`ĂԂƓǂ݂܂
+//    ^񒆂̒u   ... IԐVʂuĂ܂
+//  IuvƁu^񒆁vA`n߂ƂɐVʂ΁uǂޑvƁu^񒆁vA
+//  1̓ւ (InterlockedExchange) Ō܂BbN҂Ȃ̂ŁA
+//  `̂x (Flip ̐҂Ȃ) AQ[i߂Xbh͎~܂܂B
+//  `́Ar̎ʂ΂āAłԐVʂ`܂B
+//
+//  ĝ́u1Eǂޑ1ṽXbhłB
+//
+//  g:
+//    Snapshot_Init(buffer);
+//    SimSnapshot& s = Snapshot_BeginWrite(buffer);    // Q[i߂Xbh
+//    s.prev = ...; s.cur = ...;
+//    Snapshot_Publish(buffer);
+//
+//    const SimSnapshot* s = Snapshot_Latest(buffer);   // ʂ`Xbh (܂Ȃ NULL)
+//
+//=============================================================================
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "sim.h"
+#include "ghost.h"
+
+// Ԃ̎ʂ1 (`̂ɕKvȕׂ͂ World ɓĂ܂BXe[W\͎wĂ邾ł)
+struct SimSnapshot
+{
+    World         prev;                 // 1t[Ȍ (ԂɎg܂)
+    World         cur;                  // ̏
+    unsigned long tick;                 // t[ڂ̏Ԃ (NĂ琔܂)
+    unsigned long time;                 // cur ̃t[I (~bBԂ̊߂̂Ɏg܂)
+    double        updateMicroseconds;   // NĂ Sim_Step ɂԂ̍v (vt@Cp)
+    unsigned long hash;                 // mߗpɓꂽ Sim_Hash(cur) (gȂ 0)
+    GhostPose     ghostPrev;            // 1t[ÕS[Xg̎p
+    GhostPose     ghost;                // ̃S[Xg̎p
+};
+
+#define SNAPSHOT_FRESH      4           // ^񒆂̒uɁA܂ǂłȂʂ
+
+struct SnapshotBuffer
+{
+    SimSnapshot   slots[3];
+    volatile long middle;               // ^񒆂̒u̔ԍ (| SNAPSHOT_FRESH)Bւł܂
+    int           writeIndex;           // ̒u̔ԍ (Xbhg܂)
+    int           readIndex;            // ǂޑ̒u̔ԍ (ǂރXbhg܂)
+    bool          hasRead;              // xłʂ󂯎 (ǂރXbhg܂)
+
+    unsigned long published;            // I (Xbh܂)
+    unsigned long taken;                // Vʂ󂯎 (ǂރXbh܂)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void               Snapshot_Init(SnapshotBuffer& buffer);
+SimSnapshot&       Snapshot_BeginWrite(SnapshotBuffer& buffer);
+void               Snapshot_Publish(SnapshotBuffer& buffer);
+const SimSnapshot* Snapshot_Latest(SnapshotBuffer& buffer);
+bool               Snapshot_HasFresh(SnapshotBuffer& buffer);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,40 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Xe[WpbNϊc[ (Linuxp)
+//
+//  eLXg`̃Xe[WݒAQ[̂܂܃Ɋ蓖ĂĎg
+//  oCi`ɕϊ܂B
+//
+//  g:
+//    ./jjstagec stages.txt stages.jjs
+//
+//=============================================================================
+#include <stdio.h>
+#include "stagepack.h"
+
+int main(int argc, char* argv[])
+{
+    int errorLine;
+
+    if (argc != 3){
+        fprintf(stderr, "usage: %s stages.txt stages.jjs\n", argv[0]);
+        return 1;
+    }
+
+    if (!StagePack_Compile(argv[1], argv[2], &errorLine)){
+        if (errorLine > 0) fprintf(stderr, "%s:%d: invalid stage definition\n", argv[1], errorLine);
+        else               fprintf(stderr, "cannot convert %s to %s\n", argv[1], argv[2]);
+        return 1;
+    }
+
+    // ϊt@CJāAQ[ǂ߂邱Ƃm߂܂
+    StagePack pack;
+    StagePack_Init(pack);
+    if (!StagePack_Open(pack, argv[2])){
+        fprintf(stderr, "cannot open %s\n", argv[2]);
+        return 1;
+    }
+    printf("%s: %d stages, %lu bytes\n", argv[2], pack.stageCount, pack.viewSize);
+    StagePack_Close(pack);
+    return 0;
+}
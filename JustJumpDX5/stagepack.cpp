@@ -0,0 +1,335 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Xe[WpbN (Xe[Wݒ̃t@C)
+//
+//  eLXg` (stages.txt) ̏:
+//    # s̏I܂ł̓RgłB
+//    1s1Xe[WA"stage" ɑāuO=lvׂ܂BȂڂ
+//     s_StageDefaults ̒lɂȂ܂B
+//
+//      stage speed=-4.5 clear=150 pit=5
+//
+//    O StageData ̃o[̑Ή s_StageKeys ĂB
+//
+//=============================================================================
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "stagepack.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//  eLXg`̍ږ
+//-----------------------------------------------------------------------------
+// ڂȂƂ̒l (̃Q[2`5ʂƓݒł)
+static const StageData s_StageDefaults = { -4.0f, 150, 0, 65, 35, 100, 200, 3, 30, 50, 3, 200, 100, 100, 250, 150 };
+
+struct StageKey
+{
+    const char* name;
+    size_t      offset;     // StageData ̒̈ʒu
+    bool        isFloat;
+};
+
+static const StageKey s_StageKeys[] =
+{
+    { "speed",         offsetof(StageData, scrollSpeed),         true  },
+    { "clear",         offsetof(StageData, clearScore),          false },
+    { "pit",           offsetof(StageData, pitChance),           false },
+    { "pit_width",     offsetof(StageData, pitWidthMin),         false },
+    { "pit_range",     offsetof(StageData, pitWidthRange),       false },
+    { "ground_width",  offsetof(StageData, groundWidthMin),      false },
+    { "ground_range",  offsetof(StageData, groundWidthRange),    false },
+    { "wall",          offsetof(StageData, obstacleChance),      false },
+    { "wall_height",   offsetof(StageData, obstacleHeightMin),   false },
+    { "wall_range",    offsetof(StageData, obstacleHeightRange), false },
+    { "walls",         offsetof(StageData, obstacleLimit),       false },
+    { "start_width",   offsetof(StageData, startGroundMin),      false },
+    { "start_range",   offsetof(StageData, startGroundRange),    false },
+    { "first_wall",    offsetof(StageData, firstObstacleX),      false },
+    { "wall_gap",      offsetof(StageData, obstacleGapMin),      false },
+    { "wall_gap_range", offsetof(StageData, obstacleGapRange),   false },
+};
+
+#define NUM_STAGE_KEYS  ((int)(sizeof(s_StageKeys) / sizeof(s_StageKeys[0])))
+#define STAGEPACK_HEADER_SIZE  16
+
+// StageData 4oCg̃o[łłĂ͂ł (Ⴆ΂ŃRpCG[ɂȂ܂)
+typedef char StageData_Size_Check[(sizeof(StageData) == 16 * 4) ? 1 : -1];
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static bool StagePack_ParseLine(char* line, StageData& stage, bool& hasStage);
+static bool StagePack_SetKey(StageData& stage, const char* name, const char* value);
+static void StagePack_WriteU32(unsigned char* p, unsigned long v);
+static unsigned long StagePack_ReadU32(const unsigned char* p);
+
+//=============================================================================
+//  StagePack_Init֐ - Xe[WpbN̏Ԃɂ܂
+//=============================================================================
+void StagePack_Init(StagePack& pack)
+{
+    memset(&pack, 0, sizeof(pack));
+}
+
+//=============================================================================
+//  StagePack_Compile֐ - eLXg`̃Xe[WݒAoCi`ɕϊ܂
+//   (̊ԈႢA͈͊O̒ls̔ԍ *errorLine ɓ false Ԃ܂B
+//    t@CJȂƂ *errorLine  0 ł)
+//=============================================================================
+bool StagePack_Compile(const char* textPath, const char* packPath, int* errorLine)
+{
+    char line[512];
+    int lineNo = 0;
+    int count = 0, capacity = 0;
+    StageData* stages = NULL;
+    bool ok = true;
+
+    if (errorLine != NULL) *errorLine = 0;
+
+    FILE* fp = fopen(textPath, "r");
+    if (fp == NULL){
+        return false;
+    }
+
+    while (ok && fgets(line, sizeof(line), fp) != NULL){
+        StageData stage;
+        bool hasStage;
+        lineNo++;
+
+        if (!StagePack_ParseLine(line, stage, hasStage) || (hasStage && !Sim_IsValidStage(stage)) || count >= STAGEPACK_MAX_STAGES){
+            if (errorLine != NULL) *errorLine = lineNo;
+            ok = false;
+            break;
+        }
+        if (!hasStage){
+            continue;
+        }
+
+        if (count >= capacity){
+            int newCapacity = capacity ? capacity * 2 : 16;
+            StageData* p = (StageData*)realloc(stages, newCapacity * sizeof(StageData));
+            if (p == NULL){
+                ok = false;
+                break;
+            }
+            stages = p;
+            capacity = newCapacity;
+        }
+        stages[count++] = stage;
+    }
+    fclose(fp);
+
+    // Xe[W1Ȃt@ĆAԈႢƂĈ܂
+    if (ok && count == 0){
+        if (errorLine != NULL) *errorLine = lineNo;
+        ok = false;
+    }
+
+    if (ok){
+        unsigned char header[STAGEPACK_HEADER_SIZE];
+        memcpy(header, "JJSP", 4);
+        StagePack_WriteU32(header + 4,  STAGEPACK_VERSION);
+        StagePack_WriteU32(header + 8,  (unsigned long)count);
+        StagePack_WriteU32(header + 12, (unsigned long)sizeof(StageData));
+
+        fp = fopen(packPath, "wb");
+        ok = fp != NULL;
+        if (ok){
+            ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header)
+              && fwrite(stages, sizeof(StageData), count, fp) == (size_t)count;
+            ok = (fclose(fp) == 0) && ok;
+            if (!ok) remove(packPath);
+        }
+    }
+
+    free(stages);
+    return ok;
+}
+
+//=============================================================================
+//  StagePack_Open֐ - oCi`̃Xe[WpbNAɊ蓖ĂĊJ܂
+//   (g̓Rs[܂Bpack.stages ̓t@C̒𒼐ڎw܂)
+//=============================================================================
+bool StagePack_Open(StagePack& pack, const char* packPath)
+{
+    StagePack_Close(pack);
+
+    // 1. t@CɊ蓖Ă
+#ifdef _WIN32
+    HANDLE hFile = CreateFile(packPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE){
+        return false;
+    }
+    DWORD size = GetFileSize(hFile, NULL);
+    HANDLE hMapping = NULL;
+    if (size != 0xFFFFFFFF && size >= STAGEPACK_HEADER_SIZE){
+        hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (hMapping != NULL){
+        pack.view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(hMapping);      // 蓖ẮAg܂
+    }
+    CloseHandle(hFile);
+#else
+    int fd = open(packPath, O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat st;
+    unsigned long size = 0;
+    if (fstat(fd, &st) == 0 && st.st_size >= STAGEPACK_HEADER_SIZE){
+        size = (unsigned long)st.st_size;
+        void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) pack.view = p;
+    }
+    close(fd);                      // 蓖ẮAg܂
+#endif
+    if (pack.view == NULL){
+        return false;
+    }
+    pack.viewSize = (unsigned long)size;
+
+    // 2. wb_[m߂
+    const unsigned char* header = (const unsigned char*)pack.view;
+    unsigned long count = StagePack_ReadU32(header + 8);
+    if (memcmp(header, "JJSP", 4) != 0
+        || StagePack_ReadU32(header + 4) != STAGEPACK_VERSION
+        || StagePack_ReadU32(header + 12) != sizeof(StageData)
+        || count == 0 || count > STAGEPACK_MAX_STAGES
+        || pack.viewSize != STAGEPACK_HEADER_SIZE + count * sizeof(StageData)){
+        StagePack_Close(pack);
+        return false;
+    }
+
+    // 3. gm߂ (1Xe[W64oCgȂ̂ŁASXe[WĂI܂)
+    const StageData* stages = (const StageData*)(header + STAGEPACK_HEADER_SIZE);
+    unsigned long i;
+    for (i = 0; i < count; i++){
+        if (!Sim_IsValidStage(stages[i])){
+            StagePack_Close(pack);
+            return false;
+        }
+    }
+
+    pack.stages = stages;
+    pack.stageCount = (int)count;
+    return true;
+}
+
+//=============================================================================
+//  StagePack_Load֐ - Xe[WpbNJ܂
+//   eLXg`̂قV (܂̓oCi`܂Ȃ)Aɕϊ܂B
+//   ǂgȂ false Ԃ܂ (̂Ƃ͑gݍ݂̃Xe[WŗVׂ܂)
+//=============================================================================
+bool StagePack_Load(StagePack& pack, const char* packPath, const char* textPath)
+{
+    struct stat textStat, packStat;
+
+    if (textPath != NULL && stat(textPath, &textStat) == 0){
+        if (stat(packPath, &packStat) != 0 || textStat.st_mtime > packStat.st_mtime){
+            StagePack_Compile(textPath, packPath, NULL);
+        }
+    }
+    if (StagePack_Open(pack, packPath)){
+        return true;
+    }
+
+    // Âł̌`ŊJȂƂ́AeLXg`ϊāAxJ܂
+    if (textPath != NULL && StagePack_Compile(textPath, packPath, NULL)){
+        return StagePack_Open(pack, packPath);
+    }
+    return false;
+}
+
+//=============================================================================
+//  StagePack_Close֐ - ̊蓖Ă܂
+//   (̌́Apack.stages n World  Sim_Step ɎgȂł)
+//=============================================================================
+void StagePack_Close(StagePack& pack)
+{
+    if (pack.view != NULL){
+#ifdef _WIN32
+        UnmapViewOfFile(pack.view);
+#else
+        munmap((void*)pack.view, pack.viewSize);
+#endif
+    }
+    StagePack_Init(pack);
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// 1sǂݎ܂B"stage" ̍sȂ hasStage  true ɂ stage ɐݒ܂
+// (sRg̍s hasStage  false ̂܂ true Ԃ܂)
+static bool StagePack_ParseLine(char* line, StageData& stage, bool& hasStage)
+{
+    char* comment = strchr(line, '#');
+    if (comment != NULL) *comment = '\0';
+
+    hasStage = false;
+    char* token = strtok(line, " \t\r\n");
+    if (token == NULL){
+        return true;
+    }
+    if (strcmp(token, "stage") != 0){
+        return false;
+    }
+
+    stage = s_StageDefaults;
+    hasStage = true;
+    while ((token = strtok(NULL, " \t\r\n")) != NULL){
+        char* equal = strchr(token, '=');
+        if (equal == NULL){
+            return false;
+        }
+        *equal = '\0';
+        if (!StagePack_SetKey(stage, token, equal + 1)){
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool StagePack_SetKey(StageData& stage, const char* name, const char* value)
+{
+    int i;
+    char* end;
+
+    for (i = 0; i < NUM_STAGE_KEYS; i++){
+        if (strcmp(name, s_StageKeys[i].name) != 0){
+            continue;
+        }
+        char* field = (char*)&stage + s_StageKeys[i].offset;
+        if (s_StageKeys[i].isFloat){
+            *(float*)field = (float)strtod(value, &end);
+        }else{
+            *(int*)field = (int)strtol(value, &end, 10);
+        }
+        return end != value && *end == '\0';
+    }
+    return false;
+}
+
+static void StagePack_WriteU32(unsigned char* p, unsigned long v)
+{
+    p[0] = (unsigned char)(v); p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned long StagePack_ReadU32(const unsigned char* p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
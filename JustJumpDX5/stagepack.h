@@ -0,0 +1,56 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Xe[WpbN (Xe[Wݒ̃t@C)
+//
+//  Xe[W̐ݒ́AeLXgt@C (stages.txt) 1s1Xe[Wŏ܂B
+//  xoCi` (stages.jjs) ɕϊĂAQ[̋Nɂ
+//  t@Ĉ܂܃Ɋ蓖Ă (}bv) g܂B
+//  t@Cǂݍŉ߂鏈Ȃ̂ŁAXe[WSɑĂ
+//  N͕̑ς܂B
+//
+//  oCi` (wb_[̐l̓gGfBA):
+//    "JJSP"            4oCg  ڈ
+//    o[W        4oCg  STAGEPACK_VERSION
+//    Xe[W        4oCg
+//    1Xe[W̑傫 4oCg  sizeof(StageData)
+//    StageData ~ Xe[W   (sim.h ̍\̂Â܂܃̌`ŏ)
+//
+//  StageData ̒ǵAϊvO intEfloat ̌` (oCg̕яȂ) ̂܂܂łB
+//  ̂܂܊蓖ĂĎg߂Ȃ̂ŁAstages.jjs ͓`̃rh̊Ԃłg񂹂܂B
+//  Ⴄ֎ĂƂ́Astages.txt ĂĕϊĂB
+//
+//  g:
+//    StagePack pack;
+//    StagePack_Init(pack);
+//    if (StagePack_Load(pack, "stages.jjs", "stages.txt")) { Sim_Init(world, seed, pack.stages, pack.stageCount); }
+//    ...
+//    StagePack_Close(pack);
+//
+//=============================================================================
+#ifndef STAGEPACK_H
+#define STAGEPACK_H
+
+#include "sim.h"
+
+#define STAGEPACK_VERSION     2         // 2: Xe[Wn܂Ƃ̕ו (start_width Ȃ) 𑫂܂
+#define STAGEPACK_MAX_STAGES  10000     // ꂽt@Cǂ܂Ȃ߂̏
+
+struct StagePack
+{
+    const StageData* stages;       // Xe[W\ (Ɋ蓖Ăt@C̒w܂)
+    int              stageCount;   // Xe[W̐
+
+    const void*      view;         // Ɋ蓖Ăt@C̐擪
+    unsigned long    viewSize;     // ̑傫 (oCg)
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void StagePack_Init(StagePack& pack);
+bool StagePack_Compile(const char* textPath, const char* packPath, int* errorLine);
+bool StagePack_Open(StagePack& pack, const char* packPath);
+bool StagePack_Load(StagePack& pack, const char* packPath, const char* textPath);
+void StagePack_Close(StagePack& pack);
+
+#endif // STAGEPACK_H
@@ -0,0 +1,432 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ̕` (OtAgX)
+//
+//  AgXt@C (.jja) ̌` (lׂ͂ăgGfBA):
+//    wb_[ 16oCg: "JJGA"A (TEXT_ATLAS_VERSION)A̐ASp̕ (ꂼ4oCg)
+//    1Ƃ 36oCg: R[h (2)A (1)A\ (1)A16s̃rbg (2 x 16)
+//
+//=============================================================================
+#include <stdio.h>
+#include <string.h>
+#include "text.h"
+#include "render.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+#define TEXT_ATLAS_HEADER_SIZE  16
+#define TEXT_GLYPH_FILE_SIZE    (4 + TEXT_CELL_H * 2)
+
+//-----------------------------------------------------------------------------
+//  gݍ݂̉ptHg (0x20`0x7EA15Bẻʃrbg̍s)
+//   c2{ɍL 10x16 hbg̕ɂ܂
+//-----------------------------------------------------------------------------
+#define BUILTIN_FIRST       0x20
+#define BUILTIN_COUNT       95
+#define BUILTIN_SCALE       2
+#define BUILTIN_ADVANCE     12
+
+static const unsigned char s_BuiltinFont[BUILTIN_COUNT][5] =
+{
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14}, // ' ' ! " #
+    {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x56,0x20,0x50}, {0x00,0x05,0x03,0x00,0x00}, // $ % & '
+    {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x2A,0x1C,0x7F,0x1C,0x2A}, {0x08,0x08,0x3E,0x08,0x08}, // ( ) * +
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02}, // , - . /
+    {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, // 0 1 2 3
+    {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03}, // 4 5 6 7
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00}, // 8 9 : ;
+    {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, // < = > ?
+    {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22}, // @ A B C
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A}, // D E F G
+    {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, // H I J K
+    {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E}, // L M N O
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31}, // P Q R S
+    {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F}, // T U V W
+    {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00}, // X Y Z [
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40}, // \ ] ^ _
+    {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20}, // ` a b c
+    {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E}, // d e f g
+    {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00}, // h i j k
+    {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38}, // l m n o
+    {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20}, // p q r s
+    {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C}, // t u v w
+    {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00}, // x y z {
+    {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08},                              // | } ~
+};
+
+//-----------------------------------------------------------------------------
+//  ̃t@C̒Ŏg֐ (vg^Cv錾)
+//-----------------------------------------------------------------------------
+static unsigned short Text_NextCode(const char*& p);
+static void Text_DrawBox(const Framebuffer& fb, int x, int y, int w, unsigned int color);
+static void Text_WriteU16(unsigned char* p, unsigned int v);
+static unsigned int Text_ReadU16(const unsigned char* p);
+
+//=============================================================================
+//  Text_Init֐ - AgXɂ܂
+//=============================================================================
+void Text_Init(GlyphAtlas& atlas)
+{
+    int i;
+    atlas.glyphCount = 0;
+    atlas.missingAdvance = TEXT_CELL_W;
+    for (i = 0; i < 128; i++){
+        atlas.ascii[i] = -1;
+    }
+}
+
+//=============================================================================
+//  Text_InitBuiltin֐ - gݍ݂̉ptHgŃAgX܂
+//=============================================================================
+void Text_InitBuiltin(GlyphAtlas& atlas)
+{
+    int i, col, row;
+
+    Text_Init(atlas);
+    for (i = 0; i < BUILTIN_COUNT; i++){
+        Glyph g;
+        memset(&g, 0, sizeof(g));
+        g.code = (unsigned short)(BUILTIN_FIRST + i);
+        g.advance = BUILTIN_ADVANCE;
+
+        for (col = 0; col < 5; col++){
+            unsigned short bits = (unsigned short)(0xC000 >> (col * BUILTIN_SCALE));
+            for (row = 0; row < 8; row++){
+                if (s_BuiltinFont[i][col] & (1 << row)){
+                    g.rows[row * BUILTIN_SCALE]     |= bits;
+                    g.rows[row * BUILTIN_SCALE + 1] |= bits;
+                }
+            }
+        }
+        Text_AddGlyph(atlas, g);
+    }
+}
+
+//=============================================================================
+//  Text_AddGlyph֐ - AgX1ǉ܂ (Βu܂)
+//=============================================================================
+bool Text_AddGlyph(GlyphAtlas& atlas, const Glyph& glyph)
+{
+    int i, pos;
+
+    // code ̏ɂȂʒuT܂
+    for (pos = 0; pos < atlas.glyphCount && atlas.glyphs[pos].code < glyph.code; pos++);
+
+    if (pos < atlas.glyphCount && atlas.glyphs[pos].code == glyph.code){
+        atlas.glyphs[pos] = glyph;
+        return true;
+    }
+    if (atlas.glyphCount >= TEXT_MAX_GLYPHS){
+        return false;
+    }
+
+    for (i = atlas.glyphCount; i > pos; i--){
+        atlas.glyphs[i] = atlas.glyphs[i - 1];
+    }
+    atlas.glyphs[pos] = glyph;
+    atlas.glyphCount++;
+
+    // p̑\蒼܂ (͔̕ԍ1邽)
+    for (i = 0; i < 128; i++){
+        atlas.ascii[i] = -1;
+    }
+    for (i = 0; i < atlas.glyphCount && atlas.glyphs[i].code < 128; i++){
+        atlas.ascii[atlas.glyphs[i].code] = (short)i;
+    }
+    return true;
+}
+
+//=============================================================================
+//  Text_FindGlyph֐ - R[h當̌`T܂ (Ȃ NULL)
+//=============================================================================
+const Glyph* Text_FindGlyph(const GlyphAtlas& atlas, unsigned short code)
+{
+    if (code < 128){
+        return atlas.ascii[code] >= 0 ? &atlas.glyphs[atlas.ascii[code]] : NULL;
+    }
+
+    // Sp͓񕪒T܂
+    int lo = 0, hi = atlas.glyphCount - 1;
+    while (lo <= hi){
+        int mid = (lo + hi) / 2;
+        if (atlas.glyphs[mid].code == code) return &atlas.glyphs[mid];
+        if (atlas.glyphs[mid].code < code) lo = mid + 1; else hi = mid - 1;
+    }
+    return NULL;
+}
+
+//=============================================================================
+//  Text_HasAll֐ - text ׂ̂Ă̕ (󔒂Ɛ䕶) AgXɂ邩ׂ܂
+//=============================================================================
+bool Text_HasAll(const GlyphAtlas& atlas, const char* text)
+{
+    const char* p = text;
+    while (*p != '\0'){
+        unsigned short code = Text_NextCode(p);
+        if (code > ' ' && Text_FindGlyph(atlas, code) == NULL){
+            return false;
+        }
+    }
+    return true;
+}
+
+//=============================================================================
+//  Text_SaveAtlas֐ / Text_LoadAtlas֐ - AgXt@CɕۑEǂݍ݂܂
+//=============================================================================
+bool Text_SaveAtlas(const GlyphAtlas& atlas, const char* path)
+{
+    int i, r;
+    unsigned char header[TEXT_ATLAS_HEADER_SIZE];
+    unsigned char rec[TEXT_GLYPH_FILE_SIZE];
+
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL){
+        return false;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "JJGA", 4);
+    Text_WriteU16(header + 4, TEXT_ATLAS_VERSION);
+    Text_WriteU16(header + 8, (unsigned int)atlas.glyphCount);
+    Text_WriteU16(header + 12, (unsigned int)atlas.missingAdvance);
+    bool ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+
+    for (i = 0; ok && i < atlas.glyphCount; i++){
+        const Glyph& g = atlas.glyphs[i];
+        Text_WriteU16(rec, g.code);
+        rec[2] = g.advance;
+        rec[3] = 0;
+        for (r = 0; r < TEXT_CELL_H; r++){
+            Text_WriteU16(rec + 4 + r * 2, g.rows[r]);
+        }
+        ok = fwrite(rec, 1, sizeof(rec), fp) == sizeof(rec);
+    }
+
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok) remove(path);
+    return ok;
+}
+
+bool Text_LoadAtlas(GlyphAtlas& atlas, const char* path)
+{
+    int i, r;
+    unsigned char header[TEXT_ATLAS_HEADER_SIZE];
+    unsigned char rec[TEXT_GLYPH_FILE_SIZE];
+
+    Text_Init(atlas);
+
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL){
+        return false;
+    }
+
+    int count = 0;
+    bool ok = fread(header, 1, sizeof(header), fp) == sizeof(header)
+           && memcmp(header, "JJGA", 4) == 0
+           && Text_ReadU16(header + 4) == TEXT_ATLAS_VERSION;
+    if (ok){
+        count = (int)Text_ReadU16(header + 8);
+        atlas.missingAdvance = (int)Text_ReadU16(header + 12);
+        ok = count <= TEXT_MAX_GLYPHS && atlas.missingAdvance <= TEXT_CELL_W;
+    }
+
+    for (i = 0; ok && i < count; i++){
+        Glyph g;
+        ok = fread(rec, 1, sizeof(rec), fp) == sizeof(rec);
+        if (!ok) break;
+        g.code = (unsigned short)Text_ReadU16(rec);
+        g.advance = rec[2];
+        g.reserved = 0;
+        for (r = 0; r < TEXT_CELL_H; r++){
+            g.rows[r] = (unsigned short)Text_ReadU16(rec + 4 + r * 2);
+        }
+        ok = g.advance <= TEXT_CELL_W && Text_AddGlyph(atlas, g);
+    }
+    fclose(fp);
+
+    if (!ok){
+        Text_Init(atlas);
+    }
+    return ok;
+}
+
+#ifdef _WIN32
+//=============================================================================
+//  Text_BakeGDI֐ - GDI ̃VXetHgŁAcharset ̕ƔppĂt܂
+//   (N1񂾂Ăт܂BTextOut ŕ`ĂƂƓڂɂȂ܂)
+//=============================================================================
+bool Text_BakeGDI(GlyphAtlas& atlas, const char* charset)
+{
+    int c, x, y;
+
+    Text_Init(atlas);
+
+    // 1̔̊G`߂́A 32rbg̃rbg}bvpӂ܂
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize        = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth       = TEXT_CELL_W;
+    bmi.bmiHeader.biHeight      = -TEXT_CELL_H;     // }CiXɂƁA̍s珇ɕт܂
+    bmi.bmiHeader.biPlanes      = 1;
+    bmi.bmiHeader.biBitCount    = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = NULL;
+    HDC hdc = CreateCompatibleDC(NULL);
+    if (hdc == NULL){
+        return false;
+    }
+    HBITMAP hbm = CreateDIBSection(hdc, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+    if (hbm == NULL){
+        DeleteDC(hdc);
+        return false;
+    }
+    HGDIOBJ oldBitmap = SelectObject(hdc, hbm);
+    HGDIOBJ oldFont = SelectObject(hdc, GetStockObject(SYSTEM_FONT));
+    SetBkColor(hdc, RGB(0, 0, 0));
+    SetTextColor(hdc, RGB(255, 255, 255));
+
+    // Ăt镶̈ꗗ: p̉pELׂĂƁAcharset ̑Sp
+    char chars[2];
+    const char* p = charset;
+    bool ok = true;
+    for (c = ' '; ok; ){
+        int len;
+        if (c <= 0x7E){
+            chars[0] = (char)c++;
+            len = 1;
+        }else{
+            if (*p == '\0') break;
+            const char* start = p;
+            unsigned short code = Text_NextCode(p);
+            len = (int)(p - start);
+            if (code < 128) continue;       // p͂ĂtĂ܂
+            chars[0] = start[0];
+            chars[1] = start[1];
+        }
+
+        RECT rc = { 0, 0, TEXT_CELL_W, TEXT_CELL_H };
+        SIZE size;
+        ExtTextOut(hdc, 0, 0, ETO_OPAQUE, &rc, chars, len, NULL);
+        GetTextExtentPoint32(hdc, chars, len, &size);
+        GdiFlush();
+
+        Glyph g;
+        memset(&g, 0, sizeof(g));
+        g.code = (unsigned short)(len == 1 ? (unsigned char)chars[0] : ((unsigned char)chars[0] << 8) | (unsigned char)chars[1]);
+        g.advance = (unsigned char)(size.cx < TEXT_CELL_W ? size.cx : TEXT_CELL_W);
+        const unsigned int* pixels = (const unsigned int*)bits;
+        for (y = 0; y < TEXT_CELL_H; y++){
+            for (x = 0; x < TEXT_CELL_W; x++){
+                if ((pixels[y * TEXT_CELL_W + x] & 0xFF00) >= 0x8000){
+                    g.rows[y] |= (unsigned short)(0x8000 >> x);
+                }
+            }
+        }
+        ok = Text_AddGlyph(atlas, g);
+    }
+
+    SelectObject(hdc, oldFont);
+    SelectObject(hdc, oldBitmap);
+    DeleteObject(hbm);
+    DeleteDC(hdc);
+    return ok;
+}
+#endif
+
+//=============================================================================
+//  Text_Measure֐ - `Ƃ̕ (hbg) Ԃ܂
+//=============================================================================
+int Text_Measure(const GlyphAtlas& atlas, const char* text)
+{
+    int width = 0;
+    const char* p = text;
+    while (*p != '\0'){
+        unsigned short code = Text_NextCode(p);
+        const Glyph* g = Text_FindGlyph(atlas, code);
+        width += g != NULL ? g->advance : (code < 256 ? atlas.missingAdvance / 2 : atlas.missingAdvance);
+    }
+    return width;
+}
+
+//=============================================================================
+//  Text_Draw֐ - ʃɒڕ`܂ (x, y ͍Bwi͓ł)
+//   AgXɂȂ́Alpgőɕ`܂
+//=============================================================================
+void Text_Draw(const Framebuffer& fb, const GlyphAtlas& atlas, int x, int y, const char* text, unsigned int color)
+{
+    int r, col;
+    const char* p = text;
+
+    // ʂ̏㉺͂ݏos͕`܂
+    int firstRow = y < 0 ? -y : 0;
+    int lastRow  = y + TEXT_CELL_H > fb.height ? fb.height - y : TEXT_CELL_H;
+
+    while (*p != '\0' && x < fb.width){
+        unsigned short code = Text_NextCode(p);
+        const Glyph* g = Text_FindGlyph(atlas, code);
+
+        if (g == NULL){
+            int w = code < 256 ? atlas.missingAdvance / 2 : atlas.missingAdvance;
+            if (code > ' ') Text_DrawBox(fb, x, y, w, color);
+            x += w;
+            continue;
+        }
+
+        for (r = firstRow; r < lastRow; r++){
+            unsigned int bits = g->rows[r];
+            if (bits == 0) continue;
+
+            unsigned int* row = fb.pixels + (y + r) * fb.pitch;
+            for (col = 0; bits != 0; col++, bits = (bits << 1) & 0xFFFF){
+                if ((bits & 0x8000) && x + col >= 0 && x + col < fb.width){
+                    row[x + col] = color;
+                }
+            }
+        }
+        x += g->advance;
+    }
+}
+
+//=============================================================================
+//  [eBeB֐ (⏕Iȕ֗֐)
+//=============================================================================
+// p 1ǂݎĕR[hԂAp ̕ɐi߂܂
+static unsigned short Text_NextCode(const char*& p)
+{
+    unsigned char c = (unsigned char)*p++;
+    if (Text_IsLeadByte(c) && *p != '\0'){
+        return (unsigned short)((c << 8) | (unsigned char)*p++);
+    }
+    return c;
+}
+
+// AgXɂȂ̘̑g`܂
+static void Text_DrawBox(const Framebuffer& fb, int x, int y, int w, unsigned int color)
+{
+    int i;
+    int left = x + 1, right = x + w - 2, top = y + 1, bottom = y + TEXT_CELL_H - 2;
+    for (i = left; i <= right; i++){
+        if (i < 0 || i >= fb.width) continue;
+        if (top >= 0 && top < fb.height)       fb.pixels[top * fb.pitch + i] = color;
+        if (bottom >= 0 && bottom < fb.height) fb.pixels[bottom * fb.pitch + i] = color;
+    }
+    for (i = top; i <= bottom; i++){
+        if (i < 0 || i >= fb.height) continue;
+        if (left >= 0 && left < fb.width)   fb.pixels[i * fb.pitch + left] = color;
+        if (right >= 0 && right < fb.width) fb.pixels[i * fb.pitch + right] = color;
+    }
+}
+
+static void Text_WriteU16(unsigned char* p, unsigned int v)
+{
+    p[0] = (unsigned char)(v); p[1] = (unsigned char)(v >> 8);
+}
+
+static unsigned int Text_ReadU16(const unsigned char* p)
+{
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
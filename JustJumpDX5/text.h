@@ -0,0 +1,70 @@
+//=============================================================================
+//
+//  wWXgWv DX5x ̕` (OtAgX)
+//
+//  ʂɏǒ` (Ot) AN1񂾂̃rbg}bv
+//  ĂtĂ (AgX)At[͂ʃɒڎʂ܂B
+//  GDI  GetDC / TextOut 𖈃t[ĂԕKvȂȂAwbhXłł`܂B
+//
+//   Shift_JIS (CP932) łB1oCg͔pA2oCg͑SpƂĈ܂B
+//
+//  AgX̍3ʂ肠܂:
+//    Text_BakeGDI     ... (Windowsł) GDI ̃VXetHgŁAw肵Ăt܂
+//    Text_LoadAtlas   ... Text_SaveAtlas ŕۑAgXt@Cǂݍ݂܂
+//    Text_InitBuiltin ... gݍ݂ 5x7 hbg̉ptHgg܂
+//                         (Sp͎ĂȂ̂ŁAlpgőɕ`܂)
+//
+//=============================================================================
+#ifndef TEXT_H
+#define TEXT_H
+
+#define TEXT_CELL_W         16      // 1̑傫 (hbg)
+#define TEXT_CELL_H         16
+#define TEXT_MAX_GLYPHS     256     // AgXɓ镶̐
+#define TEXT_ATLAS_VERSION  1
+
+struct Framebuffer;
+
+// 1̌`
+struct Glyph
+{
+    unsigned short code;                // R[h (p 0x00XXASp Shift_JIS 2oCg)
+    unsigned char  advance;             // ̕܂ł̕ (hbg)
+    unsigned char  reserved;
+    unsigned short rows[TEXT_CELL_H];   // 1s16hbg1rbg (ŏʃrbg[)
+};
+
+// Ăẗꗗ (code ̏ɕׂ܂)
+struct GlyphAtlas
+{
+    int            glyphCount;
+    int            missingAdvance;      // AgXɂȂSp̕
+    short          ascii[128];          // p  glyphs ̔ԍ (-1 ȂȂ)
+    Glyph          glyphs[TEXT_MAX_GLYPHS];
+};
+
+//-----------------------------------------------------------------------------
+//  ֐̖OXg (vg^Cv錾)
+//-----------------------------------------------------------------------------
+void Text_Init(GlyphAtlas& atlas);
+void Text_InitBuiltin(GlyphAtlas& atlas);
+bool Text_AddGlyph(GlyphAtlas& atlas, const Glyph& glyph);
+const Glyph* Text_FindGlyph(const GlyphAtlas& atlas, unsigned short code);
+bool Text_HasAll(const GlyphAtlas& atlas, const char* text);
+bool Text_SaveAtlas(const GlyphAtlas& atlas, const char* path);
+bool Text_LoadAtlas(GlyphAtlas& atlas, const char* path);
+#ifdef _WIN32
+bool Text_BakeGDI(GlyphAtlas& atlas, const char* charset);
+#endif
+int  Text_Measure(const GlyphAtlas& atlas, const char* text);
+void Text_Draw(const Framebuffer& fb, const GlyphAtlas& atlas, int x, int y, const char* text, unsigned int color);
+
+//-----------------------------------------------------------------------------
+//  Shift_JIS 1oCgڂǂ (2oCg̎n܂)
+//-----------------------------------------------------------------------------
+inline bool Text_IsLeadByte(unsigned char c)
+{
+    return (c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC);
+}
+
+#endif // TEXT_H
@@ -0,0 +1,58 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Œ^CXebv (ԊuŃQ[i߂dg)
+//
+//=============================================================================
+#include "sim.h"
+#include "timestep.h"
+
+//=============================================================================
+//  Timestep_Init֐ - Ԃ̒ɂāAvn߂܂
+//=============================================================================
+void Timestep_Init(FixedTimestep& ts, unsigned long now)
+{
+    ts.lastTime = now;
+    ts.accumulator = 0;
+    ts.droppedTicks = 0;
+}
+
+//=============================================================================
+//  Timestep_Advance֐ - oߎԂ𒙋Ai߂ׂt[Ԃ܂
+//=============================================================================
+int Timestep_Advance(FixedTimestep& ts, unsigned long now)
+{
+    // ͕Ȃ̈ZȂ̂ŁAtimeGetTime ĂvZł܂
+    ts.accumulator += now - ts.lastTime;
+    ts.lastTime = now;
+
+    int ticks = (int)(ts.accumulator / SIM_TICK_MS);
+    ts.accumulator -= (unsigned long)ticks * SIM_TICK_MS;
+
+    // xꂷ͒ǂɎ̂Ă܂
+    if (ticks > MAX_CATCHUP_TICKS){
+        ts.droppedTicks += ticks - MAX_CATCHUP_TICKS;
+        ticks = MAX_CATCHUP_TICKS;
+    }
+    return ticks;
+}
+
+//=============================================================================
+//  Timestep_Alpha֐ - Õt[ƍ̃t[̊Ԃ̂ǂɂ邩 (0.0`1.0)
+//=============================================================================
+float Timestep_Alpha(const FixedTimestep& ts)
+{
+    return (float)ts.accumulator / (float)SIM_TICK_MS;
+}
+
+//=============================================================================
+//  Timestep_TimeToNextTick֐ - ̃t[܂łƉ~b邩
+//   (̎ԂĂ΁ACPU𖳑ʂɉ񂳂ɍς݂܂)
+//=============================================================================
+unsigned long Timestep_TimeToNextTick(const FixedTimestep& ts, unsigned long now)
+{
+    unsigned long pending = ts.accumulator + (now - ts.lastTime);
+    if (pending >= SIM_TICK_MS){
+        return 0;
+    }
+    return SIM_TICK_MS - pending;
+}
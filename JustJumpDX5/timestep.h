@@ -0,0 +1,34 @@
+//=============================================================================
+//
+//  wWXgWv DX5x Œ^CXebv (ԊuŃQ[i߂dg)
+//
+//  o߂Ԃu (accumulator)vɂ߂ĂASIM_TICK_MS ܂邲Ƃ
+//  Q[1t[i߂܂BPCdăt[xĂǍĂяo
+//  ܂Ƃ߂Ēǂ̂ŁAWv̋OXN[x͏ɓɂȂ܂B
+//
+//  g:
+//    Timestep_Init(ts, ̎);
+//    int n = Timestep_Advance(ts, ̎);   // n  Sim_Step Ă
+//    float alpha = Timestep_Alpha(ts);         // `̕ԂɎg (0.0`1.0)
+//
+//=============================================================================
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+// 1̌ĂяoŒǂőt[Bȏxꂽ͎̂Ă܂
+// (dƂɁAǂƂĂɒx鈫zh܂)
+#define MAX_CATCHUP_TICKS   5
+
+struct FixedTimestep
+{
+    unsigned long lastTime;      // O Timestep_Advance Ă񂾎 (~b)
+    unsigned long accumulator;   // ܂Q[ɔfĂȂ (~b)
+    unsigned long droppedTicks;  // ǂɎ̂Ăt[ (vp)
+};
+
+void          Timestep_Init(FixedTimestep& ts, unsigned long now);
+int           Timestep_Advance(FixedTimestep& ts, unsigned long now);
+float         Timestep_Alpha(const FixedTimestep& ts);
+unsigned long Timestep_TimeToNextTick(const FixedTimestep& ts, unsigned long now);
+
+#endif // TIMESTEP_H